@@ -0,0 +1,52 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+/**
+ * @file Arduino.h
+ * @brief Host replacement of the Arduino core for the benchmarks in host/
+ * @details Only what the libraries under lib/ use. millis() and the pin
+ *          levels are plain variables set by the benchmark, every call is
+ *          counted so the cost on the Nano can be estimated.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Configuration constants
+#define HIGH                        1U
+#define LOW                         0U
+#define INPUT                       0U
+#define OUTPUT                      1U
+#define LED_BUILTIN                 13U
+#define HOST_PIN_COUNT              20U    /**< D0-D13 and A0-A5 */
+
+// Type definitions
+/**
+ * @brief Calls into the simulated core since the last HostArduino_Reset()
+ */
+typedef struct
+{
+    uint32_t digital_reads;      /**< digitalRead() calls */
+    uint32_t digital_writes;     /**< digitalWrite() calls */
+} HostArduinoStats_t;
+
+// Simulated core state, set by the benchmark
+extern uint32_t host_millis;
+extern uint32_t host_micros;
+extern uint8_t host_pin_level[HOST_PIN_COUNT];
+extern HostArduinoStats_t host_arduino_stats;
+
+// Public API functions
+
+/**
+ * @brief Clear the time, the pin levels and the call counters
+ */
+void HostArduino_Reset(void);
+
+uint32_t millis(void);
+uint32_t micros(void);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+#endif /* ARDUINO_H */
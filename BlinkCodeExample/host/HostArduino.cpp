@@ -0,0 +1,77 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <string.h>
+
+// Simulated core state
+uint32_t host_millis = 0U;
+uint32_t host_micros = 0U;
+uint8_t host_pin_level[HOST_PIN_COUNT];
+HostArduinoStats_t host_arduino_stats;
+HostSpiStats_t host_spi_stats;
+SPIClass SPI;
+
+// Public API Implementation
+
+void HostArduino_Reset(void)
+{
+    host_millis = 0U;
+    host_micros = 0U;
+    memset(host_pin_level, 0, sizeof(host_pin_level));
+    memset(&host_arduino_stats, 0, sizeof(host_arduino_stats));
+}
+
+uint32_t millis(void)
+{
+    return host_millis;
+}
+
+uint32_t micros(void)
+{
+    return host_micros;
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    if (pin < HOST_PIN_COUNT)
+    {
+        host_pin_level[pin] = value ? HIGH : LOW;
+    }
+    host_arduino_stats.digital_writes++;
+}
+
+int digitalRead(uint8_t pin)
+{
+    host_arduino_stats.digital_reads++;
+    return (pin < HOST_PIN_COUNT) ? host_pin_level[pin] : LOW;
+}
+
+void HostSpi_Reset(void)
+{
+    memset(&host_spi_stats, 0, sizeof(host_spi_stats));
+}
+
+void SPIClass::begin(void)
+{
+}
+
+void SPIClass::beginTransaction(SPISettings settings)
+{
+    (void)settings;
+    host_spi_stats.transactions++;
+}
+
+uint8_t SPIClass::transfer(uint8_t data)
+{
+    host_spi_stats.bytes++;
+    return data;
+}
+
+void SPIClass::endTransaction(void)
+{
+}
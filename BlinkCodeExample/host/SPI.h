@@ -0,0 +1,57 @@
+#ifndef SPI_H
+#define SPI_H
+
+/**
+ * @file SPI.h
+ * @brief Host replacement of the Arduino SPI library for the benchmarks in host/
+ * @details Transfers go nowhere, transactions and bytes are counted.
+ */
+
+#include <stdint.h>
+
+// Configuration constants
+#define MSBFIRST                    1U
+#define LSBFIRST                    0U
+#define SPI_MODE0                   0x00U
+
+// Type definitions
+/**
+ * @brief Transfers since the last HostSpi_Reset()
+ */
+typedef struct
+{
+    uint32_t transactions;       /**< beginTransaction() calls */
+    uint32_t bytes;              /**< transfer() calls */
+} HostSpiStats_t;
+
+class SPISettings
+{
+public:
+    SPISettings(uint32_t clock_hz, uint8_t bit_order, uint8_t data_mode)
+    {
+        (void)clock_hz;
+        (void)bit_order;
+        (void)data_mode;
+    }
+};
+
+class SPIClass
+{
+public:
+    void begin(void);
+    void beginTransaction(SPISettings settings);
+    uint8_t transfer(uint8_t data);
+    void endTransaction(void);
+};
+
+extern SPIClass SPI;
+extern HostSpiStats_t host_spi_stats;
+
+// Public API functions
+
+/**
+ * @brief Clear the transfer counters
+ */
+void HostSpi_Reset(void);
+
+#endif /* SPI_H */
@@ -0,0 +1,380 @@
+/**
+ * @file debounce_bench.cpp
+ * @brief Host benchmark of PortDebounce against the per-button debouncer
+ * @details Feeds eight simulated bouncing buttons on port D to both
+ *          debouncers for 10 simulated minutes:
+ *
+ *          1. PortDebounce, sampling PIND every BUTTON_DEBOUNCE_DELAY_MS /
+ *             PORTDEBOUNCE_SAMPLES ms as the example did
+ *          2. DebounceButton(), the per-button debouncer the example used
+ *             before, copied unchanged, sampling each pin with digitalRead()
+ *             every 5 ms
+ *
+ *          Every press bounces for up to 10 ms on both edges. The benchmark
+ *          reports detected and spurious presses, the latency from the first
+ *          contact to the reported press, digitalRead() calls and the host
+ *          time per sample, net of the clock read overhead.
+ *
+ *          Build and run from the BlinkCodeExample directory:
+ *          g++ -O2 -Wall -Ihost -Ilib/PortDebounce host/debounce_bench.cpp \
+ *              host/HostArduino.cpp lib/PortDebounce/PortDebounce.cpp -o debounce-bench
+ *          ./debounce-bench
+ */
+
+#include <Arduino.h>
+#include <algorithm>
+#include <stdio.h>
+#include <time.h>
+#include <vector>
+
+#include "PortDebounce.h"
+
+// Configuration constants
+#define BENCH_BUTTON_COUNT          8U     /**< Buttons on D0-D7 */
+#define BENCH_DURATION_US           600000000UL /**< Simulated run time */
+#define BENCH_STEP_US               100U   /**< Simulation resolution */
+#define BENCH_MAX_BOUNCES           6U     /**< Contact bounces per edge */
+#define BENCH_BOUNCE_US             10000U /**< Longest bounce burst */
+#define BUTTON_DEBOUNCE_DELAY_MS    50U    /**< Debounce delay of the example */
+#define TASK_PERIOD_MS              5U     /**< Sampling period of DebounceButton() */
+#define PORT_SAMPLE_PERIOD_MS       (BUTTON_DEBOUNCE_DELAY_MS / PORTDEBOUNCE_SAMPLES)
+
+// Type definitions
+// Button states structure, as in the example before PortDebounce
+typedef struct
+{
+    uint8_t current_state;      /**< Current button reading */
+    uint8_t previous_state;     /**< Previous stable button reading */
+    uint8_t debounce_counter;   /**< Debounce counter */
+    uint8_t is_stable;          /**< Flag indicating stable reading */
+} ButtonState_t;
+
+/**
+ * @brief Simulated push button with contact bounce
+ */
+typedef struct
+{
+    uint32_t next_edge_us;       /**< Time of the next intended press or release */
+    uint32_t bounce_end_us;      /**< Bouncing until this time */
+    uint32_t next_bounce_us;     /**< Time of the next bounce toggle */
+    uint32_t press_us;           /**< First contact of the current press */
+    uint8_t pressed;             /**< Intended level */
+    uint8_t reported;            /**< Press already reported by the debouncer */
+} BenchButton_t;
+
+/**
+ * @brief Result of one debouncer
+ */
+typedef struct
+{
+    uint32_t presses;            /**< Intended presses */
+    uint32_t detected;           /**< Presses reported once */
+    uint32_t spurious;           /**< Reports while released or repeated within one press */
+    uint32_t samples;            /**< Debouncer calls */
+    uint32_t reads;              /**< digitalRead() calls */
+    double sample_ns;            /**< Host time per call for all buttons */
+    std::vector<uint32_t> latency_us; /**< First contact to reported press */
+} BenchResult_t;
+
+// Private variables
+static uint32_t random_state = 1U;
+static BenchButton_t buttons[BENCH_BUTTON_COUNT];
+static uint32_t timer_overhead_ns;
+
+// Private function prototypes
+static uint8_t DebounceButton(ButtonState_t* button, uint8_t pin);
+static void RunPortDebounce(BenchResult_t* result);
+static void RunDebounceButton(BenchResult_t* result);
+static void StartButtons(void);
+static void StepButtons(uint32_t now_us, BenchResult_t* result);
+static void Report(uint8_t index, uint32_t now_us, BenchResult_t* result);
+static uint8_t ReadPort(void);
+static void PrintResult(const char* name, unsigned ram, BenchResult_t* result);
+static uint64_t NowNs(void);
+static uint32_t MeasureTimerOverhead(void);
+static uint32_t Random(void);
+
+int main(void)
+{
+    BenchResult_t port_result;
+    BenchResult_t button_result;
+
+    timer_overhead_ns = MeasureTimerOverhead();
+    printf("%u buttons, bounce up to %u ms, %lu s\n\n", BENCH_BUTTON_COUNT, BENCH_BOUNCE_US / 1000U,
+           BENCH_DURATION_US / 1000000UL);
+    printf("%-16s %6s %8s %8s %8s %13s %12s %10s %6s\n", "debouncer", "period", "presses",
+           "detected", "spurious", "latency ms", "reads/sample", "ns/sample", "RAM");
+
+    RunPortDebounce(&port_result);
+    PrintResult("PortDebounce", (unsigned)sizeof(PortDebounce_t), &port_result);
+    RunDebounceButton(&button_result);
+    PrintResult("DebounceButton", (unsigned)(BENCH_BUTTON_COUNT * sizeof(ButtonState_t)), &button_result);
+
+    return 0;
+}
+
+// Private function implementations
+
+/**
+ * @brief Debounce button input with proper state management
+ * @param button Pointer to button state structure
+ * @param pin Pin number to read
+ * @return uint8_t 1 if button just became pressed (rising edge), 0 otherwise
+ */
+static uint8_t DebounceButton(ButtonState_t* button, uint8_t pin)
+{
+    button->current_state = digitalRead(pin);
+
+    // If button state changed, reset debounce counter
+    if (button->current_state != button->previous_state)
+    {
+        button->debounce_counter = 0U;
+        button->is_stable = 0U;
+    }
+    else
+    {
+        // State is stable, increment counter
+        button->debounce_counter++;
+
+        // If debounce threshold reached, mark as stable
+        if (button->debounce_counter >= BUTTON_DEBOUNCE_DELAY_MS / TASK_PERIOD_MS)
+        {
+            button->is_stable = 1U;
+        }
+    }
+
+    // Return 1 if button just became pressed (stable HIGH from stable LOW)
+    uint8_t result = 0U;
+    if ((button->is_stable) &&
+        (button->current_state == HIGH) &&
+        (button->previous_state == LOW))
+    {
+        result = 1U;
+    }
+
+    button->previous_state = button->current_state;
+    return result;
+}
+
+static void RunPortDebounce(BenchResult_t* result)
+{
+    PortDebounce_t debounce;
+    uint64_t busy_ns = 0U;
+
+    *result = BenchResult_t();
+    HostArduino_Reset();
+    StartButtons();
+    PortDebounce_Init(&debounce, ReadPort());
+
+    for (uint32_t now_us = 0U; now_us < BENCH_DURATION_US; now_us += BENCH_STEP_US)
+    {
+        StepButtons(now_us, result);
+        if ((now_us % (PORT_SAMPLE_PERIOD_MS * 1000U)) != 0U)
+        {
+            continue;
+        }
+
+        uint8_t pressed = 0U;
+        uint64_t start_ns = NowNs();
+        PortDebounce_Update(&debounce, ReadPort(), &pressed, NULL);
+        busy_ns += std::max<uint64_t>(NowNs() - start_ns, timer_overhead_ns) - timer_overhead_ns;
+        result->samples++;
+
+        for (uint8_t i = 0U; i < BENCH_BUTTON_COUNT; i++)
+        {
+            if (pressed & (1U << i))
+            {
+                Report(i, now_us, result);
+            }
+        }
+    }
+    result->sample_ns = (double)busy_ns / result->samples;
+}
+
+static void RunDebounceButton(BenchResult_t* result)
+{
+    ButtonState_t states[BENCH_BUTTON_COUNT];
+    uint64_t busy_ns = 0U;
+
+    *result = BenchResult_t();
+    HostArduino_Reset();
+    StartButtons();
+    for (uint8_t i = 0U; i < BENCH_BUTTON_COUNT; i++)
+    {
+        // InitializeButton() of the old example
+        states[i].current_state = (uint8_t)digitalRead(i);
+        states[i].previous_state = states[i].current_state;
+        states[i].debounce_counter = 0U;
+        states[i].is_stable = 1U;
+    }
+    host_arduino_stats.digital_reads = 0U;
+
+    for (uint32_t now_us = 0U; now_us < BENCH_DURATION_US; now_us += BENCH_STEP_US)
+    {
+        StepButtons(now_us, result);
+        if ((now_us % (TASK_PERIOD_MS * 1000U)) != 0U)
+        {
+            continue;
+        }
+
+        uint8_t pressed = 0U;
+        uint64_t start_ns = NowNs();
+        for (uint8_t i = 0U; i < BENCH_BUTTON_COUNT; i++)
+        {
+            pressed |= (uint8_t)(DebounceButton(&states[i], i) << i);
+        }
+        busy_ns += std::max<uint64_t>(NowNs() - start_ns, timer_overhead_ns) - timer_overhead_ns;
+        result->samples++;
+
+        for (uint8_t i = 0U; i < BENCH_BUTTON_COUNT; i++)
+        {
+            if (pressed & (1U << i))
+            {
+                Report(i, now_us, result);
+            }
+        }
+    }
+    result->sample_ns = (double)busy_ns / result->samples;
+    result->reads = host_arduino_stats.digital_reads;
+}
+
+/**
+ * @brief Released buttons with their first press spread over one second
+ */
+static void StartButtons(void)
+{
+    random_state = 1U;
+    for (uint8_t i = 0U; i < BENCH_BUTTON_COUNT; i++)
+    {
+        buttons[i] = BenchButton_t();
+        buttons[i].next_edge_us = 100000U + Random() % 1000000U;
+    }
+}
+
+/**
+ * @brief Advance the buttons to now_us and drive their pins
+ * @details A press is held 80-500 ms, the next one follows after 200-1000 ms.
+ *          Each edge toggles the contact up to BENCH_MAX_BOUNCES times
+ *          within BENCH_BOUNCE_US before it settles on the intended level.
+ */
+static void StepButtons(uint32_t now_us, BenchResult_t* result)
+{
+    for (uint8_t i = 0U; i < BENCH_BUTTON_COUNT; i++)
+    {
+        BenchButton_t* button = &buttons[i];
+
+        if (now_us >= button->next_edge_us)
+        {
+            button->pressed ^= 1U;
+            host_pin_level[i] = button->pressed;
+            button->bounce_end_us = now_us + (Random() % (BENCH_BOUNCE_US + 1U));
+            button->next_bounce_us = now_us + BENCH_STEP_US + (Random() % (BENCH_BOUNCE_US / BENCH_MAX_BOUNCES));
+            if (button->pressed)
+            {
+                button->press_us = now_us;
+                button->reported = 0U;
+                result->presses++;
+                button->next_edge_us = now_us + 80000U + (Random() % 420000U);
+            }
+            else
+            {
+                button->next_edge_us = now_us + 200000U + (Random() % 800000U);
+            }
+        }
+        else if (now_us < button->bounce_end_us)
+        {
+            if (now_us >= button->next_bounce_us)
+            {
+                host_pin_level[i] ^= 1U;
+                button->next_bounce_us = now_us + BENCH_STEP_US + (Random() % (BENCH_BOUNCE_US / BENCH_MAX_BOUNCES));
+            }
+        }
+        else
+        {
+            host_pin_level[i] = button->pressed;
+        }
+    }
+}
+
+static void Report(uint8_t index, uint32_t now_us, BenchResult_t* result)
+{
+    BenchButton_t* button = &buttons[index];
+
+    if (button->pressed && !button->reported)
+    {
+        button->reported = 1U;
+        result->detected++;
+        result->latency_us.push_back(now_us - button->press_us);
+    }
+    else
+    {
+        result->spurious++;
+    }
+}
+
+/**
+ * @brief PIND of the simulated port, one register read
+ */
+static uint8_t ReadPort(void)
+{
+    uint8_t port = 0U;
+
+    for (uint8_t i = 0U; i < BENCH_BUTTON_COUNT; i++)
+    {
+        port |= (uint8_t)(host_pin_level[i] << i);
+    }
+    return port;
+}
+
+static void PrintResult(const char* name, unsigned ram, BenchResult_t* result)
+{
+    char latency[24] = "-";
+    char period[8];
+
+    if (!result->latency_us.empty())
+    {
+        std::sort(result->latency_us.begin(), result->latency_us.end());
+        snprintf(latency, sizeof(latency), "%.1f/%.1f",
+                 result->latency_us[result->latency_us.size() / 2U] / 1000.0,
+                 result->latency_us.back() / 1000.0);
+    }
+    snprintf(period, sizeof(period), "%u ms",
+             (result->reads != 0U) ? TASK_PERIOD_MS : PORT_SAMPLE_PERIOD_MS);
+
+    printf("%-16s %6s %8u %8u %8u %13s %12.1f %10.1f %5u B\n", name, period, result->presses,
+           result->detected, result->spurious, latency, (double)result->reads / result->samples,
+           result->sample_ns, ram);
+}
+
+static uint64_t NowNs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Median cost of reading the clock twice, taken off every timed call
+ */
+static uint32_t MeasureTimerOverhead(void)
+{
+    std::vector<uint32_t> samples;
+
+    for (uint32_t i = 0U; i < 10001U; i++)
+    {
+        uint64_t start_ns = NowNs();
+        samples.push_back((uint32_t)(NowNs() - start_ns));
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2U];
+}
+
+static uint32_t Random(void)
+{
+    // xorshift32, reproducible
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
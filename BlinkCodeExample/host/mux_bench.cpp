@@ -0,0 +1,236 @@
+/**
+ * @file mux_bench.cpp
+ * @brief Host benchmark of BlinkCodeMux_Task() and the shift-register write
+ * @details Builds the unchanged BlinkCodeMux.cpp against the stub core in
+ *          host/ (millis() is a variable, SPI transfers are counted) and runs
+ *          BlinkCodeMux_Task() once per simulated millisecond for 60 s with
+ *          one or all channels blinking. For each run it reports the channels
+ *          changed per call, the host time of the calls that changed something
+ *          and the SPI and pin traffic. That traffic is converted to time on
+ *          the Nano with the BENCH_NANO_* costs, because the heap work scales
+ *          with the channels that change but every change shifts the whole
+ *          chain out again. Host times are net of the clock read overhead.
+ *
+ *          The channel count is a build option, build and run once per size
+ *          from the BlinkCodeExample directory:
+ *          for n in 8 32 128; do
+ *              g++ -O2 -Wall -Ihost -Ilib/BlinkCode -Ilib/BlinkCodeMux \
+ *                  -DBLINKCODEMUX_CHANNEL_COUNT=${n}U host/mux_bench.cpp \
+ *                  host/HostArduino.cpp -o mux-bench-$n && ./mux-bench-$n
+ *          done
+ */
+
+#include <algorithm>
+#include <stdio.h>
+#include <time.h>
+#include <vector>
+
+// Built into this file so WriteRegisterImage() can be timed on its own
+#include "../lib/BlinkCodeMux/BlinkCodeMux.cpp"
+
+// Configuration constants
+#define BENCH_DURATION_MS           60000UL /**< Simulated run time, one Task call per ms */
+#define BENCH_WRITE_REPEAT          100000UL /**< WriteRegisterImage() calls timed on their own */
+#define BENCH_NANO_BYTE_US          2.75   /**< SPI.transfer() at 4 MHz: 32 shift + 12 loop cycles at 16 MHz */
+#define BENCH_NANO_TRANSACTION_US   6.0    /**< SPISettings from a runtime clock plus begin/endTransaction() */
+#define BENCH_NANO_PIN_WRITE_US     3.5    /**< One digitalWrite() */
+
+// Type definitions
+/**
+ * @brief Result of one 60 s run
+ */
+typedef struct
+{
+    uint32_t change_calls;       /**< Task calls that changed at least one channel */
+    uint32_t changes;            /**< Channel state changes in total */
+    uint32_t max_changes;        /**< Most channel changes in one call */
+    double call_ns;              /**< Mean host time of all Task calls */
+    double change_ns_median;     /**< Median host time of the calls with changes */
+    double change_ns_p99;        /**< 99th percentile of the same */
+    HostSpiStats_t spi;          /**< Chain writes */
+    uint32_t pin_writes;         /**< Latch pulses */
+} BenchResult_t;
+
+// Private variables
+static uint32_t random_state = 1U;
+static uint32_t timer_overhead_ns;
+static uint8_t last_state[BLINKCODEMUX_CHANNEL_COUNT];
+
+// Private function prototypes
+static void RunBlinking(uint8_t active, BenchResult_t* result);
+static void Refill(uint8_t active);
+static void PrintResult(const char* name, const BenchResult_t* result);
+static double NanoWriteUs(const HostSpiStats_t* spi, uint32_t pin_writes);
+static uint64_t NowNs(void);
+static uint32_t MeasureTimerOverhead(void);
+static uint32_t Random(void);
+
+int main(void)
+{
+    BenchResult_t result;
+
+    timer_overhead_ns = MeasureTimerOverhead();
+    printf("%u channels, %u registers, Task() every 1 ms for %lu s\n\n",
+           (unsigned)BLINKCODEMUX_CHANNEL_COUNT, (unsigned)BLINKCODEMUX_REGISTER_COUNT,
+           BENCH_DURATION_MS / 1000UL);
+    printf("%-8s %9s %9s %8s %8s %10s %11s %10s %10s\n", "blinking", "changes/s", "k mean",
+           "k max", "call ns", "change ns", "ns p99", "write us", "nano load");
+
+    RunBlinking(0U, &result);
+    PrintResult("none", &result);
+    RunBlinking(1U, &result);
+    PrintResult("one", &result);
+    RunBlinking(BLINKCODEMUX_CHANNEL_COUNT, &result);
+    PrintResult("all", &result);
+
+    // The chain write alone, as done after every call with changes
+    HostSpi_Reset();
+    host_arduino_stats.digital_writes = 0U;
+    uint64_t start_ns = NowNs();
+    for (uint32_t i = 0U; i < BENCH_WRITE_REPEAT; i++)
+    {
+        WriteRegisterImage();
+    }
+    double write_ns = (double)(NowNs() - start_ns) / BENCH_WRITE_REPEAT;
+    printf("\nWriteRegisterImage(): %u bytes, host %.0f ns, Nano %.1f us\n",
+           (unsigned)BLINKCODEMUX_REGISTER_COUNT, write_ns,
+           NanoWriteUs(&host_spi_stats, host_arduino_stats.digital_writes) / BENCH_WRITE_REPEAT);
+
+    return 0;
+}
+
+// Private function implementations
+
+/**
+ * @brief Keep the first active channels blinking for BENCH_DURATION_MS
+ */
+static void RunBlinking(uint8_t active, BenchResult_t* result)
+{
+    std::vector<uint32_t> change_ns;
+    uint64_t total_ns = 0U;
+
+    HostArduino_Reset();
+    BlinkCodeMux_Init(NULL);
+    random_state = 1U;
+    Refill(active);
+    for (uint16_t c = 0U; c < BLINKCODEMUX_CHANNEL_COUNT; c++)
+    {
+        last_state[c] = (uint8_t)BlinkCodeMux_GetState((uint8_t)c);
+    }
+
+    *result = BenchResult_t();
+    HostSpi_Reset();
+    host_arduino_stats.digital_writes = 0U;
+
+    for (uint32_t t = 1U; t <= BENCH_DURATION_MS; t++)
+    {
+        host_millis = t;
+
+        uint64_t start_ns = NowNs();
+        BlinkCodeMux_Task();
+        uint32_t elapsed_ns = (uint32_t)(NowNs() - start_ns);
+        elapsed_ns = (elapsed_ns > timer_overhead_ns) ? (elapsed_ns - timer_overhead_ns) : 0U;
+        total_ns += elapsed_ns;
+
+        // Count the channels this call changed, outside the timed part
+        uint32_t changes = 0U;
+        for (uint16_t c = 0U; c < BLINKCODEMUX_CHANNEL_COUNT; c++)
+        {
+            uint8_t state = (uint8_t)BlinkCodeMux_GetState((uint8_t)c);
+            changes += (state != last_state[c]) ? 1U : 0U;
+            last_state[c] = state;
+        }
+        if (changes > 0U)
+        {
+            result->change_calls++;
+            result->changes += changes;
+            result->max_changes = std::max(result->max_changes, changes);
+            change_ns.push_back(elapsed_ns);
+        }
+
+        // Queue the next code while the current one runs, so channels never go idle
+        Refill(active);
+    }
+
+    result->call_ns = (double)total_ns / BENCH_DURATION_MS;
+    if (!change_ns.empty())
+    {
+        std::sort(change_ns.begin(), change_ns.end());
+        result->change_ns_median = change_ns[change_ns.size() / 2U];
+        result->change_ns_p99 = change_ns[(change_ns.size() * 99U) / 100U];
+    }
+    result->spi = host_spi_stats;
+    result->pin_writes = host_arduino_stats.digital_writes;
+}
+
+/**
+ * @brief Queue a random code on every active channel with an empty queue
+ */
+static void Refill(uint8_t active)
+{
+    for (uint16_t c = 0U; c < active; c++)
+    {
+        if (BlinkCodeMux_GetPendingCount((uint8_t)c) == 0U)
+        {
+            uint16_t data = (uint16_t)(1U + Random() % 5U);
+            uint32_t delay_ms = 10U + Random() % 491U;
+            BlinkCodeMux_SendData((uint8_t)c, data, delay_ms);
+        }
+    }
+}
+
+static void PrintResult(const char* name, const BenchResult_t* result)
+{
+    double seconds = BENCH_DURATION_MS / 1000.0;
+    double write_us = NanoWriteUs(&result->spi, result->pin_writes);
+
+    printf("%-8s %9.1f %9.2f %8u %8.0f %10.0f %11.0f %10.1f %9.2f%%\n", name,
+           result->change_calls / seconds,
+           (result->change_calls != 0U) ? (double)result->changes / result->change_calls : 0.0,
+           (unsigned)result->max_changes, result->call_ns, result->change_ns_median,
+           result->change_ns_p99,
+           (result->spi.transactions != 0U) ? write_us / result->spi.transactions : 0.0,
+           write_us / (seconds * 1e4));
+}
+
+/**
+ * @brief Time the counted chain writes take on a 16 MHz Nano
+ */
+static double NanoWriteUs(const HostSpiStats_t* spi, uint32_t pin_writes)
+{
+    return (spi->transactions * BENCH_NANO_TRANSACTION_US) + (spi->bytes * BENCH_NANO_BYTE_US) +
+           (pin_writes * BENCH_NANO_PIN_WRITE_US);
+}
+
+static uint64_t NowNs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Median cost of reading the clock twice, taken off every timed call
+ */
+static uint32_t MeasureTimerOverhead(void)
+{
+    std::vector<uint32_t> samples;
+
+    for (uint32_t i = 0U; i < 10001U; i++)
+    {
+        uint64_t start_ns = NowNs();
+        samples.push_back((uint32_t)(NowNs() - start_ns));
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2U];
+}
+
+static uint32_t Random(void)
+{
+    // xorshift32, reproducible
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
@@ -0,0 +1,121 @@
+#include "AdcSampler.h"
+#include <Arduino.h>
+#include <avr/interrupt.h>
+
+#if (ADCSAMPLER_BUFFER_SIZE & (ADCSAMPLER_BUFFER_SIZE - 1U)) != 0U
+#error "ADCSAMPLER_BUFFER_SIZE must be a power of two"
+#endif
+
+// Private constants
+#define ADC_DECIMATION_SHIFT        2U     /**< Sum of 16 10-bit samples shifted to 12 bits */
+#define ADC_CHANNEL_MASK            0x07U  /**< MUX bits used for single-ended inputs */
+
+// Ring buffer of decimated results, written by ISR and read by main context
+static volatile uint16_t result_buffer[ADCSAMPLER_BUFFER_SIZE];
+static volatile uint8_t result_head = 0U;
+static volatile uint8_t result_tail = 0U;
+static volatile uint16_t latest_result = 0U;
+static volatile uint16_t overrun_count = 0U;
+
+// Oversampling accumulator, ISR only
+static uint16_t sample_sum = 0U;
+static uint8_t sample_count = 0U;
+
+// Public API Implementation
+
+void AdcSampler_Init(uint8_t channel)
+{
+    uint8_t sreg = SREG;
+    cli();
+
+    sample_sum = 0U;
+    sample_count = 0U;
+    result_head = 0U;
+    result_tail = 0U;
+    overrun_count = 0U;
+
+    // AVcc reference, right adjusted, selected input
+    ADMUX = _BV(REFS0) | (channel & ADC_CHANNEL_MASK);
+    DIDR0 |= (uint8_t)(_BV(channel & ADC_CHANNEL_MASK) & 0x3FU);
+
+    // Free-running trigger, enable with interrupt, prescaler 128 (125 kHz at 16 MHz)
+    ADCSRB = 0U;
+    ADCSRA = _BV(ADEN) | _BV(ADATE) | _BV(ADIE) | _BV(ADIF) |
+             _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);
+    ADCSRA |= _BV(ADSC);
+
+    SREG = sreg;
+}
+
+void AdcSampler_Stop(void)
+{
+    ADCSRA &= (uint8_t)~(_BV(ADATE) | _BV(ADIE));
+}
+
+uint16_t AdcSampler_GetLatest(void)
+{
+    // 16-bit read must not be torn by the ISR
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t value = latest_result;
+    SREG = sreg;
+
+    return value;
+}
+
+uint8_t AdcSampler_Read(uint16_t* value)
+{
+    if (result_tail == result_head)
+    {
+        return 0U;
+    }
+
+    *value = result_buffer[result_tail];
+    result_tail = (result_tail + 1U) & (ADCSAMPLER_BUFFER_SIZE - 1U);
+
+    return 1U;
+}
+
+uint16_t AdcSampler_GetOverrunCount(void)
+{
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t count = overrun_count;
+    SREG = sreg;
+
+    return count;
+}
+
+// Interrupt service routine
+
+ISR(ADC_vect)
+{
+    sample_sum += ADC;
+    sample_count++;
+
+    if (sample_count < ADCSAMPLER_OVERSAMPLE_COUNT)
+    {
+        return;
+    }
+
+    // Decimate 16 samples to one 12-bit result
+    uint16_t result = (uint16_t)(sample_sum >> ADC_DECIMATION_SHIFT);
+    sample_sum = 0U;
+    sample_count = 0U;
+
+    latest_result = result;
+
+    uint8_t next_head = (result_head + 1U) & (ADCSAMPLER_BUFFER_SIZE - 1U);
+    if (next_head == result_tail)
+    {
+        // Buffer full, keep the older results
+        if (overrun_count < UINT16_MAX)
+        {
+            overrun_count++;
+        }
+        return;
+    }
+
+    result_buffer[result_head] = result;
+    result_head = next_head;
+}
@@ -0,0 +1,47 @@
+#ifndef ADCSAMPLER_H
+#define ADCSAMPLER_H
+
+#include <stdint.h>
+
+// Configuration constants
+#define ADCSAMPLER_OVERSAMPLE_COUNT  16U   /**< 10-bit samples summed per result (4^2 for 2 extra bits) */
+#define ADCSAMPLER_BUFFER_SIZE       16U   /**< Decimated results kept for the application (power of two) */
+#define ADCSAMPLER_MAX_VALUE         4095U /**< Full scale of a decimated 12-bit result */
+
+// Public API functions
+
+/**
+ * @brief Start free-running background conversions on one analog input
+ * @details The ADC runs continuously from its conversion-complete interrupt
+ *          (125 kHz ADC clock, about 9.6 k samples/s, 600 results/s).
+ *          analogRead() must not be used while the sampler is running.
+ * @param channel Analog input number (0 for A0 ... 7 for A7)
+ */
+void AdcSampler_Init(uint8_t channel);
+
+/**
+ * @brief Stop background conversions
+ */
+void AdcSampler_Stop(void);
+
+/**
+ * @brief Get the most recent 12-bit result
+ * @details Non-blocking snapshot, does not consume buffered results
+ * @return uint16_t Latest result (0-4095)
+ */
+uint16_t AdcSampler_GetLatest(void);
+
+/**
+ * @brief Take the oldest buffered 12-bit result
+ * @param value Out: oldest result
+ * @return uint8_t 1 if a result was available, 0 if the buffer is empty
+ */
+uint8_t AdcSampler_Read(uint16_t* value);
+
+/**
+ * @brief Get number of results lost because the buffer was full
+ * @return uint16_t Lost result count (saturating)
+ */
+uint16_t AdcSampler_GetOverrunCount(void);
+
+#endif /* ADCSAMPLER_H */
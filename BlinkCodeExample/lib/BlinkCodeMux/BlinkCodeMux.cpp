@@ -0,0 +1,415 @@
+#include "BlinkCodeMux.h"
+#include <Arduino.h>
+#include <SPI.h>
+
+// Private constants
+#define MUX_BLINK_TIME_MS           200U   /**< Duration LED stays on during blink, same as BlinkCode */
+#define MUX_MIN_DELAY_MS            10U    /**< Minimum delay value */
+#define MUX_MAX_DELAY_MS            10000U /**< Maximum delay value */
+#define MUX_MAX_BLINK_COUNT         1000U  /**< Maximum blink count */
+#define MUX_NOT_SCHEDULED           0xFFU  /**< Heap position of a channel without deadline */
+
+// Per-channel blink command, kept small as there is one queue per channel
+typedef struct
+{
+    uint16_t blink_count;           /**< Number of blinks to execute */
+    uint16_t blink_delay_ms;        /**< Delay between blinks */
+} MuxCommand_t;
+
+// Per-channel state machine and command queue
+typedef struct
+{
+    MuxCommand_t queue[BLINKCODEMUX_QUEUE_SIZE]; /**< Pending commands */
+    uint8_t queue_tail;                          /**< Index of oldest pending command */
+    uint8_t queue_count;                         /**< Number of pending commands */
+    uint8_t state;                               /**< Current LedState_t of the channel */
+    uint8_t heap_position;                       /**< Position in deadline heap or MUX_NOT_SCHEDULED */
+    uint16_t remaining_count;                    /**< Blinks left in the current command */
+    uint16_t blink_delay_ms;                     /**< Off time of the current command */
+} MuxChannel_t;
+
+// Deadline heap entry
+typedef struct
+{
+    uint32_t deadline_ms;           /**< millis() value at which the channel changes state */
+    uint8_t channel;                /**< Channel owning this deadline */
+} MuxDeadline_t;
+
+// Global multiplexer variables
+static MuxChannel_t mux_channels[BLINKCODEMUX_CHANNEL_COUNT];
+static MuxDeadline_t deadline_heap[BLINKCODEMUX_CHANNEL_COUNT];
+static uint8_t deadline_heap_size = 0U;
+static uint8_t register_image[BLINKCODEMUX_REGISTER_COUNT];
+static uint8_t image_dirty = 0U;
+static MuxConfig_t mux_configuration = {0};
+
+// Private function prototypes
+static void InitializeChannel(MuxChannel_t* channel);
+static void StartNextCommand(uint8_t channel, uint32_t start_ms);
+static uint8_t AdvanceChannel(uint8_t channel, uint32_t* deadline_ms);
+static void SetChannelOutput(uint8_t channel, uint8_t on);
+static void WriteRegisterImage(void);
+static uint8_t IsDeadlineBefore(uint32_t a_ms, uint32_t b_ms);
+static void HeapSwap(uint8_t a, uint8_t b);
+static void HeapSiftUp(uint8_t position);
+static void HeapSiftDown(uint8_t position);
+static void HeapPush(uint8_t channel, uint32_t deadline_ms);
+static void HeapRemove(uint8_t position);
+
+// Public API Implementation
+
+BlinkCodeResult_t BlinkCodeMux_Init(const MuxConfig_t* config)
+{
+    // Initialize with default configuration if none provided
+    if (config == NULL)
+    {
+        mux_configuration.latch_pin = BLINKCODEMUX_DEFAULT_LATCH_PIN;
+        mux_configuration.active_high = 1U;
+        mux_configuration.spi_clock_hz = BLINKCODEMUX_DEFAULT_SPI_CLOCK;
+    }
+    else
+    {
+        mux_configuration = *config;
+    }
+
+    if (mux_configuration.spi_clock_hz == 0U)
+    {
+        return BLINKCODE_RESULT_ERROR;
+    }
+
+    // Initialize internal structures
+    for (uint8_t i = 0U; i < BLINKCODEMUX_CHANNEL_COUNT; i++)
+    {
+        InitializeChannel(&mux_channels[i]);
+    }
+    for (uint8_t i = 0U; i < BLINKCODEMUX_REGISTER_COUNT; i++)
+    {
+        register_image[i] = 0U;
+    }
+    deadline_heap_size = 0U;
+
+    // Initialize hardware and clear the whole chain
+    pinMode(mux_configuration.latch_pin, OUTPUT);
+    digitalWrite(mux_configuration.latch_pin, LOW);
+    SPI.begin();
+    WriteRegisterImage();
+
+    return BLINKCODE_RESULT_SUCCESS;
+}
+
+void BlinkCodeMux_Task(void)
+{
+    uint32_t now_ms = millis();
+
+    // Only channels whose deadline passed are touched, cheapest first
+    while ((deadline_heap_size > 0U) && !IsDeadlineBefore(now_ms, deadline_heap[0].deadline_ms))
+    {
+        uint8_t channel = deadline_heap[0].channel;
+        uint32_t deadline_ms = deadline_heap[0].deadline_ms;
+
+        if (AdvanceChannel(channel, &deadline_ms))
+        {
+            // Channel stays active, reschedule in place
+            deadline_heap[0].deadline_ms = deadline_ms;
+            HeapSiftDown(0U);
+        }
+        else
+        {
+            HeapRemove(0U);
+        }
+    }
+
+    // All changes of this tick go out in one burst
+    if (image_dirty)
+    {
+        WriteRegisterImage();
+    }
+}
+
+BlinkCodeResult_t BlinkCodeMux_SendData(uint8_t channel, uint16_t data, uint32_t delay_ms)
+{
+    if (channel >= BLINKCODEMUX_CHANNEL_COUNT)
+    {
+        return BLINKCODE_RESULT_ERROR;
+    }
+
+    if (delay_ms == 0U)
+    {
+        delay_ms = BLINKCODE_DEFAULT_DELAY;
+    }
+
+    // Validate input parameters
+    if ((data == 0U) || (data > MUX_MAX_BLINK_COUNT) ||
+        (delay_ms < MUX_MIN_DELAY_MS) || (delay_ms > MUX_MAX_DELAY_MS))
+    {
+        return BLINKCODE_RESULT_ERROR;
+    }
+
+    MuxChannel_t* state = &mux_channels[channel];
+    if (state->queue_count >= BLINKCODEMUX_QUEUE_SIZE)
+    {
+        return BLINKCODE_RESULT_FULL;
+    }
+
+    // Store command at head of the channel queue
+    uint8_t head_index = (state->queue_tail + state->queue_count) % BLINKCODEMUX_QUEUE_SIZE;
+    state->queue[head_index].blink_count = data;
+    state->queue[head_index].blink_delay_ms = (uint16_t)delay_ms;
+    state->queue_count++;
+
+    // If the channel is idle, start transmission right away
+    if (state->state == LED_STATE_IDLE)
+    {
+        StartNextCommand(channel, millis());
+    }
+
+    return BLINKCODE_RESULT_SUCCESS;
+}
+
+LedState_t BlinkCodeMux_GetState(uint8_t channel)
+{
+    if (channel >= BLINKCODEMUX_CHANNEL_COUNT)
+    {
+        return LED_STATE_IDLE;
+    }
+
+    return (LedState_t)mux_channels[channel].state;
+}
+
+uint8_t BlinkCodeMux_GetPendingCount(uint8_t channel)
+{
+    if (channel >= BLINKCODEMUX_CHANNEL_COUNT)
+    {
+        return 0U;
+    }
+
+    return mux_channels[channel].queue_count;
+}
+
+BlinkCodeResult_t BlinkCodeMux_ClearQueue(uint8_t channel)
+{
+    if (channel >= BLINKCODEMUX_CHANNEL_COUNT)
+    {
+        return BLINKCODE_RESULT_ERROR;
+    }
+
+    if (mux_channels[channel].heap_position != MUX_NOT_SCHEDULED)
+    {
+        HeapRemove(mux_channels[channel].heap_position);
+    }
+    InitializeChannel(&mux_channels[channel]);
+    SetChannelOutput(channel, 0U);
+
+    return BLINKCODE_RESULT_SUCCESS;
+}
+
+uint8_t BlinkCodeMux_GetActiveCount(void)
+{
+    return deadline_heap_size;
+}
+
+// Private function implementations
+
+static void InitializeChannel(MuxChannel_t* channel)
+{
+    channel->queue_tail = 0U;
+    channel->queue_count = 0U;
+    channel->state = LED_STATE_IDLE;
+    channel->heap_position = MUX_NOT_SCHEDULED;
+    channel->remaining_count = 0U;
+    channel->blink_delay_ms = 0U;
+}
+
+static void StartNextCommand(uint8_t channel, uint32_t start_ms)
+{
+    MuxChannel_t* state = &mux_channels[channel];
+    MuxCommand_t* command = &state->queue[state->queue_tail];
+
+    state->remaining_count = command->blink_count;
+    state->blink_delay_ms = command->blink_delay_ms;
+    state->queue_tail = (state->queue_tail + 1U) % BLINKCODEMUX_QUEUE_SIZE;
+    state->queue_count--;
+
+    state->state = LED_STATE_ON;
+    SetChannelOutput(channel, 1U);
+    HeapPush(channel, start_ms + MUX_BLINK_TIME_MS);
+}
+
+/**
+ * @brief Run one state transition of a channel whose deadline expired
+ * @param channel Channel index
+ * @param deadline_ms In: expired deadline, out: next deadline
+ * @return uint8_t 1 if the channel needs a new deadline, 0 if it became idle
+ */
+static uint8_t AdvanceChannel(uint8_t channel, uint32_t* deadline_ms)
+{
+    MuxChannel_t* state = &mux_channels[channel];
+
+    // Deadlines advance from the previous deadline, not from now, so they never drift
+    switch (state->state)
+    {
+        case LED_STATE_ON:
+            SetChannelOutput(channel, 0U);
+            state->remaining_count--;
+            if (state->remaining_count == 0U)
+            {
+                // Gap before the next command, same as BlinkCode
+                state->state = LED_STATE_WAIT;
+                *deadline_ms += MUX_BLINK_TIME_MS;
+            }
+            else
+            {
+                state->state = LED_STATE_OFF;
+                *deadline_ms += state->blink_delay_ms;
+            }
+            return 1U;
+
+        case LED_STATE_OFF:
+            SetChannelOutput(channel, 1U);
+            state->state = LED_STATE_ON;
+            *deadline_ms += MUX_BLINK_TIME_MS;
+            return 1U;
+
+        case LED_STATE_WAIT:
+            if (state->queue_count > 0U)
+            {
+                MuxCommand_t* command = &state->queue[state->queue_tail];
+                state->remaining_count = command->blink_count;
+                state->blink_delay_ms = command->blink_delay_ms;
+                state->queue_tail = (state->queue_tail + 1U) % BLINKCODEMUX_QUEUE_SIZE;
+                state->queue_count--;
+
+                SetChannelOutput(channel, 1U);
+                state->state = LED_STATE_ON;
+                *deadline_ms += MUX_BLINK_TIME_MS;
+                return 1U;
+            }
+            state->state = LED_STATE_IDLE;
+            return 0U;
+
+        case LED_STATE_IDLE:
+        default:
+            // Invalid state, reset to idle
+            state->state = LED_STATE_IDLE;
+            return 0U;
+    }
+}
+
+static void SetChannelOutput(uint8_t channel, uint8_t on)
+{
+    uint8_t mask = (uint8_t)(1U << (channel % 8U));
+
+    if (on)
+    {
+        register_image[channel / 8U] |= mask;
+    }
+    else
+    {
+        register_image[channel / 8U] &= (uint8_t)~mask;
+    }
+    image_dirty = 1U;
+}
+
+static void WriteRegisterImage(void)
+{
+    uint8_t invert = mux_configuration.active_high ? 0x00U : 0xFFU;
+
+    // Farthest register first, so byte 0 ends up in the register next to the MCU
+    SPI.beginTransaction(SPISettings(mux_configuration.spi_clock_hz, MSBFIRST, SPI_MODE0));
+    for (uint8_t i = BLINKCODEMUX_REGISTER_COUNT; i > 0U; i--)
+    {
+        SPI.transfer((uint8_t)(register_image[i - 1U] ^ invert));
+    }
+    SPI.endTransaction();
+
+    // Rising edge on RCLK moves the shifted image to the outputs at once
+    digitalWrite(mux_configuration.latch_pin, HIGH);
+    digitalWrite(mux_configuration.latch_pin, LOW);
+
+    image_dirty = 0U;
+}
+
+static uint8_t IsDeadlineBefore(uint32_t a_ms, uint32_t b_ms)
+{
+    // Wrap-safe as long as deadlines are less than 2^31 ms apart
+    return ((int32_t)(a_ms - b_ms) < 0) ? 1U : 0U;
+}
+
+static void HeapSwap(uint8_t a, uint8_t b)
+{
+    MuxDeadline_t entry = deadline_heap[a];
+    deadline_heap[a] = deadline_heap[b];
+    deadline_heap[b] = entry;
+
+    mux_channels[deadline_heap[a].channel].heap_position = a;
+    mux_channels[deadline_heap[b].channel].heap_position = b;
+}
+
+static void HeapSiftUp(uint8_t position)
+{
+    while (position > 0U)
+    {
+        uint8_t parent = (uint8_t)((position - 1U) / 2U);
+        if (!IsDeadlineBefore(deadline_heap[position].deadline_ms, deadline_heap[parent].deadline_ms))
+        {
+            break;
+        }
+        HeapSwap(position, parent);
+        position = parent;
+    }
+}
+
+static void HeapSiftDown(uint8_t position)
+{
+    for (;;)
+    {
+        uint16_t left = (uint16_t)(2U * position + 1U);
+        uint16_t right = (uint16_t)(left + 1U);
+        uint8_t earliest = position;
+
+        if ((left < deadline_heap_size) &&
+            IsDeadlineBefore(deadline_heap[left].deadline_ms, deadline_heap[earliest].deadline_ms))
+        {
+            earliest = (uint8_t)left;
+        }
+        if ((right < deadline_heap_size) &&
+            IsDeadlineBefore(deadline_heap[right].deadline_ms, deadline_heap[earliest].deadline_ms))
+        {
+            earliest = (uint8_t)right;
+        }
+        if (earliest == position)
+        {
+            break;
+        }
+        HeapSwap(position, earliest);
+        position = earliest;
+    }
+}
+
+static void HeapPush(uint8_t channel, uint32_t deadline_ms)
+{
+    // Each channel holds at most one deadline, so the heap cannot overflow
+    uint8_t position = deadline_heap_size;
+    deadline_heap_size++;
+
+    deadline_heap[position].deadline_ms = deadline_ms;
+    deadline_heap[position].channel = channel;
+    mux_channels[channel].heap_position = position;
+    HeapSiftUp(position);
+}
+
+static void HeapRemove(uint8_t position)
+{
+    uint8_t last = (uint8_t)(deadline_heap_size - 1U);
+
+    mux_channels[deadline_heap[position].channel].heap_position = MUX_NOT_SCHEDULED;
+    deadline_heap_size = last;
+
+    if (position != last)
+    {
+        deadline_heap[position] = deadline_heap[last];
+        mux_channels[deadline_heap[position].channel].heap_position = position;
+        HeapSiftDown(position);
+        HeapSiftUp(position);
+    }
+}
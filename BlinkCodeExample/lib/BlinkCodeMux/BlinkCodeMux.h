@@ -0,0 +1,86 @@
+#ifndef BLINKCODEMUX_H
+#define BLINKCODEMUX_H
+
+#include <stdint.h>
+#include "BlinkCode.h"
+
+// Configuration constants
+#ifndef BLINKCODEMUX_CHANNEL_COUNT
+#define BLINKCODEMUX_CHANNEL_COUNT      32U    /**< Number of LED channels (8 per chained 74HC595) */
+#endif
+#define BLINKCODEMUX_QUEUE_SIZE         2U     /**< Pending blink commands per channel */
+#define BLINKCODEMUX_DEFAULT_LATCH_PIN  10U    /**< Default 74HC595 RCLK pin (SS on Nano) */
+#define BLINKCODEMUX_DEFAULT_SPI_CLOCK  4000000UL /**< Default SPI clock in Hz */
+
+#define BLINKCODEMUX_REGISTER_COUNT     ((BLINKCODEMUX_CHANNEL_COUNT + 7U) / 8U) /**< Chained shift registers */
+
+#if (BLINKCODEMUX_CHANNEL_COUNT == 0U) || (BLINKCODEMUX_CHANNEL_COUNT > 255U)
+#error "BLINKCODEMUX_CHANNEL_COUNT must be between 1 and 255"
+#endif
+
+// Type definitions
+/**
+ * @brief Shift-register chain configuration structure
+ * @details Channel N is output N % 8 of the (N / 8)-th 74HC595 counted from the MCU
+ */
+typedef struct
+{
+    uint8_t latch_pin;           /**< GPIO pin connected to the 74HC595 RCLK inputs */
+    uint8_t active_high;         /**< Output level for LED on (1 = HIGH, 0 = LOW) */
+    uint32_t spi_clock_hz;       /**< SPI clock used for the shift-register burst */
+} MuxConfig_t;
+
+// Public API functions
+
+/**
+ * @brief Initialize the multi-channel BlinkCode scheduler
+ * @param config Pointer to shift-register configuration (NULL for defaults)
+ * @return BlinkCodeResult_t Operation result
+ */
+BlinkCodeResult_t BlinkCodeMux_Init(const MuxConfig_t* config);
+
+/**
+ * @brief Process all channels whose next deadline has passed
+ * @details Work per call is proportional to the number of channels that change,
+ *          and all changes are written to the chain in a single SPI burst.
+ *          Timing is based on millis(), so the call rate only limits resolution.
+ */
+void BlinkCodeMux_Task(void);
+
+/**
+ * @brief Queue data on one channel using the BlinkCode blink pattern
+ * @param channel Channel index (0 to BLINKCODEMUX_CHANNEL_COUNT - 1)
+ * @param data Data value to encode as blink count
+ * @param delay_ms Delay between blinks in milliseconds (0 = use default)
+ * @return BlinkCodeResult_t Operation result
+ */
+BlinkCodeResult_t BlinkCodeMux_SendData(uint8_t channel, uint16_t data, uint32_t delay_ms);
+
+/**
+ * @brief Get current state of one channel
+ * @param channel Channel index
+ * @return LedState_t Current channel state (LED_STATE_IDLE for invalid channels)
+ */
+LedState_t BlinkCodeMux_GetState(uint8_t channel);
+
+/**
+ * @brief Get number of pending operations of one channel
+ * @param channel Channel index
+ * @return uint8_t Number of queued commands, excluding the one being transmitted
+ */
+uint8_t BlinkCodeMux_GetPendingCount(uint8_t channel);
+
+/**
+ * @brief Stop one channel and clear its pending operations
+ * @param channel Channel index
+ * @return BlinkCodeResult_t Operation result
+ */
+BlinkCodeResult_t BlinkCodeMux_ClearQueue(uint8_t channel);
+
+/**
+ * @brief Get number of channels currently transmitting
+ * @return uint8_t Number of channels with a scheduled deadline
+ */
+uint8_t BlinkCodeMux_GetActiveCount(void);
+
+#endif /* BLINKCODEMUX_H */
@@ -0,0 +1,153 @@
+#include "EdgeCapture.h"
+#include <Arduino.h>
+#include <avr/interrupt.h>
+
+#if (EDGECAPTURE_QUEUE_SIZE & (EDGECAPTURE_QUEUE_SIZE - 1U)) != 0U
+#error "EDGECAPTURE_QUEUE_SIZE must be a power of two"
+#endif
+
+// Timestamped port snapshot taken on every pin change
+typedef struct
+{
+    uint16_t timestamp_ms;          /**< Low 16 bits of millis() at the edge */
+    uint8_t levels;                 /**< PIND at the edge */
+} EdgeEvent_t;
+
+// Single-producer (ISR) single-consumer (main) queue, 8-bit indices are atomic on AVR
+static volatile EdgeEvent_t edge_queue[EDGECAPTURE_QUEUE_SIZE];
+static volatile uint8_t edge_queue_head = 0U;
+static volatile uint8_t edge_queue_overflow = 0U;
+static volatile uint8_t dropped_count = 0U;
+static volatile uint8_t edge_queue_tail = 0U;
+
+// Main context debounce state
+static uint8_t capture_mask = 0U;
+static uint8_t raw_levels = 0U;
+static uint8_t stable_levels = 0U;
+static uint8_t pending_mask = 0U;
+static uint16_t last_edge_ms[8];
+
+// Private function prototypes
+static void ApplyLevels(uint8_t levels, uint16_t timestamp_ms);
+
+// Public API Implementation
+
+void EdgeCapture_Init(uint8_t mask)
+{
+    uint8_t sreg = SREG;
+    cli();
+
+    capture_mask = mask;
+    raw_levels = PIND & mask;
+    stable_levels = raw_levels;
+    pending_mask = 0U;
+    edge_queue_tail = edge_queue_head;
+    edge_queue_overflow = 0U;
+    dropped_count = 0U;
+
+    // Clear stale flag, then enable the port D pin-change interrupt
+    PCMSK2 |= mask;
+    PCIFR = _BV(PCIF2);
+    PCICR |= _BV(PCIE2);
+
+    SREG = sreg;
+}
+
+uint8_t EdgeCapture_Process(uint8_t* pressed, uint8_t* released)
+{
+    // Drain queued edges
+    while (edge_queue_tail != edge_queue_head)
+    {
+        ApplyLevels(edge_queue[edge_queue_tail].levels, edge_queue[edge_queue_tail].timestamp_ms);
+        edge_queue_tail = (edge_queue_tail + 1U) & (EDGECAPTURE_QUEUE_SIZE - 1U);
+    }
+
+    // Queue overflowed, resynchronize with the current pin levels
+    if (edge_queue_overflow)
+    {
+        edge_queue_overflow = 0U;
+        ApplyLevels(PIND, (uint16_t)millis());
+    }
+
+    // Accept inputs that stayed quiet for the debounce window
+    uint8_t toggle = 0U;
+    if (pending_mask != 0U)
+    {
+        uint16_t now_ms = (uint16_t)millis();
+
+        for (uint8_t bit = 0U; bit < 8U; bit++)
+        {
+            uint8_t bit_mask = (uint8_t)(1U << bit);
+
+            if ((pending_mask & bit_mask) &&
+                ((uint16_t)(now_ms - last_edge_ms[bit]) >= EDGECAPTURE_DEBOUNCE_MS))
+            {
+                pending_mask &= (uint8_t)~bit_mask;
+                toggle |= (uint8_t)((raw_levels ^ stable_levels) & bit_mask);
+            }
+        }
+        stable_levels ^= toggle;
+    }
+
+    if (pressed != NULL)
+    {
+        *pressed = (uint8_t)(toggle & stable_levels);
+    }
+    if (released != NULL)
+    {
+        *released = (uint8_t)(toggle & (uint8_t)~stable_levels);
+    }
+
+    return stable_levels;
+}
+
+uint8_t EdgeCapture_IsPending(void)
+{
+    return ((pending_mask != 0U) || (edge_queue_tail != edge_queue_head)) ? 1U : 0U;
+}
+
+uint8_t EdgeCapture_GetDroppedCount(void)
+{
+    return dropped_count;
+}
+
+// Private function implementations
+
+static void ApplyLevels(uint8_t levels, uint16_t timestamp_ms)
+{
+    uint8_t changed = (uint8_t)((levels ^ raw_levels) & capture_mask);
+
+    for (uint8_t bit = 0U; bit < 8U; bit++)
+    {
+        if (changed & (uint8_t)(1U << bit))
+        {
+            last_edge_ms[bit] = timestamp_ms;
+        }
+    }
+
+    raw_levels ^= changed;
+    pending_mask |= changed;
+}
+
+// Interrupt service routine
+
+ISR(PCINT2_vect)
+{
+    uint8_t levels = PIND;
+    uint8_t next_head = (edge_queue_head + 1U) & (EDGECAPTURE_QUEUE_SIZE - 1U);
+
+    if (next_head == edge_queue_tail)
+    {
+        // Queue full, main context rereads the port instead
+        edge_queue_overflow = 1U;
+        if (dropped_count < UINT8_MAX)
+        {
+            dropped_count++;
+        }
+        return;
+    }
+
+    edge_queue[edge_queue_head].timestamp_ms = (uint16_t)millis();
+    edge_queue[edge_queue_head].levels = levels;
+    edge_queue_head = next_head;
+}
@@ -0,0 +1,42 @@
+#ifndef EDGECAPTURE_H
+#define EDGECAPTURE_H
+
+#include <stdint.h>
+
+// Configuration constants
+#define EDGECAPTURE_QUEUE_SIZE      16U    /**< Edge events buffered between ISR and main context (power of two) */
+#define EDGECAPTURE_DEBOUNCE_MS     50U    /**< Time an input must stay unchanged before its level is accepted */
+
+// Public API functions
+
+/**
+ * @brief Enable pin-change interrupt capture on port D inputs
+ * @details Uses PCINT2 (pins 0-7 on Nano/Uno). Pins must already be inputs.
+ * @param mask Port D bits to capture (e.g. _BV(PD2) | _BV(PD3))
+ */
+void EdgeCapture_Init(uint8_t mask);
+
+/**
+ * @brief Drain captured edges and debounce them by timestamp
+ * @details An input is accepted once no edge has been seen on it for
+ *          EDGECAPTURE_DEBOUNCE_MS. Cheap when nothing happened, so it can be
+ *          called from loop() without a polling period.
+ * @param pressed Out: inputs whose debounced level became HIGH (may be NULL)
+ * @param released Out: inputs whose debounced level became LOW (may be NULL)
+ * @return uint8_t Debounced input levels
+ */
+uint8_t EdgeCapture_Process(uint8_t* pressed, uint8_t* released);
+
+/**
+ * @brief Check if edges are waiting for their debounce window to elapse
+ * @return uint8_t 1 if EdgeCapture_Process still has work to do, 0 otherwise
+ */
+uint8_t EdgeCapture_IsPending(void);
+
+/**
+ * @brief Get number of edge events lost because the queue was full
+ * @return uint8_t Lost event count (saturating)
+ */
+uint8_t EdgeCapture_GetDroppedCount(void);
+
+#endif /* EDGECAPTURE_H */
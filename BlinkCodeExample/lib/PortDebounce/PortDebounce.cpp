@@ -0,0 +1,36 @@
+#include "PortDebounce.h"
+#include <stddef.h>
+
+// Public API Implementation
+
+void PortDebounce_Init(PortDebounce_t* debounce, uint8_t sample)
+{
+    debounce->state = sample;
+
+    // All counters at rest
+    debounce->count0 = 0xFFU;
+    debounce->count1 = 0xFFU;
+}
+
+uint8_t PortDebounce_Update(PortDebounce_t* debounce, uint8_t sample, uint8_t* pressed, uint8_t* released)
+{
+    // Inputs whose sample differs from the debounced level count, all others reset
+    uint8_t delta = (uint8_t)(sample ^ debounce->state);
+    debounce->count0 = (uint8_t)~(debounce->count0 & delta);
+    debounce->count1 = (uint8_t)(debounce->count0 ^ (debounce->count1 & delta));
+
+    // Counters that rolled over accept the new level
+    uint8_t toggle = (uint8_t)(delta & debounce->count0 & debounce->count1);
+    debounce->state ^= toggle;
+
+    if (pressed != NULL)
+    {
+        *pressed = (uint8_t)(toggle & debounce->state);
+    }
+    if (released != NULL)
+    {
+        *released = (uint8_t)(toggle & (uint8_t)~debounce->state);
+    }
+
+    return debounce->state;
+}
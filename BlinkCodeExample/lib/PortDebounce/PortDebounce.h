@@ -0,0 +1,44 @@
+#ifndef PORTDEBOUNCE_H
+#define PORTDEBOUNCE_H
+
+#include <stdint.h>
+
+// Configuration constants
+#define PORTDEBOUNCE_SAMPLES        4U     /**< Consecutive equal samples needed to accept a new level */
+
+// Type definitions
+/**
+ * @brief Vertical-counter debouncer for 8 inputs of one port
+ * @details Bit N of every member belongs to input N. The two count bytes form
+ *          eight independent 2-bit counters, so all inputs are debounced with
+ *          the same handful of bitwise operations and 3 bytes of RAM.
+ */
+typedef struct
+{
+    uint8_t state;               /**< Debounced input levels */
+    uint8_t count0;              /**< Low bit of the per-input sample counters */
+    uint8_t count1;              /**< High bit of the per-input sample counters */
+} PortDebounce_t;
+
+// Public API functions
+
+/**
+ * @brief Initialize debouncer with the current port levels
+ * @param debounce Pointer to debouncer structure
+ * @param sample Initial port reading, taken as stable
+ */
+void PortDebounce_Init(PortDebounce_t* debounce, uint8_t sample);
+
+/**
+ * @brief Feed one port sample and get the debounced edges
+ * @details An input changes state after PORTDEBOUNCE_SAMPLES consecutive
+ *          samples that differ from its debounced level.
+ * @param debounce Pointer to debouncer structure
+ * @param sample Raw port reading (e.g. PIND)
+ * @param pressed Out: inputs that became HIGH with this sample (may be NULL)
+ * @param released Out: inputs that became LOW with this sample (may be NULL)
+ * @return uint8_t Debounced input levels
+ */
+uint8_t PortDebounce_Update(PortDebounce_t* debounce, uint8_t sample, uint8_t* pressed, uint8_t* released);
+
+#endif /* PORTDEBOUNCE_H */
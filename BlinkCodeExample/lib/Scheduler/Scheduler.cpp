@@ -0,0 +1,114 @@
+#include "Scheduler.h"
+#include <Arduino.h>
+
+// Global scheduler variables
+static SchedulerTask_t* task_table = NULL;
+static uint8_t task_table_size = 0U;
+static uint32_t busy_time_us = 0U;
+static uint32_t stats_start_us = 0U;
+
+// Private function prototypes
+static uint8_t IsReleaseDue(uint32_t now_ms, uint32_t release_ms);
+static void RunTask(SchedulerTask_t* task);
+
+// Public API Implementation
+
+void Scheduler_Init(SchedulerTask_t* tasks, uint8_t task_count)
+{
+    uint32_t now_ms = millis();
+
+    task_table = tasks;
+    task_table_size = (tasks != NULL) ? task_count : 0U;
+
+    for (uint8_t i = 0U; i < task_table_size; i++)
+    {
+        task_table[i].next_release_ms = now_ms + task_table[i].phase_ms;
+    }
+
+    Scheduler_ResetStats();
+}
+
+void Scheduler_Run(void)
+{
+    for (uint8_t i = 0U; i < task_table_size; i++)
+    {
+        SchedulerTask_t* task = &task_table[i];
+
+        if (IsReleaseDue(millis(), task->next_release_ms))
+        {
+            RunTask(task);
+        }
+    }
+}
+
+void Scheduler_GetLoad(SchedulerLoad_t* load)
+{
+    uint32_t elapsed_us = micros() - stats_start_us;
+
+    load->busy_us = busy_time_us;
+    load->elapsed_us = elapsed_us;
+
+    if ((elapsed_us == 0U) || (busy_time_us >= elapsed_us))
+    {
+        load->idle_percent = (elapsed_us == 0U) ? 100U : 0U;
+    }
+    else
+    {
+        load->idle_percent = (uint8_t)(100U - (uint8_t)(((uint64_t)busy_time_us * 100U) / elapsed_us));
+    }
+}
+
+void Scheduler_ResetStats(void)
+{
+    for (uint8_t i = 0U; i < task_table_size; i++)
+    {
+        task_table[i].last_exec_us = 0U;
+        task_table[i].max_exec_us = 0U;
+        task_table[i].overrun_count = 0U;
+        task_table[i].skipped_count = 0U;
+    }
+
+    busy_time_us = 0U;
+    stats_start_us = micros();
+}
+
+// Private function implementations
+
+static uint8_t IsReleaseDue(uint32_t now_ms, uint32_t release_ms)
+{
+    // Wrap-safe comparison of millis() values
+    return ((int32_t)(now_ms - release_ms) >= 0) ? 1U : 0U;
+}
+
+static void RunTask(SchedulerTask_t* task)
+{
+    uint32_t start_us = micros();
+    task->job();
+    uint32_t exec_us = micros() - start_us;
+
+    // Execution time accounting
+    task->last_exec_us = exec_us;
+    if (exec_us > task->max_exec_us)
+    {
+        task->max_exec_us = exec_us;
+    }
+    if ((exec_us > task->budget_us) && (task->overrun_count < UINT16_MAX))
+    {
+        task->overrun_count++;
+    }
+    busy_time_us += exec_us;
+
+    // Next release on the period grid, independent of execution time
+    task->next_release_ms += task->period_ms;
+
+    // Drop releases that are already a full period late instead of bursting
+    uint32_t now_ms = millis();
+    while ((task->period_ms > 0U) && IsReleaseDue(now_ms, task->next_release_ms + task->period_ms))
+    {
+        task->next_release_ms += task->period_ms;
+        if (task->skipped_count < UINT16_MAX)
+        {
+            task->skipped_count++;
+        }
+    }
+}
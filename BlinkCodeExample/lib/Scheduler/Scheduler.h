@@ -0,0 +1,67 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+// Type definitions
+/**
+ * @brief Task job function type
+ */
+typedef void (*SchedulerJob_t)(void);
+
+/**
+ * @brief Cooperative task table entry
+ * @details The first four members are configuration and are set in the static
+ *          task table, the remaining members are maintained by the scheduler.
+ */
+typedef struct
+{
+    SchedulerJob_t job;          /**< Function executed on every release */
+    uint32_t period_ms;          /**< Release period in milliseconds */
+    uint32_t phase_ms;           /**< Offset of the first release after Scheduler_Init */
+    uint32_t budget_us;          /**< Allowed execution time per release */
+    uint32_t next_release_ms;    /**< millis() value of the next release */
+    uint32_t last_exec_us;       /**< Execution time of the last release */
+    uint32_t max_exec_us;        /**< Longest execution time since last stats reset */
+    uint16_t overrun_count;      /**< Releases that exceeded budget_us */
+    uint16_t skipped_count;      /**< Releases dropped because the task fell a full period behind */
+} SchedulerTask_t;
+
+/**
+ * @brief CPU usage report
+ */
+typedef struct
+{
+    uint32_t busy_us;            /**< Time spent in task jobs since last stats reset */
+    uint32_t elapsed_us;         /**< Wall time since last stats reset */
+    uint8_t idle_percent;        /**< CPU left for other work, 0-100 */
+} SchedulerLoad_t;
+
+// Public API functions
+
+/**
+ * @brief Initialize the scheduler with a static task table
+ * @param tasks Pointer to task table (kept by reference)
+ * @param task_count Number of entries in the table
+ */
+void Scheduler_Init(SchedulerTask_t* tasks, uint8_t task_count);
+
+/**
+ * @brief Release every task whose deadline has passed
+ * @details Call from loop() without any delay. Releases follow the absolute
+ *          period grid, so execution time of one task does not shift others.
+ */
+void Scheduler_Run(void);
+
+/**
+ * @brief Get CPU usage since the last stats reset
+ * @param load Pointer to report structure to fill
+ */
+void Scheduler_GetLoad(SchedulerLoad_t* load);
+
+/**
+ * @brief Reset execution time, overrun and load statistics of all tasks
+ */
+void Scheduler_ResetStats(void);
+
+#endif /* SCHEDULER_H */
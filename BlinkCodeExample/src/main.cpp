@@ -1,133 +1,167 @@
 #include <Arduino.h>
 #include "BlinkCode.h"
+#include "EdgeCapture.h"
+#include "Scheduler.h"
 
 // Configuration constants
-#define BLINKCODE_INTERVAL_MS       125U   /**< Task execution interval in milliseconds */
-#define TASK_PERIOD_MS              5U     /**< Main loop delay in milliseconds */
-#define BUTTON_DEBOUNCE_DELAY_MS    50U    /**< Debounce delay for button inputs */
+#define SAMPLE_DATA_PERIOD_MS       10000U /**< Sample data transmission period in milliseconds */
+#define REPORT_PERIOD_MS            10000U /**< CPU load report period in milliseconds */
+#define REPORT_PRINT_PERIOD_MS      5U     /**< A report line drains from the TX buffer in about 5 ms at 115200 baud */
+#define REPORT_LINE_MAX             60U    /**< Longest report line, printed once this much TX buffer is free */
 #define INPUT_PIN_BUTTON_1          2U     /**< First button input pin */
 #define INPUT_PIN_BUTTON_2          3U     /**< Second button input pin */
+#define BUTTON_1_MASK               _BV(PD2) /**< Port bit of the first button (pin 2) */
+#define BUTTON_2_MASK               _BV(PD3) /**< Port bit of the second button (pin 3) */
 
-// Button states structure
-typedef struct
+/**
+ * @brief Initialize button input pins and pin-change capture
+ */
+static void InitializeButtons(void)
 {
-    uint8_t current_state;      /**< Current button reading */
-    uint8_t previous_state;     /**< Previous stable button reading */
-    uint8_t debounce_counter;   /**< Debounce counter */
-    uint8_t is_stable;          /**< Flag indicating stable reading */
-} ButtonState_t;
+    pinMode(INPUT_PIN_BUTTON_1, INPUT);
+    pinMode(INPUT_PIN_BUTTON_2, INPUT);
 
-// Global button state tracking
-static ButtonState_t button1_state = {0};
-static ButtonState_t button2_state = {0};
+    // Edges are timestamped by interrupt, no periodic sampling needed
+    EdgeCapture_Init(BUTTON_1_MASK | BUTTON_2_MASK);
+}
 
 /**
- * @brief Initialize button input pins and states
- * @param button Pointer to button state structure
- * @param pin Pin number to initialize
+ * @brief Debounce captured button edges and transmit data on press
  */
-static void InitializeButton(ButtonState_t* button, uint8_t pin)
+static void HandleButtons(void)
 {
-    pinMode(pin, INPUT);
-    button->current_state = digitalRead(pin);
-    button->previous_state = button->current_state;
-    button->debounce_counter = 0U;
-    button->is_stable = 1U; // Assume initial state is stable
+    uint8_t pressed = 0U;
+    EdgeCapture_Process(&pressed, NULL);
+    
+    // Process button press events - transmit data using BlinkCode
+    if (pressed & BUTTON_1_MASK)
+    {
+        // Send data value 1 (blink once)
+        BlinkCode_SendData(1U, BLINKCODE_DEFAULT_DELAY);
+    }
+    
+    if (pressed & BUTTON_2_MASK)
+    {
+        // Send data value 3 (blink three times)
+        BlinkCode_SendData(3U, BLINKCODE_DEFAULT_DELAY);
+    }
 }
 
 /**
- * @brief Debounce button input with proper state management
- * @param button Pointer to button state structure
- * @param pin Pin number to read
- * @return uint8_t 1 if button just became pressed (rising edge), 0 otherwise
+ * @brief Send a sample data value
+ * @details Demonstrates the main use case of BlinkCode for data transmission
  */
-static uint8_t DebounceButton(ButtonState_t* button, uint8_t pin)
+static void SampleDataJob(void)
 {
-    button->current_state = digitalRead(pin);
-    
-    // If button state changed, reset debounce counter
-    if (button->current_state != button->previous_state)
+    BlinkCode_SendData(42U, 300U); // Send data value 42 with custom timing
+}
+
+/**
+ * @brief Take a snapshot of CPU load and task overruns for ReportPrintJob
+ */
+static void ReportJob(void);
+
+/**
+ * @brief Print the next line of the report snapshot if the TX buffer has room
+ * @details Serial.print() blocks once the 64-byte TX buffer is full, a whole
+ *          report at once would take about 18 ms. One line at a time only
+ *          copies into the buffer.
+ */
+static void ReportPrintJob(void);
+
+// Static task table, phases spread the releases of slow tasks
+static SchedulerTask_t task_table[] =
+{
+    /* job            period                    phase                   budget_us */
+    { BlinkCode_Task, BLINKCODE_CHECK_INTERVAL, 0U,                     200U },
+    { SampleDataJob,  SAMPLE_DATA_PERIOD_MS,    SAMPLE_DATA_PERIOD_MS,  500U },
+    { ReportJob,      REPORT_PERIOD_MS,         REPORT_PERIOD_MS + 2U,  200U },
+    { ReportPrintJob, REPORT_PRINT_PERIOD_MS,   3U,                     500U }
+};
+
+#define TASK_COUNT  ((uint8_t)(sizeof(task_table) / sizeof(task_table[0])))
+
+/**
+ * @brief Statistics of one task at the time of the report
+ */
+typedef struct
+{
+    uint32_t max_exec_us;
+    uint16_t overrun_count;
+    uint16_t skipped_count;
+} ReportTask_t;
+
+static SchedulerLoad_t report_load;
+static ReportTask_t report_tasks[TASK_COUNT];
+static uint8_t report_line = TASK_COUNT + 1U; /**< Next line to print, past the last when done */
+
+static void ReportJob(void)
+{
+    Scheduler_GetLoad(&report_load);
+
+    for (uint8_t i = 0U; i < TASK_COUNT; i++)
     {
-        button->debounce_counter = 0U;
-        button->is_stable = 0U;
+        report_tasks[i].max_exec_us = task_table[i].max_exec_us;
+        report_tasks[i].overrun_count = task_table[i].overrun_count;
+        report_tasks[i].skipped_count = task_table[i].skipped_count;
     }
-    else
+    report_line = 0U;
+
+    Scheduler_ResetStats();
+}
+
+static void ReportPrintJob(void)
+{
+    if ((report_line > TASK_COUNT) || (Serial.availableForWrite() < (int)REPORT_LINE_MAX))
     {
-        // State is stable, increment counter
-        button->debounce_counter++;
-        
-        // If debounce threshold reached, mark as stable
-        if (button->debounce_counter >= BUTTON_DEBOUNCE_DELAY_MS / TASK_PERIOD_MS)
-        {
-            button->is_stable = 1U;
-        }
+        return;
     }
-    
-    // Return 1 if button just became pressed (stable HIGH from stable LOW)
-    uint8_t result = 0U;
-    if ((button->is_stable) && 
-        (button->current_state == HIGH) && 
-        (button->previous_state == LOW))
+
+    if (report_line == 0U)
     {
-        result = 1U;
+        Serial.print(F("CPU idle: "));
+        Serial.print(report_load.idle_percent);
+        Serial.print(F("% busy_us: "));
+        Serial.println(report_load.busy_us);
     }
-    
-    button->previous_state = button->current_state;
-    return result;
+    else
+    {
+        const ReportTask_t* task = &report_tasks[report_line - 1U];
+
+        Serial.print(F("  task "));
+        Serial.print(report_line - 1U);
+        Serial.print(F(" max_us: "));
+        Serial.print(task->max_exec_us);
+        Serial.print(F(" overruns: "));
+        Serial.print(task->overrun_count);
+        Serial.print(F(" skipped: "));
+        Serial.println(task->skipped_count);
+    }
+    report_line++;
 }
 
 void setup()
 {
+    Serial.begin(115200);
+
     // Initialize BlinkCode system with default configuration
     BlinkCode_Init(NULL);
     
     // Initialize button input handling
-    InitializeButton(&button1_state, INPUT_PIN_BUTTON_1);
-    InitializeButton(&button2_state, INPUT_PIN_BUTTON_2);
+    InitializeButtons();
+
+    // Start periodic tasks
+    Scheduler_Init(task_table, TASK_COUNT);
 }
 
 void loop()
 {
-    // Handle button inputs with debouncing
-    uint8_t button1_pressed = DebounceButton(&button1_state, INPUT_PIN_BUTTON_1);
-    uint8_t button2_pressed = DebounceButton(&button2_state, INPUT_PIN_BUTTON_2);
-    
-    // Process button press events - transmit data using BlinkCode
-    if (button1_pressed)
-    {
-        // Send data value 1 (blink once)
-        BlinkCode_SendData(1U, 0U);
-    }
-    
-    if (button2_pressed)
-    {
-        // Send data value 3 (blink three times)
-        BlinkCode_SendData(3U, 0U);
-    }
-    
-    // Example: Send sensor data or status information
-    // This demonstrates the main use case of BlinkCode for data transmission
-    static uint16_t counter = 0U;
-    counter++;
-    
-    // Every 10 seconds, send a sample data value
-    if (counter >= (10000U / TASK_PERIOD_MS))
-    {
-        BlinkCode_SendData(42U, 300U); // Send data value 42 with custom timing
-        counter = 0U;
-    }
-    
-    // Implement timed task execution for BlinkCode processing
-    static uint16_t tick_counter = 0U;
-    tick_counter++;
-    
-    // Execute BlinkCode task at configured interval
-    if (tick_counter >= (BLINKCODE_INTERVAL_MS / TASK_PERIOD_MS))
+    // Buttons only cost CPU while captured edges wait for their debounce window
+    if (EdgeCapture_IsPending())
     {
-        BlinkCode_Task();
-        tick_counter = 0U;
+        HandleButtons();
     }
-    
-    // Maintain consistent timing
-    delay(TASK_PERIOD_MS);
+
+    // Release due tasks, no busy delay so the free CPU shows up as idle time
+    Scheduler_Run();
 }
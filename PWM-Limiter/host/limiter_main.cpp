@@ -0,0 +1,40 @@
+/**
+  Host Build of the Limiter Application
+
+  @File Name
+    limiter_main.cpp
+
+  @Summary
+    src/main.c as it is, with main() renamed to PwmLimiter_Main()
+
+  @Description
+    The simulator keeps its own main(); PicModel_Run() calls the firmware
+    entry instead and leaves it when the run time is over. Between runs
+    PwmLimiter_Startup() does what the XC8 startup code does at power-up.
+*/
+
+#include <stddef.h>
+
+#define main PwmLimiter_Main
+#include "../src/main.c"
+
+/* Defined in src/ with an initial value or cleared at startup */
+extern volatile uint8_t timer0ReloadVal;
+extern volatile uint8_t timer0PrescalerVal;
+extern void (*ADC_InterruptHandler)(void);
+
+/**
+  @Summary
+    Sets the globals of src/ back to their power-up values
+
+  @Description
+    Without it a run would start with the values the previous run left.
+    A new global in src/ needs its line here.
+*/
+void PwmLimiter_Startup(void)
+{
+    Timer_Param_t = TIMER_VALUE;
+    timer0ReloadVal = 0;
+    timer0PrescalerVal = 7u;
+    ADC_InterruptHandler = NULL;
+}
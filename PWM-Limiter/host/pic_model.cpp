@@ -0,0 +1,457 @@
+/**
+  PIC10F322 Host Peripheral Model
+
+  @File Name
+    pic_model.cpp
+
+  @Summary
+    Cycle-stepped PIC10F322 peripherals behind the host xc.h
+
+  @Description
+    Time only moves when the firmware touches a register or waits, so the
+    model runs as fast as the host executes the firmware loop. Timer, ADC
+    and flash follow the PIC10F322 data sheet as far as the firmware uses
+    them:
+      - TMR0 counts Fosc/4 through the 1:2 to 1:256 prescaler, sets TMR0IF
+        when it wraps, and a write clears the prescaler and holds TMR0 for
+        two cycles
+      - the ADC converts in 10 TAD and clears GO_nDONE when done
+      - the flash needs the 0x55, 0xAA PMCON2 sequence before WR; a row
+        erase or write stalls the CPU for 2 ms while TMR0 keeps counting
+*/
+
+/**
+  Section: Included Files
+*/
+
+#include <string.h>
+#include <xc.h>
+#include "pic_model.h"
+
+/**
+  Section: Macro Declarations
+*/
+
+#define PIC_INTCON_TMR0IF   0x04U
+#define PIC_OPTION_PS       0x07U
+#define PIC_OPTION_PSA      0x08U
+#define PIC_OPTION_T0CS     0x20U
+#define PIC_OPTION_nWPUEN   0x80U
+#define PIC_ADCON_ADON      0x01U
+#define PIC_ADCON_GO        0x02U
+#define PIC_ADCON_CHS       0x1CU
+#define PIC_PMCON1_RD       0x01U
+#define PIC_PMCON1_WR       0x02U
+#define PIC_PMCON1_WREN     0x04U
+#define PIC_PMCON1_FREE     0x10U
+#define PIC_PMCON1_LWLO     0x20U
+#define PIC_PMCON1_CFGS     0x40U
+
+#define PIC_LIMIT_CHANNEL   2U     /* AN2, PWM_LIMIT */
+#define PIC_OUTPUT_PIN      0x02U  /* RA1, PWM_OUTPUT */
+#define PIC_TMR0_INHIBIT    2U     /* Cycles TMR0 holds after a write */
+#define PIC_STACK_PAINT     4096U  /* Bytes of host stack set to ram_fill */
+
+/**
+  Section: Data Types Definitions
+*/
+
+/* Thrown from the register access that crosses the end of the run */
+class PicModelStop
+{
+};
+
+/**
+  Section: Global Variables Definitions
+*/
+
+PicRegister<PIC_PORTA> PORTA;
+PicRegister<PIC_LATA> LATA;
+PicRegister<PIC_TRISA> TRISA;
+PicRegister<PIC_ANSELA> ANSELA;
+PicRegister<PIC_WPUA> WPUA;
+PicRegister<PIC_OPTION_REG> OPTION_REG;
+PicRegister<PIC_TMR0> TMR0;
+PicRegister<PIC_INTCON> INTCON;
+PicRegister<PIC_ADCON> ADCON;
+PicRegister<PIC_ADRES> ADRES;
+PicRegister<PIC_PMADRL> PMADRL;
+PicRegister<PIC_PMADRH> PMADRH;
+PicRegister<PIC_PMDATL> PMDATL;
+PicRegister<PIC_PMDATH> PMDATH;
+PicRegister<PIC_PMCON1> PMCON1;
+PicRegister<PIC_PMCON2> PMCON2;
+PicRegister<PIC_OSCCON> OSCCON;
+PicRegister<PIC_CLKRCON> CLKRCON;
+PicRegister<PIC_BORCON> BORCON;
+PicRegister<PIC_WDTCON> WDTCON;
+
+PORTAbits_t PORTAbits;
+LATAbits_t LATAbits;
+TRISAbits_t TRISAbits;
+ANSELAbits_t ANSELAbits;
+WPUAbits_t WPUAbits;
+OPTION_REGbits_t OPTION_REGbits;
+INTCONbits_t INTCONbits;
+ADCONbits_t ADCONbits;
+PMCON1bits_t PMCON1bits;
+
+static struct
+{
+    const PicModel_Config_t *config;
+    uint64_t cycle;                 /* Instruction cycles since power-up */
+    uint64_t end_cycle;
+    uint8_t access_cycles;
+    uint8_t sfr[PIC_SFR_COUNT];
+    uint16_t prescaler;             /* TMR0 prescaler counter */
+    uint8_t tmr0_hold;              /* Cycles left before TMR0 counts again */
+    uint16_t adc_cycles;            /* Cycles left in the running conversion */
+    uint8_t unlock;                 /* 1 after 0x55, 2 after 0x55 0xAA in PMCON2 */
+    uint8_t output;                 /* RA1 level last reported */
+    uint16_t latch[PICMODEL_FLASH_ROW_WORDS];
+    PicModel_Result_t result;
+} pic;
+
+/* Program memory survives the runs like the real part */
+static uint16_t flash[PICMODEL_FLASH_WORDS];
+static bool flashReady = false;
+
+/**
+  Section: Private Function Prototypes
+*/
+
+void PwmLimiter_Main(void);    /* main() of src/main.c, renamed by limiter_main.cpp */
+void PwmLimiter_Startup(void); /* Globals of src/ to their power-up values */
+
+static void Advance(uint32_t cycles);
+static uint8_t ReadPortA(void);
+static void UpdateOutput(void);
+static void StartFlashWrite(void);
+static void PaintStack(uint8_t fill);
+
+/**
+  Section: Model APIs
+*/
+
+void PicModel_Run(const PicModel_Config_t *config, PicModel_Result_t *result)
+{
+    if (!flashReady)
+    {
+        PicModel_EraseFlash();
+    }
+
+    memset(&pic, 0, sizeof(pic));
+    pic.config = config;
+    pic.end_cycle = config->duration_ns / PICMODEL_CYCLE_NS;
+    pic.access_cycles = (config->access_cycles != 0U) ? config->access_cycles : PICMODEL_ACCESS_CYCLES;
+    for (uint8_t i = 0; i < PICMODEL_FLASH_ROW_WORDS; i++)
+    {
+        pic.latch[i] = PICMODEL_FLASH_ERASED;
+    }
+
+    // Power-on reset values, TMR0 and LATA are unknown and start at 0
+    pic.sfr[PIC_TRISA] = 0x0F;
+    pic.sfr[PIC_ANSELA] = 0x07;
+    pic.sfr[PIC_WPUA] = 0x0F;
+    pic.sfr[PIC_OPTION_REG] = 0xFF;
+    pic.sfr[PIC_OSCCON] = 0x60;
+    pic.sfr[PIC_WDTCON] = 0x16;
+    pic.sfr[PIC_PMCON1] = 0x80;
+
+    PwmLimiter_Startup();
+    PaintStack(config->ram_fill);
+    try
+    {
+        PwmLimiter_Main();
+    }
+    catch (const PicModelStop &)
+    {
+        // Run time over
+    }
+
+    if (result != NULL)
+    {
+        *result = pic.result;
+        result->cycles = pic.cycle;
+    }
+}
+
+void PicModel_EraseFlash(void)
+{
+    for (uint16_t i = 0; i < PICMODEL_FLASH_WORDS; i++)
+    {
+        flash[i] = PICMODEL_FLASH_ERASED;
+    }
+    flashReady = true;
+}
+
+uint16_t PicModel_ReadFlash(uint16_t address)
+{
+    if (!flashReady)
+    {
+        PicModel_EraseFlash();
+    }
+    return flash[address & (PICMODEL_FLASH_WORDS - 1U)];
+}
+
+uint8_t PicModel_Read(PicSfr_t sfr)
+{
+    Advance(pic.access_cycles);
+
+    switch (sfr)
+    {
+    case PIC_PORTA:
+        return ReadPortA();
+    case PIC_PMCON2:
+        return 0;
+    default:
+        return pic.sfr[sfr];
+    }
+}
+
+void PicModel_Write(PicSfr_t sfr, uint8_t value)
+{
+    PicModel_WriteBits(sfr, 0xFF, value);
+}
+
+void PicModel_WriteBits(PicSfr_t sfr, uint8_t mask, uint8_t bits)
+{
+    Advance(pic.access_cycles);
+
+    // Bit instructions read the register, change the bits and write it back
+    uint8_t previous = (sfr == PIC_PORTA) ? ReadPortA() : pic.sfr[sfr];
+    uint8_t value = (uint8_t)((previous & (uint8_t)~mask) | (bits & mask));
+    uint8_t unlock = pic.unlock;
+
+    pic.unlock = 0;
+
+    switch (sfr)
+    {
+    case PIC_PORTA:
+        // Writes go to the output latch
+        pic.sfr[PIC_LATA] = value;
+        UpdateOutput();
+        break;
+
+    case PIC_LATA:
+    case PIC_TRISA:
+        pic.sfr[sfr] = value;
+        UpdateOutput();
+        break;
+
+    case PIC_TMR0:
+        pic.sfr[PIC_TMR0] = value;
+        pic.prescaler = 0;
+        pic.tmr0_hold = PIC_TMR0_INHIBIT;
+        break;
+
+    case PIC_ADCON:
+        if (!(value & PIC_ADCON_GO))
+        {
+            pic.adc_cycles = 0;
+        }
+        else if ((value & PIC_ADCON_ADON) && (pic.adc_cycles == 0U))
+        {
+            pic.adc_cycles = PICMODEL_ADC_TAD_CYCLES * PICMODEL_ADC_CONVERSION_TAD;
+        }
+        pic.sfr[PIC_ADCON] = value;
+        break;
+
+    case PIC_PMCON1:
+        pic.sfr[PIC_PMCON1] = (uint8_t)(value | 0x80U);
+        if ((value & PIC_PMCON1_RD) && !(value & PIC_PMCON1_CFGS))
+        {
+            uint16_t address = (uint16_t)((pic.sfr[PIC_PMADRH] << 8) | pic.sfr[PIC_PMADRL]);
+            uint16_t word = PicModel_ReadFlash(address);
+
+            pic.sfr[PIC_PMDATL] = (uint8_t)word;
+            pic.sfr[PIC_PMDATH] = (uint8_t)(word >> 8);
+        }
+        pic.sfr[PIC_PMCON1] &= (uint8_t)~PIC_PMCON1_RD;
+        if ((value & PIC_PMCON1_WR) && !(previous & PIC_PMCON1_WR))
+        {
+            // Without the unlock sequence right before, WR is ignored
+            if ((unlock == 2U) && (value & PIC_PMCON1_WREN) && !(value & PIC_PMCON1_CFGS))
+            {
+                StartFlashWrite();
+            }
+            pic.sfr[PIC_PMCON1] &= (uint8_t)~PIC_PMCON1_WR;
+        }
+        break;
+
+    case PIC_PMCON2:
+        pic.unlock = (value == 0x55U) ? 1U : ((value == 0xAAU) && (unlock == 1U)) ? 2U : 0U;
+        break;
+
+    default:
+        pic.sfr[sfr] = value;
+        break;
+    }
+}
+
+void PicModel_Delay(uint32_t cycles)
+{
+    Advance(cycles);
+}
+
+/**
+  Section: Private Function Implementations
+*/
+
+static void Advance(uint32_t cycles)
+{
+    pic.cycle += cycles;
+
+    if (pic.adc_cycles != 0U)
+    {
+        if (cycles >= pic.adc_cycles)
+        {
+            uint8_t channel = (uint8_t)((pic.sfr[PIC_ADCON] & PIC_ADCON_CHS) >> 2);
+
+            pic.adc_cycles = 0;
+            pic.sfr[PIC_ADRES] = (channel == PIC_LIMIT_CHANNEL) ? pic.config->limit : 0U;
+            pic.sfr[PIC_ADCON] &= (uint8_t)~PIC_ADCON_GO;
+        }
+        else
+        {
+            pic.adc_cycles = (uint16_t)(pic.adc_cycles - cycles);
+        }
+    }
+
+    uint32_t counts = cycles;
+    if (pic.tmr0_hold != 0U)
+    {
+        uint32_t hold = (counts < pic.tmr0_hold) ? counts : pic.tmr0_hold;
+        pic.tmr0_hold = (uint8_t)(pic.tmr0_hold - hold);
+        counts -= hold;
+    }
+
+    uint8_t option = pic.sfr[PIC_OPTION_REG];
+    if (!(option & PIC_OPTION_T0CS))
+    {
+        if (!(option & PIC_OPTION_PSA))
+        {
+            // Prescaler 1:2 (PS 0) to 1:256 (PS 7)
+            uint8_t shift = (uint8_t)((option & PIC_OPTION_PS) + 1U);
+            uint32_t total = pic.prescaler + counts;
+
+            counts = total >> shift;
+            pic.prescaler = (uint16_t)(total & ((1UL << shift) - 1U));
+        }
+
+        uint32_t timer = pic.sfr[PIC_TMR0] + counts;
+        if (timer > 0xFFU)
+        {
+            pic.sfr[PIC_INTCON] |= PIC_INTCON_TMR0IF;
+        }
+        pic.sfr[PIC_TMR0] = (uint8_t)timer;
+    }
+
+    if (pic.cycle >= pic.end_cycle)
+    {
+        throw PicModelStop();
+    }
+}
+
+static uint8_t ReadPortA(void)
+{
+    uint8_t tris = pic.sfr[PIC_TRISA];
+    uint8_t pullup = (pic.sfr[PIC_OPTION_REG] & PIC_OPTION_nWPUEN) ? 0U : pic.sfr[PIC_WPUA];
+    uint8_t value = 0;
+
+    for (uint8_t pin = 0; pin < 3U; pin++)
+    {
+        uint8_t bit = (uint8_t)(1U << pin);
+
+        if (!(tris & bit))
+        {
+            value |= pic.sfr[PIC_LATA] & bit;
+        }
+        else if (pic.sfr[PIC_ANSELA] & bit)
+        {
+            // Analog input reads 0
+        }
+        else if (pin == 0U)
+        {
+            uint64_t now = pic.cycle * PICMODEL_CYCLE_NS;
+            value |= pic.config->input(now, pic.config->context) ? bit : 0U;
+        }
+        else
+        {
+            value |= pullup & bit;
+        }
+    }
+
+    // RA3 is the button input, released
+    return (uint8_t)(value | 0x08U);
+}
+
+static void UpdateOutput(void)
+{
+    // A floating output counts as low, the load pulls it down
+    uint8_t level = (!(pic.sfr[PIC_TRISA] & PIC_OUTPUT_PIN) && (pic.sfr[PIC_LATA] & PIC_OUTPUT_PIN)) ? 1U : 0U;
+
+    if (level != pic.output)
+    {
+        pic.output = level;
+        pic.result.output_edges++;
+        if (pic.config->output != NULL)
+        {
+            pic.config->output(pic.cycle * PICMODEL_CYCLE_NS, level, pic.config->context);
+        }
+    }
+}
+
+static void StartFlashWrite(void)
+{
+    uint16_t address = (uint16_t)(((pic.sfr[PIC_PMADRH] << 8) | pic.sfr[PIC_PMADRL]) & (PICMODEL_FLASH_WORDS - 1U));
+    uint16_t row = (uint16_t)(address & ~(PICMODEL_FLASH_ROW_WORDS - 1U));
+    uint8_t control = pic.sfr[PIC_PMCON1];
+
+    if (control & PIC_PMCON1_FREE)
+    {
+        for (uint8_t i = 0; i < PICMODEL_FLASH_ROW_WORDS; i++)
+        {
+            flash[row + i] = PICMODEL_FLASH_ERASED;
+        }
+        pic.result.flash_erases++;
+        pic.sfr[PIC_PMCON1] &= (uint8_t)~PIC_PMCON1_FREE;
+    }
+    else
+    {
+        pic.latch[address - row] = (uint16_t)(((pic.sfr[PIC_PMDATH] << 8) | pic.sfr[PIC_PMDATL]) & PICMODEL_FLASH_ERASED);
+        if (control & PIC_PMCON1_LWLO)
+        {
+            // Latch loaded, no write yet
+            return;
+        }
+        for (uint8_t i = 0; i < PICMODEL_FLASH_ROW_WORDS; i++)
+        {
+            // Programming only clears bits
+            flash[row + i] &= pic.latch[i];
+            pic.latch[i] = PICMODEL_FLASH_ERASED;
+        }
+        pic.result.flash_writes++;
+        pic.result.save_ns = pic.cycle * PICMODEL_CYCLE_NS;
+    }
+
+    // The CPU stops while the cell is written, the timer does not
+    Advance(PICMODEL_FLASH_WRITE_US * (PICMODEL_FOSC_HZ / 4000000UL));
+}
+
+static void __attribute__((noinline)) PaintStack(uint8_t fill)
+{
+    // main() keeps its locals in the stack area below the caller, like the
+    // compiled stack in RAM they start with whatever is there
+    volatile uint8_t area[PIC_STACK_PAINT];
+
+    for (uint16_t i = 0; i < PIC_STACK_PAINT; i++)
+    {
+        area[i] = fill;
+    }
+    (void)area[0];
+}
+
+/**
+ End of File
+*/
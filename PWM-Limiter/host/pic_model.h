@@ -0,0 +1,160 @@
+/**
+  PIC10F322 Host Peripheral Model Header File
+
+  @File Name
+    pic_model.h
+
+  @Summary
+    Cycle-stepped model of the PIC10F322 peripherals used by the PWM limiter
+
+  @Description
+    The host xc.h maps every SFR used by the firmware onto PicModel_Read()
+    and PicModel_Write(). Each access advances the instruction clock by the
+    average cost of the code around it; TMR0 with its prescaler, the ADC and
+    the flash self-write run on that clock. RA0 (PWM_INPUT) is read from a
+    waveform callback, RA1 (PWM_OUTPUT) edges are reported to a recorder
+    callback, AN2 (PWM_LIMIT) converts a fixed pot setting.
+
+    The firmware is compiled as C++ on the host, so src/main.c runs
+    unchanged: its main() is renamed to PwmLimiter_Main() and ends when
+    the run time is over.
+*/
+
+#ifndef PIC_MODEL_H
+#define PIC_MODEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+  Section: Macro Declarations
+*/
+
+#define PICMODEL_FOSC_HZ            16000000UL /* INTOSC, IRCF 16 MHz like OSCILLATOR_Initialize() */
+#define PICMODEL_CYCLE_NS           (4000000000ULL / PICMODEL_FOSC_HZ) /* One instruction cycle, Fosc/4 */
+#define PICMODEL_ACCESS_CYCLES      10U        /* Default instruction cycles per SFR access, see PicModel_Config_t */
+#define PICMODEL_ADC_TAD_CYCLES     16U        /* ADCS FOSC/64 */
+#define PICMODEL_ADC_CONVERSION_TAD 10U        /* 8-bit conversion */
+#define PICMODEL_FLASH_WRITE_US     2000U      /* Row erase or row write, CPU stalled */
+#define PICMODEL_FLASH_WORDS        0x200U     /* END_FLASH */
+#define PICMODEL_FLASH_ROW_WORDS    16U        /* ERASE_FLASH_BLOCKSIZE and WRITE_FLASH_BLOCKSIZE */
+#define PICMODEL_FLASH_ERASED       0x3FFFU
+
+/**
+  Section: Data Types Definitions
+*/
+
+/* SFRs used by the firmware, index into the model's register file */
+typedef enum
+{
+    PIC_PORTA,
+    PIC_LATA,
+    PIC_TRISA,
+    PIC_ANSELA,
+    PIC_WPUA,
+    PIC_OPTION_REG,
+    PIC_TMR0,
+    PIC_INTCON,
+    PIC_ADCON,
+    PIC_ADRES,
+    PIC_PMADRL,
+    PIC_PMADRH,
+    PIC_PMDATL,
+    PIC_PMDATH,
+    PIC_PMCON1,
+    PIC_PMCON2,
+    PIC_OSCCON,
+    PIC_CLKRCON,
+    PIC_BORCON,
+    PIC_WDTCON,
+    PIC_SFR_COUNT
+} PicSfr_t;
+
+/* Level of PWM_INPUT (RA0) at a time since power-up */
+typedef uint8_t (*PicModel_Input_t)(uint64_t time_ns, void *context);
+
+/* PWM_OUTPUT (RA1) changed to level at a time since power-up */
+typedef void (*PicModel_Output_t)(uint64_t time_ns, uint8_t level, void *context);
+
+/* One power-up of the limiter */
+typedef struct
+{
+    PicModel_Input_t input;     /* PWM input waveform */
+    PicModel_Output_t output;   /* Output edge recorder, may be NULL */
+    void *context;              /* Passed to both callbacks */
+    uint8_t limit;              /* AN2 conversion result, the pot setting (0-255) */
+    uint64_t duration_ns;       /* Run time, then PwmLimiter_Main() is left */
+    uint8_t access_cycles;      /* Instruction cycles per SFR access, 0 for PICMODEL_ACCESS_CYCLES.
+                                   The PWM_OUTPUT_STATE loop makes 4 accesses in about 40 instructions */
+    uint8_t ram_fill;           /* RAM content at power-up, main() reads timer[] before writing it */
+} PicModel_Config_t;
+
+/* What happened during a run */
+typedef struct
+{
+    uint64_t cycles;            /* Instruction cycles run */
+    uint64_t save_ns;           /* Time of the last flash row write, 0 if none */
+    uint32_t flash_writes;      /* Row writes */
+    uint32_t flash_erases;      /* Row erases */
+    uint32_t output_edges;      /* PWM_OUTPUT changes */
+} PicModel_Result_t;
+
+/**
+  Section: Model APIs
+*/
+
+/**
+  @Summary
+    Runs the firmware from power-up
+
+  @Description
+    Registers get their power-on values and the firmware globals their
+    initial values, program memory keeps its content between runs like the
+    real part. Returns when config->duration_ns of
+    simulated time has passed.
+
+  @Param
+    config - input waveform, recorder, pot setting and run time
+    result - filled with the run statistics, may be NULL
+*/
+void PicModel_Run(const PicModel_Config_t *config, PicModel_Result_t *result);
+
+/**
+  @Summary
+    Erases the whole program memory, calibration included
+*/
+void PicModel_EraseFlash(void);
+
+/**
+  @Summary
+    Reads one program memory word, for checking what the firmware saved
+
+  @Param
+    address - word address (0-0x1FF)
+
+  @Returns
+    14-bit word
+*/
+uint16_t PicModel_ReadFlash(uint16_t address);
+
+/**
+  @Summary
+    SFR access from the host xc.h, advances the clock by one access
+*/
+uint8_t PicModel_Read(PicSfr_t sfr);
+void PicModel_Write(PicSfr_t sfr, uint8_t value);
+void PicModel_WriteBits(PicSfr_t sfr, uint8_t mask, uint8_t bits);
+
+/**
+  @Summary
+    Busy wait of __delay_us() and NOP()
+
+  @Param
+    cycles - instruction cycles
+*/
+void PicModel_Delay(uint32_t cycles);
+
+#endif /* PIC_MODEL_H */
+/**
+ End of File
+*/
@@ -0,0 +1,506 @@
+/**
+  PWM Limiter Benchmark
+
+  @File Name
+    pwm_bench.cpp
+
+  @Summary
+    Accuracy and latency of the limiter firmware over a fixed waveform corpus
+
+  @Description
+    Every corpus entry powers the host model up with the input running,
+    so the firmware calibrates and then limits; restart entries power it
+    up a second time with the input low, on the program memory the first
+    run left. After lock, the output is compared period by period with the
+    ideal limiter: high from the input rising edge until the input falls or
+    the pot fraction of the period has passed, whichever is first.
+    Reported per entry:
+      - lock: first output edge after power-up
+      - duty error: measured minus ideal duty per period, in percentage points
+      - rise: input rising edge to output rising edge
+      - fall: output falling edge against the ideal one, absolute
+      - missed periods without an output pulse, extra pulses in a period
+      - settle: after a frequency step, time until every later period is
+        within PWMBENCH_SETTLE_PP
+    The corpus is synthetic with fixed seeds, so two builds of the firmware
+    give comparable numbers; -o writes them as CSV for diffing. Recorded
+    inputs run with -w.
+
+    Build from PWM-Limiter/:
+      g++ -O2 -Wall -Ihost -Isrc -Isrc/adc -Isrc/device_config -Isrc/dio \
+          -Isrc/flash -Isrc/mcc -Isrc/tmr -ffunction-sections -Wl,--gc-sections \
+          host/pwm_bench.cpp host/waveform.cpp host/pic_model.cpp host/limiter_main.cpp \
+          -x c++ src/adc/adc.c src/dio/dio.c src/flash/flash.c src/mcc/mcc.c \
+          src/tmr/tmr.c -o pwm-bench
+
+    Usage:
+      pwm-bench [-s name] [-w capture.csv -l limit%] [-c cycles] [-r fill] [-o results.csv]
+*/
+
+/**
+  Section: Included Files
+*/
+
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+#include "pic_model.h"
+#include "waveform.h"
+
+/**
+  Section: Macro Declarations
+*/
+
+#define PWMBENCH_SETTLE_PP      3.0    /* Duty error of a settled period, percentage points */
+#define PWMBENCH_MAX_SEGMENTS   3U
+
+/**
+  Section: Data Types Definitions
+*/
+
+/* One corpus entry */
+typedef struct
+{
+    const char *name;
+    double limit;               /* Pot setting, % */
+    uint32_t seed;              /* Jitter generator */
+    bool restart;               /* Measured on a second power-up with the input low */
+    size_t count;
+    Waveform_Segment_t segments[PWMBENCH_MAX_SEGMENTS];
+} Scenario_t;
+
+typedef struct
+{
+    Waveform_t input;
+    std::vector<Waveform_Edge_t> output;
+} Bench_t;
+
+typedef struct
+{
+    bool locked;
+    double lock_ms;
+    uint32_t periods;
+    uint32_t missed;
+    uint32_t extra;
+    double duty_mean;           /* pp, signed */
+    double duty_p95;            /* pp, absolute */
+    double rise_p50;            /* us */
+    double rise_p95;
+    double rise_max;
+    double fall_p50;            /* us, absolute */
+    double fall_p95;
+    double fall_max;
+    bool stepped;
+    bool settled;
+    double settle_ms;
+} Metrics_t;
+
+/**
+  Section: Corpus
+*/
+
+static const Scenario_t corpus[] =
+{
+    // name                      limit  seed  restart  segments: ms, Hz, duty from, to, period jitter %, duty jitter pp
+    { "servo-50hz",              7.5,   0U,   false, 1U, { { 4000.0, 50.0, 5.0, 10.0, 0.0, 0.0 } } },
+    { "servo-50hz-jitter",       6.0,   11U,  false, 1U, { { 4000.0, 50.0, 7.5, 7.5, 2.0, 1.0 } } },
+    { "fan-25khz",               40.0,  0U,   false, 1U, { { 1000.0, 25000.0, 60.0, 60.0, 0.0, 0.0 } } },
+    { "motor-1khz",              50.0,  0U,   false, 1U, { { 2000.0, 1000.0, 80.0, 80.0, 0.0, 0.0 } } },
+    { "motor-1khz-restart",      50.0,  0U,   true,  1U, { { 2000.0, 1000.0, 80.0, 80.0, 0.0, 0.0 } } },
+    { "motor-1khz-sweep",        50.0,  0U,   false, 1U, { { 3000.0, 1000.0, 10.0, 90.0, 0.0, 0.0 } } },
+    { "motor-5khz",              50.0,  0U,   false, 1U, { { 2000.0, 5000.0, 80.0, 80.0, 0.0, 0.0 } } },
+    { "motor-10khz",             50.0,  0U,   false, 1U, { { 2000.0, 10000.0, 80.0, 80.0, 0.0, 0.0 } } },
+    { "motor-20khz",             50.0,  0U,   false, 1U, { { 2000.0, 20000.0, 80.0, 80.0, 0.0, 0.0 } } },
+    { "jitter-period-2khz",      50.0,  1U,   false, 1U, { { 2000.0, 2000.0, 70.0, 70.0, 5.0, 0.0 } } },
+    { "jitter-duty-1khz",        50.0,  2U,   false, 1U, { { 2000.0, 1000.0, 60.0, 60.0, 0.0, 20.0 } } },
+    { "step-1khz-4khz",          50.0,  0U,   false, 2U, { { 1500.0, 1000.0, 80.0, 80.0, 0.0, 0.0 },
+                                                           { 1500.0, 4000.0, 80.0, 80.0, 0.0, 0.0 } } },
+    { "step-4khz-1khz",          50.0,  0U,   false, 2U, { { 1500.0, 4000.0, 80.0, 80.0, 0.0, 0.0 },
+                                                           { 1500.0, 1000.0, 80.0, 80.0, 0.0, 0.0 } } },
+    { "step-1khz-1.1khz",        50.0,  0U,   false, 2U, { { 1500.0, 1000.0, 80.0, 80.0, 0.0, 0.0 },
+                                                           { 1500.0, 1100.0, 80.0, 80.0, 0.0, 0.0 } } },
+};
+
+#define PWMBENCH_CORPUS_SIZE (sizeof(corpus) / sizeof(corpus[0]))
+
+/**
+  Section: Private Function Prototypes
+*/
+
+static uint8_t InputLevel(uint64_t time_ns, void *context);
+static void RecordOutput(uint64_t time_ns, uint8_t level, void *context);
+static void RunModel(Bench_t *bench, uint8_t adc, const PicModel_Config_t *base);
+static void Measure(const Bench_t *bench, uint8_t adc, uint64_t step_ns, Metrics_t *metrics);
+static size_t FirstEdgeAt(const std::vector<Waveform_Edge_t> &edges, uint64_t time_ns);
+static double Percentile(std::vector<double> values, double fraction);
+static uint8_t LimitToAdc(double limit);
+static void PrintHeader(FILE *csv);
+static void PrintMetrics(const char *name, double limit, const Metrics_t *metrics, FILE *csv);
+static void Usage(void);
+
+/**
+  Section: Benchmark
+*/
+
+int main(int argc, char **argv)
+{
+    const char *only = NULL;
+    const char *capture = NULL;
+    const char *csv_path = NULL;
+    double capture_limit = 50.0;
+    unsigned access_cycles = 0;
+    unsigned ram_fill = 0;
+    int option;
+
+    while ((option = getopt(argc, argv, "s:w:l:c:r:o:h")) != -1)
+    {
+        switch (option)
+        {
+        case 's': only = optarg; break;
+        case 'w': capture = optarg; break;
+        case 'l': capture_limit = atof(optarg); break;
+        case 'c': access_cycles = (unsigned)strtoul(optarg, NULL, 0); break;
+        case 'r': ram_fill = (unsigned)strtoul(optarg, NULL, 0); break;
+        case 'o': csv_path = optarg; break;
+        default: Usage(); return 1;
+        }
+    }
+    if ((access_cycles > 255U) || (ram_fill > 255U) || (capture_limit < 0.0) || (capture_limit > 100.0))
+    {
+        Usage();
+        return 1;
+    }
+
+    bool known = (only == NULL);
+    for (size_t i = 0; i < PWMBENCH_CORPUS_SIZE; i++)
+    {
+        known = known || (strcmp(only, corpus[i].name) == 0);
+    }
+    if (!known)
+    {
+        fprintf(stderr, "no corpus entry named %s\n", only);
+        return 1;
+    }
+
+    FILE *csv = NULL;
+    if (csv_path != NULL)
+    {
+        csv = fopen(csv_path, "w");
+        if (csv == NULL)
+        {
+            fprintf(stderr, "cannot write %s\n", csv_path);
+            return 1;
+        }
+    }
+
+    PicModel_Config_t base = {};
+    base.access_cycles = (uint8_t)access_cycles;
+    base.ram_fill = (uint8_t)ram_fill;
+
+    Bench_t bench;
+    Metrics_t metrics;
+
+    PrintHeader(csv);
+
+    if (capture != NULL)
+    {
+        if (!Waveform_Load(&bench.input, capture))
+        {
+            fprintf(stderr, "cannot read %s\n", capture);
+            return 1;
+        }
+        PicModel_EraseFlash();
+        RunModel(&bench, LimitToAdc(capture_limit), &base);
+        Measure(&bench, LimitToAdc(capture_limit), 0U, &metrics);
+        PrintMetrics(capture, capture_limit, &metrics, csv);
+    }
+
+    for (size_t i = 0; (capture == NULL) && (i < PWMBENCH_CORPUS_SIZE); i++)
+    {
+        const Scenario_t *scenario = &corpus[i];
+        uint8_t adc = LimitToAdc(scenario->limit);
+        uint64_t start_low_ns = 0;
+
+        if ((only != NULL) && (strcmp(only, scenario->name) != 0))
+        {
+            continue;
+        }
+
+        PicModel_EraseFlash();
+        Waveform_Synth(&bench.input, scenario->segments, scenario->count, scenario->seed, 0U);
+        RunModel(&bench, adc, &base);
+
+        if (scenario->restart)
+        {
+            // Low for the rest of the first period, then the same waveform
+            const Waveform_Segment_t *first = &scenario->segments[0];
+
+            start_low_ns = (uint64_t)(1e9 / first->frequency * (100.0 - first->duty_start) / 100.0);
+            Waveform_Synth(&bench.input, scenario->segments, scenario->count, scenario->seed, start_low_ns);
+            RunModel(&bench, adc, &base);
+        }
+
+        uint64_t step_ns = (scenario->count > 1U) ?
+                           start_low_ns + (uint64_t)(scenario->segments[0].duration_ms * 1e6) : 0U;
+        Measure(&bench, adc, step_ns, &metrics);
+        PrintMetrics(scenario->name, scenario->limit, &metrics, csv);
+    }
+
+    if (csv != NULL)
+    {
+        fclose(csv);
+    }
+    return 0;
+}
+
+/**
+  Section: Private Function Implementations
+*/
+
+static uint8_t InputLevel(uint64_t time_ns, void *context)
+{
+    Bench_t *bench = (Bench_t *)context;
+
+    return Waveform_Level(&bench->input, time_ns);
+}
+
+static void RecordOutput(uint64_t time_ns, uint8_t level, void *context)
+{
+    Bench_t *bench = (Bench_t *)context;
+
+    bench->output.push_back({ time_ns, level });
+}
+
+static void RunModel(Bench_t *bench, uint8_t adc, const PicModel_Config_t *base)
+{
+    PicModel_Config_t config = *base;
+
+    config.input = InputLevel;
+    config.output = RecordOutput;
+    config.context = bench;
+    config.limit = adc;
+    config.duration_ns = bench->input.duration_ns;
+
+    bench->input.cursor = 0;
+    bench->output.clear();
+    PicModel_Run(&config, NULL);
+}
+
+static void Measure(const Bench_t *bench, uint8_t adc, uint64_t step_ns, Metrics_t *metrics)
+{
+    const std::vector<Waveform_Edge_t> &input = bench->input.edges;
+    const std::vector<Waveform_Edge_t> &output = bench->output;
+    double fraction = adc / 255.0;
+    std::vector<double> duty;
+    std::vector<double> rise;
+    std::vector<double> fall;
+    std::vector<uint64_t> period_start;
+    std::vector<bool> period_ok;
+
+    memset(metrics, 0, sizeof(*metrics));
+    metrics->stepped = (step_ns != 0U);
+
+    size_t first_rise = FirstEdgeAt(output, 0U);
+    while ((first_rise < output.size()) && !output[first_rise].level)
+    {
+        first_rise++;
+    }
+    if (first_rise >= output.size())
+    {
+        return;
+    }
+    metrics->locked = true;
+    metrics->lock_ms = output[first_rise].time_ns / 1e6;
+
+    // Input edges alternate rising, falling: period k is input[i] to input[i + 2]
+    size_t i = FirstEdgeAt(input, output[first_rise].time_ns);
+    if ((i < input.size()) && !input[i].level)
+    {
+        i++;
+    }
+    for (; i + 2U < input.size(); i += 2U)
+    {
+        uint64_t start = input[i].time_ns;
+        uint64_t end = input[i + 2U].time_ns;
+        uint64_t limit_end = start + (uint64_t)(fraction * (double)(end - start));
+        uint64_t ideal_end = std::min(input[i + 1U].time_ns, limit_end);
+        double period = (double)(end - start);
+
+        if (end > bench->input.duration_ns)
+        {
+            break;
+        }
+
+        // Output over the period
+        size_t k = FirstEdgeAt(output, start);
+        uint8_t level = (k > 0U) ? output[k - 1U].level : 0U;
+        uint64_t since = start;
+        uint64_t high = 0;
+        uint32_t rises = 0;
+        bool falling = false;
+
+        for (; (k < output.size()) && (output[k].time_ns < end); k++)
+        {
+            if (level)
+            {
+                high += output[k].time_ns - since;
+            }
+            since = output[k].time_ns;
+            level = output[k].level;
+            if (level)
+            {
+                if (rises++ == 0U)
+                {
+                    rise.push_back((output[k].time_ns - start) / 1e3);
+                }
+            }
+            else if ((rises == 1U) && !falling)
+            {
+                falling = true;
+                fall.push_back(fabs((double)output[k].time_ns - (double)ideal_end) / 1e3);
+            }
+        }
+        if (level)
+        {
+            high += end - since;
+        }
+
+        double error = 100.0 * ((double)high - (double)(ideal_end - start)) / period;
+        bool missed = (rises == 0U) && (ideal_end > start);
+
+        duty.push_back(error);
+        metrics->periods++;
+        metrics->missed += missed ? 1U : 0U;
+        metrics->extra += (rises > 1U) ? (rises - 1U) : 0U;
+        period_start.push_back(start);
+        period_ok.push_back(!missed && (fabs(error) <= PWMBENCH_SETTLE_PP));
+    }
+
+    if (!duty.empty())
+    {
+        double sum = 0.0;
+        std::vector<double> magnitude;
+
+        for (double error : duty)
+        {
+            sum += error;
+            magnitude.push_back(fabs(error));
+        }
+        metrics->duty_mean = sum / duty.size();
+        metrics->duty_p95 = Percentile(magnitude, 0.95);
+    }
+    if (!rise.empty())
+    {
+        metrics->rise_p50 = Percentile(rise, 0.50);
+        metrics->rise_p95 = Percentile(rise, 0.95);
+        metrics->rise_max = Percentile(rise, 1.0);
+    }
+    if (!fall.empty())
+    {
+        metrics->fall_p50 = Percentile(fall, 0.50);
+        metrics->fall_p95 = Percentile(fall, 0.95);
+        metrics->fall_max = Percentile(fall, 1.0);
+    }
+
+    // Settled from the period after the last bad one
+    if (metrics->stepped)
+    {
+        size_t settled = period_ok.size();
+        while ((settled > 0U) && period_ok[settled - 1U])
+        {
+            settled--;
+        }
+        if (settled < period_ok.size())
+        {
+            uint64_t at = std::max(period_start[settled], step_ns);
+            metrics->settled = true;
+            metrics->settle_ms = (at - step_ns) / 1e6;
+        }
+    }
+}
+
+static size_t FirstEdgeAt(const std::vector<Waveform_Edge_t> &edges, uint64_t time_ns)
+{
+    // First edge at or after time_ns
+    auto found = std::lower_bound(edges.begin(), edges.end(), time_ns,
+                                  [](const Waveform_Edge_t &edge, uint64_t time) { return edge.time_ns < time; });
+    return (size_t)(found - edges.begin());
+}
+
+static double Percentile(std::vector<double> values, double fraction)
+{
+    size_t index = (size_t)ceil(fraction * values.size());
+
+    std::sort(values.begin(), values.end());
+    return values[(index > 0U) ? (index - 1U) : 0U];
+}
+
+static uint8_t LimitToAdc(double limit)
+{
+    return (uint8_t)(limit * 255.0 / 100.0 + 0.5);
+}
+
+static void PrintHeader(FILE *csv)
+{
+    printf("%-20s %5s %8s %7s %6s %6s %15s %20s %20s %9s\n", "waveform", "limit", "lock ms", "periods", "missed",
+           "extra", "duty pp mean/95", "rise us 50/95/max", "fall us 50/95/max", "settle ms");
+    if (csv != NULL)
+    {
+        fprintf(csv, "waveform,limit,lock_ms,periods,missed,extra,duty_mean_pp,duty_p95_pp,"
+                     "rise_p50_us,rise_p95_us,rise_max_us,fall_p50_us,fall_p95_us,fall_max_us,settle_ms\n");
+    }
+}
+
+static void PrintMetrics(const char *name, double limit, const Metrics_t *metrics, FILE *csv)
+{
+    char lock[16];
+    char settle[16];
+    char duty[32];
+    char rise[32];
+    char fall[32];
+
+    snprintf(lock, sizeof(lock), "none");
+    if (metrics->locked)
+    {
+        snprintf(lock, sizeof(lock), "%.1f", metrics->lock_ms);
+    }
+    snprintf(settle, sizeof(settle), metrics->stepped ? "never" : "-");
+    if (metrics->settled)
+    {
+        snprintf(settle, sizeof(settle), "%.1f", metrics->settle_ms);
+    }
+    snprintf(duty, sizeof(duty), "%+.1f/%.1f", metrics->duty_mean, metrics->duty_p95);
+    snprintf(rise, sizeof(rise), "%.0f/%.0f/%.0f", metrics->rise_p50, metrics->rise_p95, metrics->rise_max);
+    snprintf(fall, sizeof(fall), "%.0f/%.0f/%.0f", metrics->fall_p50, metrics->fall_p95, metrics->fall_max);
+
+    printf("%-20s %5.1f %8s %7u %6u %6u %15s %20s %20s %9s\n", name, limit, lock, metrics->periods,
+           metrics->missed, metrics->extra, duty, rise, fall, settle);
+    if (csv != NULL)
+    {
+        fprintf(csv, "%s,%.1f,%s,%u,%u,%u,%.2f,%.2f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%s\n", name, limit, lock,
+                metrics->periods, metrics->missed, metrics->extra, metrics->duty_mean, metrics->duty_p95,
+                metrics->rise_p50, metrics->rise_p95, metrics->rise_max, metrics->fall_p50, metrics->fall_p95,
+                metrics->fall_max, settle);
+    }
+}
+
+static void Usage(void)
+{
+    fprintf(stderr,
+            "usage: pwm-bench [-s name] [-w capture.csv -l limit%%] [-c cycles] [-r fill] [-o results.csv]\n"
+            "  -s  run one corpus entry\n"
+            "  -w  run a recorded input instead of the corpus, time,level per line\n"
+            "  -l  pot setting for -w in percent of full scale, default 50\n"
+            "  -c  instruction cycles per register access, default %u\n"
+            "  -r  RAM content at power-up, default 0\n"
+            "  -o  write the results as CSV\n",
+            PICMODEL_ACCESS_CYCLES);
+}
+
+/**
+ End of File
+*/
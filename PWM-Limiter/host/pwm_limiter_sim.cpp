@@ -0,0 +1,288 @@
+/**
+  PWM Limiter Host Simulator
+
+  @File Name
+    pwm_limiter_sim.cpp
+
+  @Summary
+    Runs the unchanged firmware on the PIC10F322 model with a PWM input
+
+  @Description
+    Two power-ups on the same program memory, as on the bench:
+      1. calibration: the input is high at power-up, the firmware measures
+         the period, reads the pot and saves the result
+      2. restart: the input is low at power-up, the firmware loads the
+         saved calibration and goes straight to the output
+    Each run reports the output frequency and duty over its second half
+    against the expected min(input duty, limit). The first run can be saved
+    as a VCD file for a waveform viewer.
+
+    Build from PWM-Limiter/:
+      g++ -O2 -Wall -Ihost -Isrc -Isrc/adc -Isrc/device_config -Isrc/dio \
+          -Isrc/flash -Isrc/mcc -Isrc/tmr -ffunction-sections -Wl,--gc-sections \
+          host/pwm_limiter_sim.cpp host/pic_model.cpp host/limiter_main.cpp \
+          -x c++ src/adc/adc.c src/dio/dio.c src/flash/flash.c src/mcc/mcc.c \
+          src/tmr/tmr.c -o pwm-limiter-sim
+
+    Usage:
+      pwm-limiter-sim [-f hz] [-d duty%] [-l limit%] [-t ms] [-c cycles] [-r fill] [-o file.vcd]
+*/
+
+/**
+  Section: Included Files
+*/
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <vector>
+#include "pic_model.h"
+
+/**
+  Section: Data Types Definitions
+*/
+
+typedef struct
+{
+    uint64_t time_ns;
+    uint8_t level;
+} Edge_t;
+
+typedef struct
+{
+    uint64_t period_ns;
+    uint64_t high_ns;
+    uint64_t phase_ns;          /* Time into the period at power-up */
+    std::vector<Edge_t> output;
+} Bench_t;
+
+typedef struct
+{
+    double frequency;
+    double duty;
+} Measure_t;
+
+/**
+  Section: Private Function Prototypes
+*/
+
+static uint8_t InputLevel(uint64_t time_ns, void *context);
+static void RecordOutput(uint64_t time_ns, uint8_t level, void *context);
+static Measure_t MeasureOutput(const std::vector<Edge_t> &edges, uint64_t from_ns, uint64_t to_ns);
+static void Report(const char *name, const Bench_t &bench, const PicModel_Result_t &result,
+                   uint64_t duration_ns, double expected);
+static bool WriteVcd(const char *path, const Bench_t &bench, uint64_t duration_ns);
+static void Usage(void);
+
+/**
+  Section: Simulator
+*/
+
+int main(int argc, char **argv)
+{
+    double frequency = 1000.0;
+    double duty = 75.0;
+    double limit = 50.0;
+    double run_ms = 1000.0;
+    unsigned access_cycles = 0;
+    unsigned ram_fill = 0;
+    const char *vcd = NULL;
+    int option;
+
+    while ((option = getopt(argc, argv, "f:d:l:t:c:r:o:h")) != -1)
+    {
+        switch (option)
+        {
+        case 'f': frequency = atof(optarg); break;
+        case 'd': duty = atof(optarg); break;
+        case 'l': limit = atof(optarg); break;
+        case 't': run_ms = atof(optarg); break;
+        case 'c': access_cycles = (unsigned)strtoul(optarg, NULL, 0); break;
+        case 'r': ram_fill = (unsigned)strtoul(optarg, NULL, 0); break;
+        case 'o': vcd = optarg; break;
+        default: Usage(); return 1;
+        }
+    }
+    if ((frequency <= 0.0) || (duty <= 0.0) || (duty >= 100.0) || (limit < 0.0) || (limit > 100.0) ||
+        (run_ms <= 0.0) || (access_cycles > 255U) || (ram_fill > 255U))
+    {
+        Usage();
+        return 1;
+    }
+
+    Bench_t bench;
+    bench.period_ns = (uint64_t)(1e9 / frequency);
+    bench.high_ns = (uint64_t)(bench.period_ns * duty / 100.0);
+
+    PicModel_Config_t config = {};
+    config.input = InputLevel;
+    config.output = RecordOutput;
+    config.context = &bench;
+    config.limit = (uint8_t)(limit * 255.0 / 100.0 + 0.5);
+    config.duration_ns = (uint64_t)(run_ms * 1e6);
+    config.access_cycles = (uint8_t)access_cycles;
+    config.ram_fill = (uint8_t)ram_fill;
+
+    double expected = (duty < limit) ? duty : limit;
+    printf("input %.1f Hz, duty %.1f %%, limit %.1f %% (ADC %u), %.0f ms per run\n",
+           frequency, duty, limit, config.limit, run_ms);
+
+    PicModel_Result_t result;
+    auto start = std::chrono::steady_clock::now();
+
+    // Power-up with the input high: calibration
+    PicModel_EraseFlash();
+    bench.phase_ns = 0;
+    PicModel_Run(&config, &result);
+    Report("calibration", bench, result, config.duration_ns, expected);
+    if ((vcd != NULL) && !WriteVcd(vcd, bench, config.duration_ns))
+    {
+        fprintf(stderr, "cannot write %s\n", vcd);
+        return 1;
+    }
+
+    // Power-up with the input low: saved calibration
+    bench.phase_ns = bench.high_ns;
+    bench.output.clear();
+    PicModel_Run(&config, &result);
+    Report("restart", bench, result, config.duration_ns, expected);
+
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double simulated = 2.0 * run_ms / 1000.0;
+    printf("simulated %.3f s in %.3f s, %.0fx real time\n", simulated, wall, simulated / wall);
+    return 0;
+}
+
+/**
+  Section: Private Function Implementations
+*/
+
+static uint8_t InputLevel(uint64_t time_ns, void *context)
+{
+    const Bench_t *bench = (const Bench_t *)context;
+
+    return (((time_ns + bench->phase_ns) % bench->period_ns) < bench->high_ns) ? 1U : 0U;
+}
+
+static void RecordOutput(uint64_t time_ns, uint8_t level, void *context)
+{
+    Bench_t *bench = (Bench_t *)context;
+
+    bench->output.push_back({ time_ns, level });
+}
+
+static Measure_t MeasureOutput(const std::vector<Edge_t> &edges, uint64_t from_ns, uint64_t to_ns)
+{
+    Measure_t measure = { 0.0, 0.0 };
+    uint64_t high_ns = 0;
+    uint64_t since = from_ns;
+    uint8_t level = 0;
+    uint32_t rising = 0;
+
+    for (const Edge_t &edge : edges)
+    {
+        if (edge.time_ns >= to_ns)
+        {
+            break;
+        }
+        if (edge.time_ns > from_ns)
+        {
+            if (level)
+            {
+                high_ns += edge.time_ns - since;
+            }
+            rising += edge.level ? 1U : 0U;
+            since = edge.time_ns;
+        }
+        level = edge.level;
+    }
+    if (level)
+    {
+        high_ns += to_ns - since;
+    }
+
+    measure.frequency = rising * 1e9 / (double)(to_ns - from_ns);
+    measure.duty = 100.0 * (double)high_ns / (double)(to_ns - from_ns);
+    return measure;
+}
+
+static void Report(const char *name, const Bench_t &bench, const PicModel_Result_t &result,
+                   uint64_t duration_ns, double expected)
+{
+    Measure_t measure = MeasureOutput(bench.output, duration_ns / 2U, duration_ns);
+
+    printf("%s: ", name);
+    if (!bench.output.empty())
+    {
+        printf("first output at %.1f ms, ", bench.output.front().time_ns / 1e6);
+    }
+    else
+    {
+        printf("no output, ");
+    }
+    printf("%u flash erases, %u writes", result.flash_erases, result.flash_writes);
+    if (result.flash_writes != 0U)
+    {
+        printf(" (saved at %.1f ms)", result.save_ns / 1e6);
+    }
+    printf("\n  output %.1f Hz, duty %.1f %% (expected %.1f %%)\n", measure.frequency, measure.duty, expected);
+}
+
+static bool WriteVcd(const char *path, const Bench_t &bench, uint64_t duration_ns)
+{
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    fprintf(file, "$timescale 1ns $end\n$scope module pwm_limiter $end\n");
+    fprintf(file, "$var wire 1 i PWM_INPUT $end\n$var wire 1 o PWM_OUTPUT $end\n");
+    fprintf(file, "$upscope $end\n$enddefinitions $end\n#0\n1i\n0o\n");
+
+    // Input edges come from the waveform, merged with the recorded output
+    size_t next = 0;
+    for (uint64_t period = 0; period < duration_ns; period += bench.period_ns)
+    {
+        const Edge_t input[2] = { { period + bench.high_ns, 0U }, { period + bench.period_ns, 1U } };
+
+        for (const Edge_t &edge : input)
+        {
+            if (edge.time_ns >= duration_ns)
+            {
+                break;
+            }
+            for (; (next < bench.output.size()) && (bench.output[next].time_ns <= edge.time_ns); next++)
+            {
+                fprintf(file, "#%llu\n%uo\n", (unsigned long long)bench.output[next].time_ns, bench.output[next].level);
+            }
+            fprintf(file, "#%llu\n%ui\n", (unsigned long long)edge.time_ns, edge.level);
+        }
+    }
+    for (; next < bench.output.size(); next++)
+    {
+        fprintf(file, "#%llu\n%uo\n", (unsigned long long)bench.output[next].time_ns, bench.output[next].level);
+    }
+
+    fclose(file);
+    return true;
+}
+
+static void Usage(void)
+{
+    fprintf(stderr,
+            "usage: pwm-limiter-sim [-f hz] [-d duty%%] [-l limit%%] [-t ms] [-c cycles] [-r fill] [-o file.vcd]\n"
+            "  -f  input frequency, default 1000\n"
+            "  -d  input duty cycle, default 75\n"
+            "  -l  pot setting in percent of full scale, default 50\n"
+            "  -t  length of each run, default 1000\n"
+            "  -c  instruction cycles per register access, default %u\n"
+            "  -r  RAM content at power-up, default 0\n"
+            "  -o  save the calibration run as VCD\n",
+            PICMODEL_ACCESS_CYCLES);
+}
+
+/**
+ End of File
+*/
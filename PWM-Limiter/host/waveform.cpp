@@ -0,0 +1,155 @@
+/**
+  PWM Input Waveforms
+
+  @File Name
+    waveform.cpp
+
+  @Summary
+    Synthetic and recorded PWM input edge lists for the host model
+*/
+
+/**
+  Section: Included Files
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "waveform.h"
+
+/**
+  Section: Macro Declarations
+*/
+
+#define WAVEFORM_DUTY_MIN   0.5     /* %, a jittered pulse never disappears */
+#define WAVEFORM_DUTY_MAX   99.5
+
+/**
+  Section: Private Function Prototypes
+*/
+
+static double Jitter(uint32_t *state);
+
+/**
+  Section: Waveform APIs
+*/
+
+void Waveform_Synth(Waveform_t *wave, const Waveform_Segment_t *segments, size_t count,
+                    uint32_t seed, uint64_t start_low_ns)
+{
+    uint32_t state = (seed != 0U) ? seed : 1U;
+    double time = (double)start_low_ns;
+    double start = time;
+
+    wave->edges.clear();
+    wave->cursor = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const Waveform_Segment_t *segment = &segments[i];
+        double length = segment->duration_ms * 1e6;
+        double end = start + length;
+
+        while (time < end)
+        {
+            double progress = (time - start) / length;
+            double period = (1e9 / segment->frequency) * (1.0 + segment->period_jitter / 100.0 * Jitter(&state));
+            double duty = segment->duty_start + (segment->duty_end - segment->duty_start) * progress +
+                          segment->duty_jitter * Jitter(&state);
+
+            if (duty < WAVEFORM_DUTY_MIN)
+            {
+                duty = WAVEFORM_DUTY_MIN;
+            }
+            else if (duty > WAVEFORM_DUTY_MAX)
+            {
+                duty = WAVEFORM_DUTY_MAX;
+            }
+
+            wave->edges.push_back({ (uint64_t)time, 1U });
+            wave->edges.push_back({ (uint64_t)(time + period * duty / 100.0), 0U });
+            time += period;
+        }
+        start = end;
+    }
+
+    wave->duration_ns = (uint64_t)start;
+}
+
+bool Waveform_Load(Waveform_t *wave, const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    char line[256];
+    bool first = true;
+    double origin = 0.0;
+    double last = 0.0;
+    uint8_t level = 0;
+
+    wave->edges.clear();
+    wave->cursor = 0;
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        char *end;
+        double time = strtod(line, &end);
+
+        if ((end == line) || (*end != ','))
+        {
+            continue;
+        }
+
+        uint8_t sample = (strtod(end + 1, NULL) >= 0.5) ? 1U : 0U;
+        if (first)
+        {
+            origin = time;
+            first = false;
+        }
+        last = time - origin;
+        if (sample != level)
+        {
+            level = sample;
+            wave->edges.push_back({ (uint64_t)(last * 1e9), level });
+        }
+    }
+    fclose(file);
+
+    wave->duration_ns = (uint64_t)(last * 1e9);
+    return wave->edges.size() >= 2U;
+}
+
+uint8_t Waveform_Level(Waveform_t *wave, uint64_t time_ns)
+{
+    const std::vector<Waveform_Edge_t> &edges = wave->edges;
+
+    if ((wave->cursor > 0U) && (edges[wave->cursor - 1U].time_ns > time_ns))
+    {
+        // Went back in time: a new run
+        wave->cursor = 0;
+    }
+    while ((wave->cursor < edges.size()) && (edges[wave->cursor].time_ns <= time_ns))
+    {
+        wave->cursor++;
+    }
+    return (wave->cursor > 0U) ? edges[wave->cursor - 1U].level : 0U;
+}
+
+/**
+  Section: Private Function Implementations
+*/
+
+static double Jitter(uint32_t *state)
+{
+    // xorshift32, uniform in -1 to 1
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return ((double)*state / 4294967295.0) * 2.0 - 1.0;
+}
+
+/**
+ End of File
+*/
@@ -0,0 +1,99 @@
+/**
+  PWM Input Waveforms Header File
+
+  @File Name
+    waveform.h
+
+  @Summary
+    Edge lists for the PWM input of the host model, synthetic or recorded
+
+  @Description
+    A waveform is the list of PWM_INPUT edges from power-up. Synthetic ones
+    are built from segments of constant frequency with optional duty sweep
+    and jitter; the jitter comes from a seeded generator, so the same
+    segments and seed always give the same edges. Recorded ones are loaded
+    from a logic analyzer CSV export.
+*/
+
+#ifndef WAVEFORM_H
+#define WAVEFORM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+  Section: Data Types Definitions
+*/
+
+typedef struct
+{
+    uint64_t time_ns;
+    uint8_t level;
+} Waveform_Edge_t;
+
+/* Part of a synthetic waveform */
+typedef struct
+{
+    double duration_ms;
+    double frequency;           /* Hz */
+    double duty_start;          /* %, swept linearly to duty_end over the segment */
+    double duty_end;
+    double period_jitter;       /* % of the period, uniform +- */
+    double duty_jitter;         /* Percentage points, uniform +- */
+} Waveform_Segment_t;
+
+typedef struct
+{
+    std::vector<Waveform_Edge_t> edges;    /* Rising and falling in turn, level 0 before the first */
+    uint64_t duration_ns;
+    size_t cursor;                          /* Last edge found by Waveform_Level() */
+} Waveform_t;
+
+/**
+  Section: Waveform APIs
+*/
+
+/**
+  @Summary
+    Builds a synthetic waveform
+
+  @Param
+    wave - filled with the edges
+    segments - one after the other from power-up
+    count - number of segments
+    seed - jitter generator seed, 0 is replaced by 1
+    start_low - input low at power-up for this long before the first
+                rising edge, 0 for high at power-up
+*/
+void Waveform_Synth(Waveform_t *wave, const Waveform_Segment_t *segments, size_t count,
+                    uint32_t seed, uint64_t start_low_ns);
+
+/**
+  @Summary
+    Loads a recorded waveform
+
+  @Description
+    One sample per line, "time,level" with the time in seconds, as logic
+    analyzer software exports it. Lines that do not start with a number,
+    like headers and comments, are skipped. Time is moved so the first
+    sample is at 0; only level changes are kept.
+
+  @Returns
+    false if the file cannot be read or has fewer than two edges
+*/
+bool Waveform_Load(Waveform_t *wave, const char *path);
+
+/**
+  @Summary
+    Input level at a time, for the PicModel_Input_t callback
+
+  @Description
+    Fast when the times only go forward, as they do during a run.
+*/
+uint8_t Waveform_Level(Waveform_t *wave, uint64_t time_ns);
+
+#endif /* WAVEFORM_H */
+/**
+ End of File
+*/
@@ -0,0 +1,188 @@
+/**
+  Host XC8 Device Header
+
+  @File Name
+    xc.h
+
+  @Summary
+    Stands in for the XC8 <xc.h> of the PIC10F322 when the firmware runs on a PC
+
+  @Description
+    Found before the compiler header through -Ihost. The firmware sources are
+    compiled as C++ so every SFR and bit field used by the drivers becomes an
+    object that calls the model in pic_model.cpp on each access, as the real
+    peripherals see it: a bit field write is a read-modify-write of its
+    register, and writing TMR0 clears the prescaler even when the value does
+    not change. Only the registers the firmware uses are declared.
+*/
+
+#ifndef XC_H
+#define XC_H
+
+#ifndef __cplusplus
+#error "Compile the firmware with g++ -x c++ for the host model"
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pic_model.h"
+
+/**
+  Section: Compiler Built-ins
+*/
+
+#define __delay_us(x) PicModel_Delay((uint32_t)((x) * (_XTAL_FREQ / 4000000UL)))
+#define __delay_ms(x) PicModel_Delay((uint32_t)((x) * (_XTAL_FREQ / 4000UL)))
+#define NOP() PicModel_Delay(1U)
+
+/**
+  Section: Register Access
+*/
+
+/* A whole register */
+template <PicSfr_t SFR>
+struct PicRegister
+{
+    operator uint8_t() const { return PicModel_Read(SFR); }
+    PicRegister &operator=(uint8_t value) { PicModel_Write(SFR, value); return *this; }
+    PicRegister &operator|=(uint8_t value) { PicModel_WriteBits(SFR, value, value); return *this; }
+    PicRegister &operator&=(uint8_t value) { PicModel_WriteBits(SFR, (uint8_t)~value, 0U); return *this; }
+    PicRegister &operator^=(uint8_t value) { PicModel_Write(SFR, (uint8_t)(PicModel_Read(SFR) ^ value)); return *this; }
+};
+
+/* WIDTH bits of a register starting at bit SHIFT */
+template <PicSfr_t SFR, uint8_t SHIFT, uint8_t WIDTH = 1U>
+struct PicBitField
+{
+    static const uint8_t MASK = (uint8_t)(((1U << WIDTH) - 1U) << SHIFT);
+
+    operator uint8_t() const { return (uint8_t)((PicModel_Read(SFR) & MASK) >> SHIFT); }
+    PicBitField &operator=(unsigned value) { PicModel_WriteBits(SFR, MASK, (uint8_t)(value << SHIFT)); return *this; }
+};
+
+/**
+  Section: Registers
+*/
+
+typedef struct
+{
+    PicBitField<PIC_PORTA, 0> RA0;
+    PicBitField<PIC_PORTA, 1> RA1;
+    PicBitField<PIC_PORTA, 2> RA2;
+    PicBitField<PIC_PORTA, 3> RA3;
+} PORTAbits_t;
+
+typedef struct
+{
+    PicBitField<PIC_LATA, 0> LATA0;
+    PicBitField<PIC_LATA, 1> LATA1;
+    PicBitField<PIC_LATA, 2> LATA2;
+} LATAbits_t;
+
+typedef struct
+{
+    PicBitField<PIC_TRISA, 0> TRISA0;
+    PicBitField<PIC_TRISA, 1> TRISA1;
+    PicBitField<PIC_TRISA, 2> TRISA2;
+} TRISAbits_t;
+
+typedef struct
+{
+    PicBitField<PIC_ANSELA, 0> ANSA0;
+    PicBitField<PIC_ANSELA, 1> ANSA1;
+    PicBitField<PIC_ANSELA, 2> ANSA2;
+} ANSELAbits_t;
+
+typedef struct
+{
+    PicBitField<PIC_WPUA, 0> WPUA0;
+    PicBitField<PIC_WPUA, 1> WPUA1;
+    PicBitField<PIC_WPUA, 2> WPUA2;
+    PicBitField<PIC_WPUA, 3> WPUA3;
+} WPUAbits_t;
+
+typedef struct
+{
+    PicBitField<PIC_OPTION_REG, 0, 3> PS;
+    PicBitField<PIC_OPTION_REG, 3> PSA;
+    PicBitField<PIC_OPTION_REG, 4> T0SE;
+    PicBitField<PIC_OPTION_REG, 5> T0CS;
+    PicBitField<PIC_OPTION_REG, 6> INTEDG;
+    PicBitField<PIC_OPTION_REG, 7> nWPUEN;
+} OPTION_REGbits_t;
+
+typedef struct
+{
+    PicBitField<PIC_INTCON, 0> IOCIF;
+    PicBitField<PIC_INTCON, 1> INTF;
+    PicBitField<PIC_INTCON, 2> TMR0IF;
+    PicBitField<PIC_INTCON, 3> IOCIE;
+    PicBitField<PIC_INTCON, 4> INTE;
+    PicBitField<PIC_INTCON, 5> TMR0IE;
+    PicBitField<PIC_INTCON, 6> PEIE;
+    PicBitField<PIC_INTCON, 7> GIE;
+} INTCONbits_t;
+
+typedef struct
+{
+    PicBitField<PIC_ADCON, 0> ADON;
+    PicBitField<PIC_ADCON, 1> GO_nDONE;
+    PicBitField<PIC_ADCON, 2, 3> CHS;
+    PicBitField<PIC_ADCON, 5, 3> ADCS;
+} ADCONbits_t;
+
+typedef struct
+{
+    PicBitField<PIC_PMCON1, 0> RD;
+    PicBitField<PIC_PMCON1, 1> WR;
+    PicBitField<PIC_PMCON1, 2> WREN;
+    PicBitField<PIC_PMCON1, 3> WRERR;
+    PicBitField<PIC_PMCON1, 4> FREE;
+    PicBitField<PIC_PMCON1, 5> LWLO;
+    PicBitField<PIC_PMCON1, 6> CFGS;
+} PMCON1bits_t;
+
+extern PicRegister<PIC_PORTA> PORTA;
+extern PicRegister<PIC_LATA> LATA;
+extern PicRegister<PIC_TRISA> TRISA;
+extern PicRegister<PIC_ANSELA> ANSELA;
+extern PicRegister<PIC_WPUA> WPUA;
+extern PicRegister<PIC_OPTION_REG> OPTION_REG;
+extern PicRegister<PIC_TMR0> TMR0;
+extern PicRegister<PIC_INTCON> INTCON;
+extern PicRegister<PIC_ADCON> ADCON;
+extern PicRegister<PIC_ADRES> ADRES;
+extern PicRegister<PIC_PMADRL> PMADRL;
+extern PicRegister<PIC_PMADRH> PMADRH;
+extern PicRegister<PIC_PMDATL> PMDATL;
+extern PicRegister<PIC_PMDATH> PMDATH;
+extern PicRegister<PIC_PMCON1> PMCON1;
+extern PicRegister<PIC_PMCON2> PMCON2;
+extern PicRegister<PIC_OSCCON> OSCCON;
+extern PicRegister<PIC_CLKRCON> CLKRCON;
+extern PicRegister<PIC_BORCON> BORCON;
+extern PicRegister<PIC_WDTCON> WDTCON;
+
+extern PORTAbits_t PORTAbits;
+extern LATAbits_t LATAbits;
+extern TRISAbits_t TRISAbits;
+extern ANSELAbits_t ANSELAbits;
+extern WPUAbits_t WPUAbits;
+extern OPTION_REGbits_t OPTION_REGbits;
+extern INTCONbits_t INTCONbits;
+extern ADCONbits_t ADCONbits;
+extern PMCON1bits_t PMCON1bits;
+
+/**
+  Section: Unused MCC Helpers
+*/
+
+/* Called only by the generated FLASH_WriteWord(), which the firmware never
+   uses. XC8 drops it; the host build links with --gc-sections to do the same. */
+uint16_t FLASH_ReadWord(uint16_t flashAddr);
+int8_t FLASH_WriteBlock(uint16_t writeAddr, uint16_t *flashWordArray);
+
+#endif /* XC_H */
+/**
+ End of File
+*/
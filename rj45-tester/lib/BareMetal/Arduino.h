@@ -0,0 +1,112 @@
+#ifndef BAREMETAL_ARDUINO_H
+#define BAREMETAL_ARDUINO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <ch32v00x.h>
+
+/**
+ * @file Arduino.h
+ * @brief Register-level stand-in for the Arduino core subset the tester uses
+ * @details Only built in the bare-metal environment (framework = noneos-sdk),
+ *          the Arduino environment ignores this library. BareMetal.cpp owns
+ *          main(): it starts the 1 ms SysTick and then calls setup() and loop()
+ *          like the Arduino core, without its HAL init, heap or interrupt
+ *          driven Serial.
+ */
+
+// Configuration constants
+#define BAREMETAL_TICK_HZ           1000U  /**< SysTick interrupt rate, millis() resolution */
+
+#define HIGH                        1U
+#define LOW                         0U
+#define INPUT                       0U
+#define OUTPUT                      1U
+#define DEC                         10
+#define HEX                         16
+
+/**
+ * @brief Pin numbers, port in the high nibble (A = 0, C = 2, D = 3), pin in the low nibble
+ */
+enum
+{
+    PA1 = 0x01, PA2 = 0x02,
+    PC0 = 0x20, PC1, PC2, PC3, PC4, PC5, PC6, PC7,
+    PD0 = 0x30, PD1, PD2, PD3, PD4, PD5, PD6, PD7
+};
+
+// Public API functions
+
+/**
+ * @brief Milliseconds since main() started
+ */
+uint32_t millis(void);
+
+/**
+ * @brief Microseconds since main() started, wraps after about 71 minutes
+ */
+uint32_t micros(void);
+
+/**
+ * @brief Configure one pin as push-pull output or floating input
+ */
+void pinMode(uint8_t pin, uint8_t mode);
+
+/**
+ * @brief Set one output pin with a single BSHR write
+ */
+void digitalWrite(uint8_t pin, uint8_t value);
+
+/**
+ * @brief Polled USART1 driver with the Serial calls used by the tester
+ * @details Writes wait for TXE like the Arduino core, reads return the single
+ *          byte held by the UART data register. Only the PD0/PD1 remap is
+ *          supported.
+ */
+class BareSerial
+{
+public:
+    void setTx(uint8_t pin) { (void)pin; }
+    void setRx(uint8_t pin) { (void)pin; }
+    void begin(uint32_t baud);
+    int available(void);
+    int read(void);
+    size_t write(uint8_t value);
+
+    size_t print(const char* text);
+    size_t print(char value) { return write((uint8_t)value); }
+
+    /**
+     * @brief Print any integer type in base 10 or 16
+     */
+    template <typename T>
+    size_t print(T value, int base = DEC)
+    {
+        // (T)-1 < 0 only for signed types
+        if (((T)-1 < (T)0) && (value < (T)0))
+        {
+            return write('-') + printNumber((uint32_t)(0U - (uint32_t)value), (uint8_t)base);
+        }
+        return printNumber((uint32_t)value, (uint8_t)base);
+    }
+
+    size_t println(void) { return print("\r\n"); }
+
+    template <typename T>
+    size_t println(T value) { return print(value) + println(); }
+
+    template <typename T>
+    size_t println(T value, int base) { return print(value, base) + println(); }
+
+private:
+    size_t printNumber(uint32_t value, uint8_t base);
+};
+
+extern BareSerial Serial;
+
+// Provided by the sketch
+void setup(void);
+void loop(void);
+
+#endif /* BAREMETAL_ARDUINO_H */
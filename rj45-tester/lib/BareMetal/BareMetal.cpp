@@ -0,0 +1,160 @@
+#include "Arduino.h"
+#include "Board.h"
+#include "BoardHal.h"
+
+// Private constants
+#define BAREMETAL_AFIO_USART1_RM     (1UL << 2)  /**< USART1 remap bit 0 */
+#define BAREMETAL_AFIO_USART1_RM1    (1UL << 21) /**< USART1 remap bit 1 */
+
+BareSerial Serial;
+
+// Private variables
+static volatile uint32_t tick_ms = 0U;
+static GPIO_TypeDef* const gpio_ports[4] = { GPIOA, NULL, GPIOC, GPIOD };
+static const uint8_t board_ports[4] = { BOARD_PORT_A, 0U, BOARD_PORT_C, BOARD_PORT_D }; /**< Board.h port index */
+static const BoardPin_t serial_tx_pin = { BOARD_PORT_D, 0U };
+static const BoardPin_t serial_rx_pin = { BOARD_PORT_D, 1U };
+
+// Private function prototypes
+extern "C" void SysTick_Handler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
+static void StartTick(void);
+
+// Public API Implementation
+
+int main(void)
+{
+    // SystemInit() already ran from the startup code: 48 MHz from HSI with PLL
+    StartTick();
+    setup();
+
+    for (;;)
+    {
+        loop();
+    }
+}
+
+uint32_t millis(void)
+{
+    return tick_ms;
+}
+
+uint32_t micros(void)
+{
+    uint32_t ms;
+    uint32_t count;
+
+    // Reread if the tick interrupt hit in between
+    do
+    {
+        ms = tick_ms;
+        count = SysTick->CNT;
+    } while (ms != tick_ms);
+
+    return (ms * 1000U) + (count / (SystemCoreClock / 1000000U));
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    BoardPin_t board_pin = { board_ports[pin >> 4], (uint8_t)(pin & 0x07U) };
+    uint32_t cfg = (mode == OUTPUT) ? BOARD_GPIO_CFG_OUTPUT_PP : BOARD_GPIO_CFG_INPUT_FLOAT;
+
+    RCC->APB2PCENR |= RCC_APB2Periph_GPIOA | RCC_APB2Periph_GPIOC | RCC_APB2Periph_GPIOD;
+    BoardHal_ConfigurePin(&board_pin, cfg);
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    uint32_t bit = 1UL << (pin & 0x07U);
+    gpio_ports[pin >> 4]->BSHR = (value != LOW) ? bit : (bit << 16);
+}
+
+void BareSerial::begin(uint32_t baud)
+{
+    RCC->APB2PCENR |= RCC_APB2Periph_GPIOD | RCC_APB2Periph_AFIO | RCC_APB2Periph_USART1;
+
+    // Partial remap 1: TX on PD0, RX on PD1
+    AFIO->PCFR1 = (AFIO->PCFR1 & ~(BAREMETAL_AFIO_USART1_RM | BAREMETAL_AFIO_USART1_RM1)) | BAREMETAL_AFIO_USART1_RM;
+    BoardHal_ConfigurePin(&serial_tx_pin, BOARD_GPIO_CFG_AF_PP);
+    BoardHal_ConfigurePin(&serial_rx_pin, BOARD_GPIO_CFG_INPUT_FLOAT);
+
+    USART1->BRR = (SystemCoreClock + (baud / 2U)) / baud;
+    USART1->CTLR1 = USART_CTLR1_UE | USART_CTLR1_TE | USART_CTLR1_RE;
+}
+
+int BareSerial::available(void)
+{
+    return ((USART1->STATR & USART_FLAG_RXNE) != 0U) ? 1 : 0;
+}
+
+int BareSerial::read(void)
+{
+    if ((USART1->STATR & USART_FLAG_RXNE) == 0U)
+    {
+        return -1;
+    }
+    return (int)(USART1->DATAR & 0xFFU);
+}
+
+size_t BareSerial::write(uint8_t value)
+{
+    while ((USART1->STATR & USART_FLAG_TXE) == 0U)
+    {
+    }
+    USART1->DATAR = value;
+    return 1U;
+}
+
+size_t BareSerial::print(const char* text)
+{
+    size_t count = 0U;
+    while (*text != '\0')
+    {
+        count += write((uint8_t)*text++);
+    }
+    return count;
+}
+
+size_t BareSerial::printNumber(uint32_t value, uint8_t base)
+{
+    char digits[11];
+    uint8_t length = 0U;
+
+    if ((base != 16U) && (base != 10U))
+    {
+        base = 10U;
+    }
+
+    do
+    {
+        uint8_t digit = (uint8_t)(value % base);
+        digits[length++] = (char)((digit < 10U) ? ('0' + digit) : ('A' + digit - 10U));
+        value /= base;
+    } while (value != 0U);
+
+    size_t count = 0U;
+    while (length > 0U)
+    {
+        count += write((uint8_t)digits[--length]);
+    }
+    return count;
+}
+
+// Private function implementations
+
+static void StartTick(void)
+{
+    // HCLK clock, auto reload at the compare value, interrupt on every match
+    SysTick->CTLR = 0U;
+    SysTick->SR = 0U;
+    SysTick->CNT = 0U;
+    SysTick->CMP = (SystemCoreClock / BAREMETAL_TICK_HZ) - 1U;
+    SysTick->CTLR = BOARD_SYSTICK_STE | BOARD_SYSTICK_STIE | BOARD_SYSTICK_STCLK | BOARD_SYSTICK_STRE;
+
+    NVIC_EnableIRQ(SysTicK_IRQn);
+}
+
+void SysTick_Handler(void)
+{
+    SysTick->SR = 0U;
+    tick_ms++;
+}
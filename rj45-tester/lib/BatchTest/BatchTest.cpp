@@ -0,0 +1,182 @@
+#include "BatchTest.h"
+
+// Private function prototypes
+static uint8_t IsEmpty(const WireMap_t* map);
+static void Latch(BatchTest_t* batch, WireClass_t verdict, uint8_t stable, uint32_t now_ms);
+
+// Public API Implementation
+
+void BatchTest_Reset(BatchTest_t* batch, WireClass_t expected)
+{
+    batch->state = BATCHTEST_WAITING;
+    batch->expected = expected;
+    batch->verdict = WIRECLASS_NO_CABLE;
+    batch->stable_count = 0U;
+    batch->insert_ms = 0U;
+    batch->verdict_ms = 0U;
+    batch->first_insert_ms = 0U;
+    batch->tested = 0U;
+    batch->passed = 0U;
+    batch->failed = 0U;
+    batch->ttv_next = 0U;
+
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        batch->candidate.rows[i] = 0U;
+    }
+}
+
+uint8_t BatchTest_Update(BatchTest_t* batch, const WireMap_t* map, WireClass_t verdict, uint32_t now_ms)
+{
+    uint8_t empty = IsEmpty(map);
+
+    switch (batch->state)
+    {
+        case BATCHTEST_WAITING:
+            if (!empty)
+            {
+                batch->insert_ms = now_ms;
+                if (batch->tested == 0U)
+                {
+                    batch->first_insert_ms = now_ms;
+                }
+                batch->candidate = *map;
+                batch->stable_count = 1U;
+                batch->state = BATCHTEST_CONFIRMING;
+            }
+            break;
+
+        case BATCHTEST_CONFIRMING:
+            if (empty)
+            {
+                // Pulled out before a verdict, not counted
+                batch->state = BATCHTEST_WAITING;
+            }
+            else if (WireMap_IsEqual(map, &batch->candidate))
+            {
+                batch->stable_count++;
+                if (batch->stable_count >= BATCHTEST_CONFIRM_SCANS)
+                {
+                    Latch(batch, verdict, 1U, now_ms);
+                    return 1U;
+                }
+            }
+            else
+            {
+                // Contacts still settling, restart the confirmation
+                batch->candidate = *map;
+                batch->stable_count = 1U;
+            }
+
+            if ((batch->state == BATCHTEST_CONFIRMING) &&
+                ((now_ms - batch->insert_ms) >= BATCHTEST_CONFIRM_TIMEOUT_MS))
+            {
+                // Never settles: intermittent contact, a failure whatever the verdict
+                Latch(batch, verdict, 0U, now_ms);
+                return 1U;
+            }
+            break;
+
+        default:
+            // Verdict latched until the cable has been out for a few scans
+            if (empty)
+            {
+                batch->stable_count++;
+                if (batch->stable_count >= BATCHTEST_REMOVE_SCANS)
+                {
+                    batch->state = BATCHTEST_WAITING;
+                }
+            }
+            else
+            {
+                batch->stable_count = 0U;
+            }
+            break;
+    }
+
+    return 0U;
+}
+
+uint32_t BatchTest_GetCablesPerHour(const BatchTest_t* batch)
+{
+    // In tenths of a second, keeps tested * 36000 within 32 bits
+    uint32_t elapsed_ds = (batch->verdict_ms - batch->first_insert_ms) / 100U;
+
+    if ((batch->tested == 0U) || (elapsed_ds == 0U))
+    {
+        return 0U;
+    }
+
+    return ((uint32_t)batch->tested * 36000UL) / elapsed_ds;
+}
+
+uint16_t BatchTest_GetMedianTimeToVerdict(const BatchTest_t* batch)
+{
+    uint16_t sorted[BATCHTEST_HISTORY_SIZE];
+    uint8_t count = (batch->tested < BATCHTEST_HISTORY_SIZE) ? (uint8_t)batch->tested : BATCHTEST_HISTORY_SIZE;
+
+    if (count == 0U)
+    {
+        return 0U;
+    }
+
+    // Insertion sort, at most 32 entries and only called for a report
+    for (uint8_t i = 0U; i < count; i++)
+    {
+        uint16_t value = batch->ttv_ms[i];
+        uint8_t j = i;
+        while ((j > 0U) && (sorted[j - 1U] > value))
+        {
+            sorted[j] = sorted[j - 1U];
+            j--;
+        }
+        sorted[j] = value;
+    }
+
+    if ((count & 1U) != 0U)
+    {
+        return sorted[count / 2U];
+    }
+
+    return (uint16_t)(((uint32_t)sorted[(count / 2U) - 1U] + sorted[count / 2U]) / 2U);
+}
+
+// Private function implementations
+
+static uint8_t IsEmpty(const WireMap_t* map)
+{
+    uint8_t any = 0U;
+
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        any |= map->rows[i];
+    }
+
+    return (any == 0U) ? 1U : 0U;
+}
+
+static void Latch(BatchTest_t* batch, WireClass_t verdict, uint8_t stable, uint32_t now_ms)
+{
+    uint32_t ttv = now_ms - batch->insert_ms;
+
+    batch->verdict = verdict;
+    batch->verdict_ms = now_ms;
+    batch->state = (stable && (verdict == batch->expected)) ? BATCHTEST_PASSED : BATCHTEST_FAILED;
+    batch->stable_count = 0U;
+
+    if (batch->tested < UINT16_MAX)
+    {
+        batch->tested++;
+        if (batch->state == BATCHTEST_PASSED)
+        {
+            batch->passed++;
+        }
+        else
+        {
+            batch->failed++;
+        }
+    }
+
+    batch->ttv_ms[batch->ttv_next] = (ttv > UINT16_MAX) ? UINT16_MAX : (uint16_t)ttv;
+    batch->ttv_next = (uint8_t)((batch->ttv_next + 1U) % BATCHTEST_HISTORY_SIZE);
+}
@@ -0,0 +1,82 @@
+#ifndef BATCHTEST_H
+#define BATCHTEST_H
+
+#include <stdint.h>
+#include "WireClass.h"
+#include "WireMap.h"
+
+// Configuration constants
+#define BATCHTEST_CONFIRM_SCANS     5U     /**< Identical scans needed before a verdict */
+#define BATCHTEST_REMOVE_SCANS      3U     /**< Empty scans needed to accept a removal */
+#define BATCHTEST_CONFIRM_TIMEOUT_MS 1000U /**< A cable that never settles fails after this time */
+#define BATCHTEST_HISTORY_SIZE      32U    /**< Times-to-verdict kept for the median */
+
+// Type definitions
+/**
+ * @brief Batch test state of the cable in the jacks
+ */
+typedef enum
+{
+    BATCHTEST_WAITING = 0,       /**< No cable, waiting for insertion */
+    BATCHTEST_CONFIRMING,        /**< Cable inserted, waiting for stable scans */
+    BATCHTEST_PASSED,            /**< Verdict latched until the cable is removed */
+    BATCHTEST_FAILED             /**< Verdict latched until the cable is removed, also for a cable that never settled */
+} BatchTestState_t;
+
+/**
+ * @brief Batch test session
+ * @details Fed with every scan. Insertion is detected from the first contact,
+ *          the verdict is taken after BATCHTEST_CONFIRM_SCANS identical scans
+ *          and kept until the cable has been out for BATCHTEST_REMOVE_SCANS.
+ */
+typedef struct
+{
+    BatchTestState_t state;      /**< State of the current cable */
+    WireClass_t expected;        /**< Verdict a good cable must have */
+    WireClass_t verdict;         /**< Verdict of the current or last cable */
+    WireMap_t candidate;         /**< Scan being confirmed */
+    uint8_t stable_count;        /**< Consecutive scans equal to candidate, or empty scans when latched */
+    uint32_t insert_ms;          /**< First contact of the current cable */
+    uint32_t verdict_ms;         /**< Verdict time of the current or last cable */
+    uint32_t first_insert_ms;    /**< First contact of the session, for the throughput */
+    uint16_t tested;             /**< Cables with a verdict */
+    uint16_t passed;             /**< Cables that passed */
+    uint16_t failed;             /**< Cables that failed */
+    uint16_t ttv_ms[BATCHTEST_HISTORY_SIZE]; /**< Latest times from insertion to verdict */
+    uint8_t ttv_next;            /**< Next history slot to write */
+} BatchTest_t;
+
+// Public API functions
+
+/**
+ * @brief Start a new session, all counters cleared
+ * @param batch Pointer to session
+ * @param expected Verdict a good cable must have, e.g. WIRECLASS_STRAIGHT
+ */
+void BatchTest_Reset(BatchTest_t* batch, WireClass_t expected);
+
+/**
+ * @brief Feed one scan
+ * @param batch Pointer to session
+ * @param map Scanned matrix
+ * @param verdict Classification of the same scan
+ * @param now_ms Scan time in milliseconds
+ * @return uint8_t 1 when this scan latched a new verdict, 0 otherwise
+ */
+uint8_t BatchTest_Update(BatchTest_t* batch, const WireMap_t* map, WireClass_t verdict, uint32_t now_ms);
+
+/**
+ * @brief Get session throughput
+ * @param batch Pointer to session
+ * @return uint32_t Cables tested per hour since the first insertion, 0 before the first verdict
+ */
+uint32_t BatchTest_GetCablesPerHour(const BatchTest_t* batch);
+
+/**
+ * @brief Get median time from insertion to verdict
+ * @param batch Pointer to session
+ * @return uint16_t Median of the last BATCHTEST_HISTORY_SIZE cables in ms, 0 before the first verdict
+ */
+uint16_t BatchTest_GetMedianTimeToVerdict(const BatchTest_t* batch);
+
+#endif /* BATCHTEST_H */
@@ -0,0 +1,112 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <stdint.h>
+#include <ch32v00x.h>
+
+/**
+ * @file Board.h
+ * @brief Pin assignment of the RJ45 tester board (CH32V003F4P6)
+ * @details Conductor N is RJ45 pin N + 1. The near jack is driven through the
+ *          LED pins, the far jack is read back on the sense pins.
+ *          PD7 is only usable as sense line with NRST disabled in the user
+ *          option bytes. USART1 is remapped to PD0 (TX) / PD1 (RX) to keep
+ *          PD5 free for sensing. PD1 is also SWIO: the debug interface stays
+ *          enabled, and the serial adapter's TX must be disconnected from PD1
+ *          while programming (README: Programming over SWIO). Every GPIO is
+ *          used, so RX has no other pin to move to.
+ */
+
+#define BOARD_CONDUCTOR_COUNT       8U     /**< Conductors in an RJ45 cable */
+
+// GPIO ports used by the board, index into BOARD_GPIO_PORTS
+#define BOARD_PORT_A                0U
+#define BOARD_PORT_C                1U
+#define BOARD_PORT_D                2U
+#define BOARD_PORT_COUNT            3U
+#define BOARD_GPIO_PORTS            { GPIOA, GPIOC, GPIOD }
+
+/**
+ * @brief GPIO pin location
+ * @details Plain numbers so pin tables can be evaluated at compile time
+ */
+typedef struct
+{
+    uint8_t port;                /**< Port index (BOARD_PORT_A, BOARD_PORT_C or BOARD_PORT_D) */
+    uint8_t pin;                 /**< Pin number within the port (0-7) */
+} BoardPin_t;
+
+// Near jack drive lines, also the LED lines
+#define BOARD_DRIVE_PINS                                                    \
+    {                                                                       \
+        { BOARD_PORT_C, 4U }, /* Conductor 0 - RJ45 pin 1 - White-Orange */ \
+        { BOARD_PORT_C, 3U }, /* Conductor 1 - RJ45 pin 2 - Orange */       \
+        { BOARD_PORT_C, 2U }, /* Conductor 2 - RJ45 pin 3 - White-Green */  \
+        { BOARD_PORT_C, 1U }, /* Conductor 3 - RJ45 pin 4 - Blue */         \
+        { BOARD_PORT_C, 0U }, /* Conductor 4 - RJ45 pin 5 - White-Blue */   \
+        { BOARD_PORT_A, 2U }, /* Conductor 5 - RJ45 pin 6 - Green */        \
+        { BOARD_PORT_A, 1U }, /* Conductor 6 - RJ45 pin 7 - White-Brown */  \
+        { BOARD_PORT_D, 6U }  /* Conductor 7 - RJ45 pin 8 - Brown */        \
+    }
+
+// Far jack sense lines: conductor 0 PC5, 1-4 PD2-PD5, 5-6 PC6-PC7, 7 PD7
+#define BOARD_SENSE_PORTC_MASK      0xE0U  /**< PC5, PC6, PC7 */
+#define BOARD_SENSE_PORTD_MASK      0xBCU  /**< PD2, PD3, PD4, PD5, PD7 */
+
+// Far jack sense lines as a table, for code that handles one conductor at a time
+#define BOARD_SENSE_PINS                                                    \
+    {                                                                       \
+        { BOARD_PORT_C, 5U }, { BOARD_PORT_D, 2U }, { BOARD_PORT_D, 3U },   \
+        { BOARD_PORT_D, 4U }, { BOARD_PORT_D, 5U }, { BOARD_PORT_C, 6U },   \
+        { BOARD_PORT_C, 7U }, { BOARD_PORT_D, 7U }                          \
+    }
+
+// ADC channel of each conductor: every conductor has an ADC pin at exactly one jack
+#define BOARD_ADC_CHANNELS          { 2U, 3U, 4U, 7U, 5U, 0U, 1U, 6U } /**< PC4 A2, PD2 A3, PD3 A4, PD4 A7, PD5 A5, PA2 A0, PA1 A1, PD6 A6 */
+#define BOARD_ADC_NEAR_MASK         0xE1U  /**< Conductors 0, 5, 6, 7 are read at the near jack, the others at the far jack */
+#define BOARD_ADC_VREF_CHANNEL      8U     /**< Internal 1.2 V reference */
+
+/**
+ * @brief Pack port C and port D input registers into a conductor bitmask
+ * @details Bit N of the result is the far-end level of conductor N
+ */
+#define BOARD_SENSE_PACK(portc, portd)          \
+    ((uint8_t)((((portc) >> 5) & 0x01U) |      \
+               (((portd) >> 1) & 0x1EU) |      \
+               (((portc) >> 1) & 0x60U) |      \
+               ((portd) & 0x80U)))
+
+// Sense lines that wake the tester from standby, one per EXTI line. PC5 and PD7
+// share EXTI5 and EXTI7 with PD5 and PC7, so conductors 0 and 7 cannot wake it.
+#define BOARD_WAKE_PORTC_MASK       0xC0U  /**< PC6, PC7: conductors 5, 6 */
+#define BOARD_WAKE_PORTD_MASK       0x3CU  /**< PD2-PD5: conductors 1-4 */
+#define BOARD_WAKE_SERIAL_MASK      0x02U  /**< PD1, USART1 RX: the start bit of a character */
+
+/**
+ * Patch panel front end (RJ45_PANEL builds), fitted instead of the far jack
+ * SPI1 shifts one byte per panel port through two chains of equal length:
+ * - PC6 MOSI into 74HC595 drive registers, the first byte sent ends in the
+ *   register of port 0 at the far end of the chain. Outputs QA-QH drive
+ *   conductors 0-7 of the port's near jack through diodes, so undriven
+ *   conductors float like the released GPIO drive lines.
+ * - PC7 MISO from 74HC165 sense registers, port 0's register shifts out first.
+ *   Inputs A-H read conductors 0-7 of the port's far side, pulled down.
+ * - PC5 SCK to both chains, PD2 to all 595 RCLK, PD3 to all 165 SH/LD.
+ */
+#define BOARD_PANEL_LATCH_PIN       { BOARD_PORT_D, 2U }  /**< 74HC595 RCLK, rising edge latches */
+#define BOARD_PANEL_LOAD_PIN        { BOARD_PORT_D, 3U }  /**< 74HC165 SH/LD, low captures the inputs */
+
+// GPIO configuration nibbles (CNF[1:0] MODE[1:0]) for CFGLR
+#define BOARD_GPIO_CFG_INPUT_PULL   0x8U   /**< Input with pull-up/down selected by OUTDR */
+#define BOARD_GPIO_CFG_OUTPUT_PP    0x3U   /**< Push-pull output, 30 MHz */
+#define BOARD_GPIO_CFG_INPUT_FLOAT  0x4U   /**< Floating input */
+#define BOARD_GPIO_CFG_AF_PP        0xBU   /**< Alternate function push-pull, 30 MHz */
+#define BOARD_GPIO_CFG_ANALOG       0x0U   /**< Analog input, no pull */
+
+// SysTick CTLR bits
+#define BOARD_SYSTICK_STE           (1UL << 0) /**< Counter enable */
+#define BOARD_SYSTICK_STIE          (1UL << 1) /**< Compare match interrupt enable */
+#define BOARD_SYSTICK_STCLK         (1UL << 2) /**< Count HCLK instead of HCLK/8 */
+#define BOARD_SYSTICK_STRE          (1UL << 3) /**< Restart from 0 on compare match */
+
+#endif /* BOARD_H */
@@ -0,0 +1,77 @@
+#include "BoardHal.h"
+
+// Private variables
+static GPIO_TypeDef* const gpio_ports[BOARD_PORT_COUNT] = BOARD_GPIO_PORTS;
+
+// Public API Implementation
+
+void BoardHal_ConfigurePin(const BoardPin_t* pin, uint32_t cfg)
+{
+    GPIO_TypeDef* port = gpio_ports[pin->port];
+    uint32_t shift = (uint32_t)pin->pin * 4U;
+
+    port->CFGLR = (port->CFGLR & ~(0xFUL << shift)) | (cfg << shift);
+}
+
+void BoardHal_ConfigurePort(uint8_t port, uint8_t pin_mask, uint32_t cfg)
+{
+    uint32_t cfg_mask = 0U;
+
+    for (uint8_t pin = 0U; pin < 8U; pin++)
+    {
+        if (pin_mask & (1U << pin))
+        {
+            cfg_mask |= (0xFUL << (pin * 4U));
+        }
+    }
+
+    // The nibble repeated in every selected position
+    gpio_ports[port]->CFGLR = (gpio_ports[port]->CFGLR & ~cfg_mask) | ((cfg * 0x11111111UL) & cfg_mask);
+}
+
+void BoardHal_SaveJack(BoardJackState_t* state, const BoardPin_t pins[BOARD_CONDUCTOR_COUNT])
+{
+    for (uint8_t p = 0U; p < BOARD_PORT_COUNT; p++)
+    {
+        state->cfg_mask[p] = 0U;
+        state->out_mask[p] = 0U;
+    }
+    for (uint8_t i = 0U; i < BOARD_CONDUCTOR_COUNT; i++)
+    {
+        state->cfg_mask[pins[i].port] |= (0xFUL << ((uint32_t)pins[i].pin * 4U));
+        state->out_mask[pins[i].port] |= (1UL << pins[i].pin);
+    }
+
+    for (uint8_t p = 0U; p < BOARD_PORT_COUNT; p++)
+    {
+        state->cfglr[p] = gpio_ports[p]->CFGLR;
+        state->outdr[p] = gpio_ports[p]->OUTDR;
+    }
+}
+
+void BoardHal_SetJack(const BoardJackState_t* state, uint32_t cfg)
+{
+    for (uint8_t p = 0U; p < BOARD_PORT_COUNT; p++)
+    {
+        GPIO_TypeDef* port = gpio_ports[p];
+
+        port->BCR = state->out_mask[p];
+        port->CFGLR = (port->CFGLR & ~state->cfg_mask[p]) | ((cfg * 0x11111111UL) & state->cfg_mask[p]);
+    }
+}
+
+void BoardHal_RestoreJack(const BoardJackState_t* state)
+{
+    for (uint8_t p = 0U; p < BOARD_PORT_COUNT; p++)
+    {
+        GPIO_TypeDef* port = gpio_ports[p];
+
+        port->BSHR = (state->outdr[p] & state->out_mask[p]) | ((~state->outdr[p] & state->out_mask[p]) << 16);
+        port->CFGLR = (port->CFGLR & ~state->cfg_mask[p]) | (state->cfglr[p] & state->cfg_mask[p]);
+    }
+}
+
+uint32_t BoardHal_SysTickDivider(void)
+{
+    return ((SysTick->CTLR & BOARD_SYSTICK_STCLK) != 0U) ? 1U : 8U;
+}
@@ -0,0 +1,90 @@
+#ifndef BOARDHAL_H
+#define BOARDHAL_H
+
+#include <stdint.h>
+#include "Board.h"
+
+/**
+ * @file BoardHal.h
+ * @brief GPIO and SysTick access shared by the HALs of the tester board
+ * @details Pin modes are set one CFGLR nibble at a time, so pins that belong
+ *          to other modules keep theirs. A HAL that borrows the lines of a
+ *          jack saves them first and restores exactly those lines after.
+ */
+
+// Type definitions
+/**
+ * @brief Saved configuration of the lines of one jack
+ */
+typedef struct
+{
+    uint32_t cfg_mask[BOARD_PORT_COUNT]; /**< CFGLR nibbles of the jack lines on each port */
+    uint32_t out_mask[BOARD_PORT_COUNT]; /**< OUTDR bits of the jack lines on each port */
+    uint32_t cfglr[BOARD_PORT_COUNT];    /**< CFGLR when saved */
+    uint32_t outdr[BOARD_PORT_COUNT];    /**< OUTDR when saved */
+} BoardJackState_t;
+
+// Public API functions
+
+/**
+ * @brief Set the mode of one pin
+ * @param pin Pin to configure
+ * @param cfg Configuration nibble, BOARD_GPIO_CFG_*
+ */
+void BoardHal_ConfigurePin(const BoardPin_t* pin, uint32_t cfg);
+
+/**
+ * @brief Set the mode of several pins of one port
+ * @param port Port index (BOARD_PORT_A, BOARD_PORT_C or BOARD_PORT_D)
+ * @param pin_mask Pins to configure, bit N for pin N
+ * @param cfg Configuration nibble, BOARD_GPIO_CFG_*
+ */
+void BoardHal_ConfigurePort(uint8_t port, uint8_t pin_mask, uint32_t cfg);
+
+/**
+ * @brief Save the mode and output level of the lines of one jack
+ * @param state Saved state to fill
+ * @param pins The jack's pin table, BOARD_DRIVE_PINS or BOARD_SENSE_PINS
+ */
+void BoardHal_SaveJack(BoardJackState_t* state, const BoardPin_t pins[BOARD_CONDUCTOR_COUNT]);
+
+/**
+ * @brief Set all lines of a saved jack to one mode with the output level low
+ * @details The level is cleared first: an output starts low, an input
+ *          with BOARD_GPIO_CFG_INPUT_PULL pulls down.
+ * @param state Jack saved with BoardHal_SaveJack()
+ * @param cfg Configuration nibble, BOARD_GPIO_CFG_*
+ */
+void BoardHal_SetJack(const BoardJackState_t* state, uint32_t cfg);
+
+/**
+ * @brief Restore the lines of a saved jack, other pins are left alone
+ * @details Output levels are restored before the modes, so a line that
+ *          goes back to an output never glitches to the wrong level.
+ * @param state Jack saved with BoardHal_SaveJack()
+ */
+void BoardHal_RestoreJack(const BoardJackState_t* state);
+
+/**
+ * @brief HCLK cycles per SysTick count
+ * @return uint32_t 1 with STCLK set, 8 otherwise
+ */
+uint32_t BoardHal_SysTickDivider(void);
+
+/**
+ * @brief SysTick counts since the last call, across the wrap at CMP
+ * @details Add up the results of successive calls to time more than one
+ *          reload period. Inline, it runs inside polling loops.
+ * @param last Count of the previous call, updated to the current count
+ * @return uint32_t Counts since *last
+ */
+static inline uint32_t BoardHal_SysTickElapsed(uint32_t* last)
+{
+    uint32_t now = SysTick->CNT;
+    uint32_t elapsed = (now >= *last) ? (now - *last) : (now + SysTick->CMP + 1U - *last);
+
+    *last = now;
+    return elapsed;
+}
+
+#endif /* BOARDHAL_H */
@@ -0,0 +1,149 @@
+#include "CableRc.h"
+#include "CableRcHal.h"
+
+// Private constants
+#define CABLERC_NS_PER_PF_X100      ((CABLERC_PULLUP_OHMS / 1000UL) * CABLERC_CHARGE_LN_X1000 / 10UL)
+
+// Private variables
+// Typical conductor-to-all-others capacitance per metre, replaced by CableRc_Calibrate()
+static uint16_t pf_per_m[CABLERC_CATEGORY_COUNT] = {
+    100U, // CABLERC_CAT5E
+    95U,  // CABLERC_CAT6
+    90U   // CABLERC_CAT6A
+};
+static uint32_t zero_ns[CABLERC_CONDUCTOR_COUNT];
+
+// Private function prototypes
+static uint16_t MedianOf(const uint16_t* values, uint8_t valid_mask);
+
+// Public API Implementation
+
+void CableRc_Measure(CableRcCategory_t category, CableRcResult_t* result)
+{
+    uint32_t time_ns[CABLERC_CONDUCTOR_COUNT];
+
+    CableRcHal_Measure(time_ns);
+    CableRc_Analyze(time_ns, category, result);
+}
+
+void CableRc_Analyze(const uint32_t time_ns[CABLERC_CONDUCTOR_COUNT], CableRcCategory_t category,
+                     CableRcResult_t* result)
+{
+    uint16_t per_metre = (category < CABLERC_CATEGORY_COUNT) ? pf_per_m[category] : pf_per_m[CABLERC_CAT5E];
+
+    result->loaded_mask = 0U;
+    result->open_mask = 0U;
+
+    for (uint8_t i = 0U; i < CABLERC_CONDUCTOR_COUNT; i++)
+    {
+        if (time_ns[i] == CABLERCHAL_TIMEOUT)
+        {
+            result->loaded_mask |= (uint8_t)(1U << i);
+            result->capacitance_pf[i] = CABLERC_NOT_MEASURED;
+            result->length_cm[i] = CABLERC_NOT_MEASURED;
+            continue;
+        }
+
+        uint32_t charge_ns = (time_ns[i] > zero_ns[i]) ? (time_ns[i] - zero_ns[i]) : 0U;
+        uint32_t pf = (charge_ns * 100UL) / CABLERC_NS_PER_PF_X100;
+        uint32_t cm = (pf * 100UL) / per_metre;
+
+        result->capacitance_pf[i] = (uint16_t)((pf < CABLERC_NOT_MEASURED) ? pf : (CABLERC_NOT_MEASURED - 1U));
+        result->length_cm[i] = (uint16_t)((cm < CABLERC_NOT_MEASURED) ? cm : (CABLERC_NOT_MEASURED - 1U));
+    }
+
+    uint8_t valid_mask = (uint8_t)~result->loaded_mask;
+    result->cable_length_cm = MedianOf(result->length_cm, valid_mask);
+
+    // An open conductor only charges the cable up to the break
+    uint32_t open_limit = ((uint32_t)result->cable_length_cm * CABLERC_OPEN_PERCENT) / 100U;
+    if ((result->cable_length_cm - open_limit) < CABLERC_OPEN_MIN_CM)
+    {
+        open_limit = (result->cable_length_cm > CABLERC_OPEN_MIN_CM) ?
+                     (result->cable_length_cm - CABLERC_OPEN_MIN_CM) : 0U;
+    }
+
+    for (uint8_t i = 0U; i < CABLERC_CONDUCTOR_COUNT; i++)
+    {
+        if ((valid_mask & (1U << i)) && (result->length_cm[i] < open_limit))
+        {
+            result->open_mask |= (uint8_t)(1U << i);
+        }
+    }
+}
+
+void CableRc_SetZero(const uint32_t time_ns[CABLERC_CONDUCTOR_COUNT])
+{
+    for (uint8_t i = 0U; i < CABLERC_CONDUCTOR_COUNT; i++)
+    {
+        zero_ns[i] = (time_ns[i] == CABLERCHAL_TIMEOUT) ? 0U : time_ns[i];
+    }
+}
+
+uint8_t CableRc_Calibrate(CableRcCategory_t category, uint16_t length_cm,
+                          const uint32_t time_ns[CABLERC_CONDUCTOR_COUNT])
+{
+    CableRcResult_t result;
+
+    if ((category >= CABLERC_CATEGORY_COUNT) || (length_cm == 0U))
+    {
+        return 0U;
+    }
+
+    CableRc_Analyze(time_ns, category, &result);
+
+    // Every conductor has to charge, otherwise the far end is still connected
+    if (result.loaded_mask != 0U)
+    {
+        return 0U;
+    }
+
+    uint32_t pf = MedianOf(result.capacitance_pf, 0xFFU);
+    uint32_t per_metre = ((pf * 100UL) + (length_cm / 2U)) / length_cm;
+    if ((per_metre == 0U) || (per_metre > 0xFFFFUL))
+    {
+        return 0U;
+    }
+
+    pf_per_m[category] = (uint16_t)per_metre;
+    return 1U;
+}
+
+uint16_t CableRc_GetPfPerMetre(CableRcCategory_t category)
+{
+    return (category < CABLERC_CATEGORY_COUNT) ? pf_per_m[category] : 0U;
+}
+
+// Private function implementations
+
+static uint16_t MedianOf(const uint16_t* values, uint8_t valid_mask)
+{
+    uint16_t sorted[CABLERC_CONDUCTOR_COUNT];
+    uint8_t count = 0U;
+
+    // Insertion sort of the valid values, 8 entries at most
+    for (uint8_t i = 0U; i < CABLERC_CONDUCTOR_COUNT; i++)
+    {
+        if (!(valid_mask & (1U << i)))
+        {
+            continue;
+        }
+
+        uint8_t j = count;
+        while ((j > 0U) && (sorted[j - 1U] > values[i]))
+        {
+            sorted[j] = sorted[j - 1U];
+            j--;
+        }
+        sorted[j] = values[i];
+        count++;
+    }
+
+    if (count == 0U)
+    {
+        return 0U;
+    }
+
+    // Upper median: opens pull the lower half down, so lean towards the full length
+    return sorted[count / 2U];
+}
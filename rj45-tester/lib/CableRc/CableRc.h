@@ -0,0 +1,81 @@
+#ifndef CABLERC_H
+#define CABLERC_H
+
+#include <stdint.h>
+
+// Configuration constants
+#define CABLERC_CONDUCTOR_COUNT     8U
+#define CABLERC_PULLUP_OHMS         35000UL /**< Typical internal pull-up, tolerance is absorbed by calibration */
+#define CABLERC_CHARGE_LN_X1000     1204UL  /**< -ln(1 - Vth/VDD) x 1000 for a 0.7 VDD input threshold */
+#define CABLERC_OPEN_PERCENT        90U     /**< Conductor shorter than this share of the cable is open */
+#define CABLERC_OPEN_MIN_CM         50U     /**< ...and at least this much shorter, for short cables */
+#define CABLERC_NOT_MEASURED        0xFFFFU /**< Capacitance/length of a conductor that did not charge */
+
+// Type definitions
+/**
+ * @brief Cable category, selects the capacitance per metre
+ */
+typedef enum
+{
+    CABLERC_CAT5E = 0,
+    CABLERC_CAT6,
+    CABLERC_CAT6A,
+    CABLERC_CATEGORY_COUNT
+} CableRcCategory_t;
+
+/**
+ * @brief Length estimate of one measurement
+ * @details Only meaningful with the far end unplugged: a far jack pulls every
+ *          conductor down and none of them charges (loaded_mask).
+ */
+typedef struct
+{
+    uint16_t capacitance_pf[CABLERC_CONDUCTOR_COUNT]; /**< Conductor to all others, board offset removed */
+    uint16_t length_cm[CABLERC_CONDUCTOR_COUNT];      /**< Estimated conductor length */
+    uint16_t cable_length_cm;    /**< Median conductor length */
+    uint8_t loaded_mask;         /**< Conductors that never charged: far end connected or shorted */
+    uint8_t open_mask;           /**< Conductors clearly shorter than the cable: open at length_cm */
+} CableRcResult_t;
+
+// Public API functions
+
+/**
+ * @brief Measure all 8 conductors and estimate their lengths
+ * @details Takes at most 8 x CABLERCHAL_MAX_TIME_US (8 ms), about 2 ms for 50 m
+ * @param category Cable category
+ * @param result Pointer to result to fill
+ */
+void CableRc_Measure(CableRcCategory_t category, CableRcResult_t* result);
+
+/**
+ * @brief Turn raw charge times into capacitances and lengths
+ * @param time_ns Charge time per conductor from CableRcHal_Measure()
+ * @param category Cable category
+ * @param result Pointer to result to fill
+ */
+void CableRc_Analyze(const uint32_t time_ns[CABLERC_CONDUCTOR_COUNT], CableRcCategory_t category,
+                     CableRcResult_t* result);
+
+/**
+ * @brief Store the board and jack capacitance, measured with nothing plugged in
+ * @param time_ns Charge times of an empty jack
+ */
+void CableRc_SetZero(const uint32_t time_ns[CABLERC_CONDUCTOR_COUNT]);
+
+/**
+ * @brief Calibrate the capacitance per metre of a category with a cable of known length
+ * @param category Category to calibrate
+ * @param length_cm Known cable length
+ * @param time_ns Charge times of that cable, far end unplugged
+ * @return uint8_t 1 if calibrated, 0 if the measurement was unusable
+ */
+uint8_t CableRc_Calibrate(CableRcCategory_t category, uint16_t length_cm,
+                          const uint32_t time_ns[CABLERC_CONDUCTOR_COUNT]);
+
+/**
+ * @brief Get the capacitance per metre currently used for a category
+ * @return uint16_t Capacitance in pF per metre
+ */
+uint16_t CableRc_GetPfPerMetre(CableRcCategory_t category);
+
+#endif /* CABLERC_H */
@@ -0,0 +1,88 @@
+#include "CableRcHal.h"
+#include "Board.h"
+#include "BoardHal.h"
+
+// Private constants
+#define HAL_DISCHARGE_LOOPS         120U   /**< Busy loops with all conductors low before a measurement (~10 us) */
+
+static const BoardPin_t drive_pins[BOARD_CONDUCTOR_COUNT] = BOARD_DRIVE_PINS;
+static GPIO_TypeDef* const gpio_ports[BOARD_PORT_COUNT] = BOARD_GPIO_PORTS;
+
+// Private function prototypes
+static void DischargeDelay(void);
+static uint32_t TimeCharge(GPIO_TypeDef* port, uint32_t pin_mask, uint32_t timeout_ticks);
+
+// Public API Implementation
+
+void CableRcHal_Measure(uint32_t time_ns[8])
+{
+    BoardJackState_t saved_jack;
+
+    // Every conductor becomes a low output: discharged, and the return for the others
+    BoardHal_SaveJack(&saved_jack, drive_pins);
+    BoardHal_SetJack(&saved_jack, BOARD_GPIO_CFG_OUTPUT_PP);
+
+    uint32_t ticks_per_us = (SystemCoreClock / 1000000UL) / BoardHal_SysTickDivider();
+
+    for (uint8_t i = 0U; i < BOARD_CONDUCTOR_COUNT; i++)
+    {
+        GPIO_TypeDef* port = gpio_ports[drive_pins[i].port];
+        uint32_t pin_mask = 1UL << drive_pins[i].pin;
+
+        DischargeDelay();
+
+        // Input with OUTDR low is pulled down, so the line stays discharged until timing starts
+        BoardHal_ConfigurePin(&drive_pins[i], BOARD_GPIO_CFG_INPUT_PULL);
+        uint32_t ticks = TimeCharge(port, pin_mask, CABLERCHAL_MAX_TIME_US * ticks_per_us);
+
+        // Back to a low output before the next conductor
+        port->BCR = pin_mask;
+        BoardHal_ConfigurePin(&drive_pins[i], BOARD_GPIO_CFG_OUTPUT_PP);
+
+        time_ns[i] = (ticks == CABLERCHAL_TIMEOUT) ? CABLERCHAL_TIMEOUT : (ticks * 1000UL) / ticks_per_us;
+    }
+
+    DischargeDelay();
+    BoardHal_RestoreJack(&saved_jack);
+}
+
+// Private function implementations
+
+static void DischargeDelay(void)
+{
+    for (uint32_t loops = HAL_DISCHARGE_LOOPS; loops > 0U; loops--)
+    {
+        __asm__ volatile ("nop");
+    }
+}
+
+static uint32_t TimeCharge(GPIO_TypeDef* port, uint32_t pin_mask, uint32_t timeout_ticks)
+{
+    uint32_t ticks = 0U;
+    uint32_t elapsed = CABLERCHAL_TIMEOUT;
+
+    // No interrupt may stretch the gap between switching the pull-up on and the capture
+    __disable_irq();
+    uint32_t last = SysTick->CNT;
+    port->BSHR = pin_mask;
+
+    // Summed read to read: one difference to the start wraps at the reload,
+    // and the timeout is a whole 1 ms reload period
+    for (;;)
+    {
+        ticks += BoardHal_SysTickElapsed(&last);
+
+        if (port->INDR & pin_mask)
+        {
+            elapsed = ticks;
+            break;
+        }
+        if (ticks > timeout_ticks)
+        {
+            break;
+        }
+    }
+
+    __enable_irq();
+    return elapsed;
+}
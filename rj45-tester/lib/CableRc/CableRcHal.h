@@ -0,0 +1,26 @@
+#ifndef CABLERCHAL_H
+#define CABLERCHAL_H
+
+#include <stdint.h>
+
+/**
+ * @file CableRcHal.h
+ * @brief Charge time measurement used by the CableRc estimator
+ * @details Implemented for the tester board in CableRcHal.cpp. The host cable
+ *          model in tools/cable-rc-model.cpp provides its own implementation,
+ *          tools/cable-rc-hal-test.cpp tests this one on simulated registers.
+ */
+
+#define CABLERCHAL_TIMEOUT          0xFFFFFFFFUL /**< Conductor never reached the input threshold */
+#define CABLERCHAL_MAX_TIME_US      1000U  /**< Give up on a conductor after this time (100 m at the slowest pull-up) */
+
+/**
+ * @brief Time how long each conductor takes to charge through its pull-up
+ * @details Every conductor is discharged, then released to the internal
+ *          pull-up while all others are held low. The time until the input
+ *          reads high is captured with SysTick with interrupts disabled.
+ * @param time_ns Output, charge time per conductor in ns or CABLERCHAL_TIMEOUT
+ */
+void CableRcHal_Measure(uint32_t time_ns[8]);
+
+#endif /* CABLERCHAL_H */
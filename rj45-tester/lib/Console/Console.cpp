@@ -0,0 +1,132 @@
+#include "Console.h"
+
+// Private function prototypes
+static void ClearLine(Console_t* console);
+
+// Public API Implementation
+
+void Console_Init(Console_t* console)
+{
+    ClearLine(console);
+}
+
+ConsoleStatus_t Console_Feed(Console_t* console, char c, ConsoleLine_t* line)
+{
+    uint8_t length = console->length;
+
+    if ((c == '\r') || (c == '\n') || (c == ';'))
+    {
+        uint8_t overflow = console->overflow;
+        uint8_t word_count = console->word_count;
+
+        // Empty lines are skipped, so CR LF counts as one terminator
+        if (!overflow && (word_count > 0U))
+        {
+            console->buffer[length] = '\0';
+            line->word_count = word_count;
+            for (uint8_t i = 0U; i < word_count; i++)
+            {
+                line->words[i] = &console->buffer[console->word_start[i]];
+            }
+        }
+        ClearLine(console);
+
+        if (overflow)
+        {
+            return CONSOLE_OVERFLOW;
+        }
+        return (word_count > 0U) ? CONSOLE_LINE : CONSOLE_PENDING;
+    }
+
+    if (console->overflow)
+    {
+        return CONSOLE_PENDING;
+    }
+
+    if ((c == '\b') || (c == 0x7F))
+    {
+        if (length > 0U)
+        {
+            length--;
+            if ((console->word_count > 0U) && (console->word_start[console->word_count - 1U] == length))
+            {
+                console->word_count--;
+            }
+            console->length = length;
+        }
+        return CONSOLE_PENDING;
+    }
+
+    uint8_t after_separator = (length == 0U) || (console->buffer[length - 1U] == '\0');
+
+    if ((c == ' ') || (c == '\t'))
+    {
+        // One terminator per word, repeated separators are dropped
+        if (!after_separator)
+        {
+            console->buffer[length] = '\0';
+            console->length = (uint8_t)(length + 1U);
+        }
+        return CONSOLE_PENDING;
+    }
+
+    if ((c < ' ') || (c > '~'))
+    {
+        return CONSOLE_PENDING;
+    }
+
+    // Keep one byte for the terminator added at the end of the line
+    if ((length >= (CONSOLE_LINE_SIZE - 1U)) ||
+        (after_separator && (console->word_count >= CONSOLE_MAX_WORDS)))
+    {
+        console->overflow = 1U;
+        return CONSOLE_PENDING;
+    }
+
+    if (after_separator)
+    {
+        console->word_start[console->word_count] = length;
+        console->word_count++;
+    }
+    if ((c >= 'A') && (c <= 'Z'))
+    {
+        c = (char)(c + ('a' - 'A'));
+    }
+    console->buffer[length] = c;
+    console->length = (uint8_t)(length + 1U);
+
+    return CONSOLE_PENDING;
+}
+
+uint8_t Console_ParseNumber(const char* word, uint32_t* value)
+{
+    uint32_t result = 0U;
+
+    if (*word == '\0')
+    {
+        return 0U;
+    }
+
+    for (; *word != '\0'; word++)
+    {
+        uint32_t digit = (uint32_t)(*word - '0');
+
+        if ((digit > 9U) || (result > ((0xFFFFFFFFUL - digit) / 10U)))
+        {
+            return 0U;
+        }
+        result = (result * 10U) + digit;
+    }
+
+    *value = result;
+    return 1U;
+}
+
+// Private function implementations
+
+static void ClearLine(Console_t* console)
+{
+    console->length = 0U;
+    console->word_count = 0U;
+    console->overflow = 0U;
+}
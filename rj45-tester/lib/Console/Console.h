@@ -0,0 +1,73 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <stdint.h>
+
+// Configuration constants
+#define CONSOLE_LINE_SIZE           24U    /**< Longest command line, terminator included */
+#define CONSOLE_MAX_WORDS           3U     /**< Command word and up to two arguments */
+
+// Type definitions
+/**
+ * @brief Result of feeding one received character
+ */
+typedef enum
+{
+    CONSOLE_PENDING = 0,         /**< Line not complete yet */
+    CONSOLE_LINE,                /**< A command line is complete */
+    CONSOLE_OVERFLOW             /**< Line too long or too many words, discarded */
+} ConsoleStatus_t;
+
+/**
+ * @brief Incremental command line parser
+ * @details Characters are split into words as they arrive, so a complete
+ *          line needs no further parsing. Words are separated by spaces or
+ *          tabs, lines end with CR, LF or ';'. Letters are folded to lower
+ *          case and backspace removes the last character.
+ */
+typedef struct
+{
+    char buffer[CONSOLE_LINE_SIZE];          /**< Words of the current line, each terminated */
+    uint8_t length;                          /**< Characters stored in buffer */
+    uint8_t word_count;                      /**< Words started in the current line */
+    uint8_t word_start[CONSOLE_MAX_WORDS];   /**< Buffer index of each word */
+    uint8_t overflow;                        /**< Current line is being discarded */
+} Console_t;
+
+/**
+ * @brief A complete command line
+ * @details The words point into the parser buffer and stay valid until the
+ *          next Console_Feed()
+ */
+typedef struct
+{
+    uint8_t word_count;                      /**< Number of words, at least 1 */
+    const char* words[CONSOLE_MAX_WORDS];    /**< Command word first */
+} ConsoleLine_t;
+
+// Public API functions
+
+/**
+ * @brief Start with an empty line
+ * @param console Pointer to parser
+ */
+void Console_Init(Console_t* console);
+
+/**
+ * @brief Add one received character to the current line
+ * @param console Pointer to parser
+ * @param c Received character
+ * @param line Filled when CONSOLE_LINE is returned
+ * @return ConsoleStatus_t CONSOLE_LINE when a non-empty line ended with c
+ */
+ConsoleStatus_t Console_Feed(Console_t* console, char c, ConsoleLine_t* line);
+
+/**
+ * @brief Parse a decimal number word
+ * @param word Digits only
+ * @param value Pointer to store the number
+ * @return uint8_t 1 if valid, 0 if empty, not a number or above 2^32 - 1
+ */
+uint8_t Console_ParseNumber(const char* word, uint32_t* value);
+
+#endif /* CONSOLE_H */
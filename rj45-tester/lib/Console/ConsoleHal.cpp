@@ -0,0 +1,95 @@
+#include <Arduino.h>
+#include "ConsoleHal.h"
+
+// Private constants
+#define CONSOLEHAL_RX_HALF          (CONSOLEHAL_RX_SIZE / 2U)
+
+// Private variables
+static uint8_t rx_buffer[CONSOLEHAL_RX_SIZE];
+static volatile uint32_t rx_halves = 0U;  /**< Half rings filled by the DMA, DMA interrupt only */
+static uint32_t rx_read = 0U;             /**< Bytes read, the ring index is the low bits */
+static uint32_t lost_count = 0U;
+
+// Private function prototypes
+extern "C" void DMA1_Channel5_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
+static uint32_t GetWritten(void);
+
+// Public API Implementation
+
+void ConsoleHal_Init(void)
+{
+    RCC->AHBPCENR |= RCC_AHBPeriph_DMA1;
+
+    // A receive interrupt of the serial driver would race the DMA for the data register
+    USART1->CTLR1 &= ~USART_CTLR1_RXNEIE;
+
+    DMA1_Channel5->CFGR = 0U;
+    DMA1_Channel5->PADDR = (uint32_t)(uintptr_t)&USART1->DATAR;
+    DMA1_Channel5->MADDR = (uint32_t)(uintptr_t)rx_buffer;
+    DMA1_Channel5->CNTR = CONSOLEHAL_RX_SIZE;
+    DMA1->INTFCR = DMA1_IT_GL5;
+    rx_halves = 0U;
+    rx_read = 0U;
+    lost_count = 0U;
+    NVIC_EnableIRQ(DMA1_Channel5_IRQn);
+    DMA1_Channel5->CFGR = DMA_MemoryInc_Enable | DMA_Mode_Circular | DMA_IT_HT | DMA_IT_TC | DMA_CFGR1_EN;
+
+    USART1->CTLR3 |= USART_DMAReq_Rx;
+}
+
+int16_t ConsoleHal_Read(void)
+{
+    uint32_t written = GetWritten();
+
+    if (written == rx_read)
+    {
+        return -1;
+    }
+
+    if ((written - rx_read) > CONSOLEHAL_RX_SIZE)
+    {
+        // The DMA lapped the reader, the ring may be overwritten while it is read
+        lost_count += written - rx_read;
+        rx_read = written;
+        return CONSOLEHAL_OVERRUN;
+    }
+
+    uint8_t value = rx_buffer[rx_read & (CONSOLEHAL_RX_SIZE - 1U)];
+    rx_read++;
+    return value;
+}
+
+uint32_t ConsoleHal_GetLostCount(void)
+{
+    return lost_count;
+}
+
+// Private function implementations
+
+/**
+ * @brief Bytes written by the DMA since ConsoleHal_Init()
+ * @details The counter gives the position within the ring, the half count
+ *          the passes. A half interrupt still pending is corrected for by
+ *          taking the position relative to the last counted half.
+ */
+static uint32_t GetWritten(void)
+{
+    uint32_t halves;
+    uint16_t position;
+
+    // Reread if the interrupt hit in between
+    do
+    {
+        halves = rx_halves;
+        position = (uint16_t)(CONSOLEHAL_RX_SIZE - DMA1_Channel5->CNTR);
+    } while (halves != rx_halves);
+
+    uint16_t half_start = (uint16_t)((halves & 1U) * CONSOLEHAL_RX_HALF);
+    return (halves * CONSOLEHAL_RX_HALF) + ((uint16_t)(position - half_start) & (CONSOLEHAL_RX_SIZE - 1U));
+}
+
+void DMA1_Channel5_IRQHandler(void)
+{
+    DMA1->INTFCR = DMA1_IT_GL5;
+    rx_halves++;
+}
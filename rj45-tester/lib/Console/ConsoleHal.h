@@ -0,0 +1,41 @@
+#ifndef CONSOLEHAL_H
+#define CONSOLEHAL_H
+
+#include <stdint.h>
+
+/**
+ * @file ConsoleHal.h
+ * @brief USART1 receive ring filled by DMA
+ * @details DMA1 channel 5 copies every received byte into a circular buffer,
+ *          so reception costs no CPU time. A half-ring interrupt counts the
+ *          DMA passes, so the reader knows how far the DMA is ahead even
+ *          after it wrapped. At 115200 baud the ring fills in about 11 ms,
+ *          longer than any loop pass except blocking text output such as a
+ *          full wiremap print. Bytes overwritten before they were read are
+ *          dropped, counted and reported once by ConsoleHal_Read().
+ */
+
+#define CONSOLEHAL_RX_SIZE          128U   /**< Receive ring size in bytes, power of two */
+#define CONSOLEHAL_OVERRUN          (-2)   /**< ConsoleHal_Read() result after received bytes were lost */
+
+/**
+ * @brief Take over USART1 reception from the serial driver
+ * @details Call after Serial.begin(). Serial.read() returns nothing afterwards.
+ */
+void ConsoleHal_Init(void);
+
+/**
+ * @brief Get the next received byte
+ * @return int16_t Byte value, -1 if nothing was received, CONSOLEHAL_OVERRUN
+ *         once when the DMA overwrote unread bytes; everything received up
+ *         to then is dropped
+ */
+int16_t ConsoleHal_Read(void);
+
+/**
+ * @brief Get number of received bytes dropped because the ring overflowed
+ * @return uint32_t Lost byte count since ConsoleHal_Init()
+ */
+uint32_t ConsoleHal_GetLostCount(void);
+
+#endif /* CONSOLEHAL_H */
@@ -0,0 +1,315 @@
+#include "DualLink.h"
+
+// Private constants
+#define DUALLINK_STATE_IDLE         0U     /**< Main: no scan running. Remote: listening for a request */
+#define DUALLINK_STATE_DRIVE        1U     /**< Main: report the next conductor to drive */
+#define DUALLINK_STATE_SETTLE       2U     /**< Main: conductor driven, waiting before the request */
+#define DUALLINK_STATE_SEND         3U     /**< Frame on the line */
+#define DUALLINK_STATE_WAIT         4U     /**< Main: waiting for the reply */
+#define DUALLINK_STATE_TURNAROUND   5U     /**< Remote: waiting before the reply */
+
+#define DUALLINK_REQUEST            0x50U  /**< Request header, low 3 bits carry the driven conductor */
+#define DUALLINK_REPLY              0xA0U  /**< Reply header */
+#define DUALLINK_REQUEST_SIZE       2U
+#define DUALLINK_REPLY_SIZE         3U
+#define DUALLINK_STOP_BIT           9U     /**< tx_bit of the stop bit */
+#define DUALLINK_RX_STOP_BIT        10U    /**< rx_bit of the stop bit */
+#define DUALLINK_MAX_GAP_TICKS      (2U * 10U * DUALLINK_TICKS_PER_BIT) /**< Incomplete frame dropped after two byte times of silence */
+#define DUALLINK_CRC_POLY           0x07U  /**< CRC-8, init 0 */
+
+// Private function prototypes
+static void SendFrame(DualLink_t* link, const uint8_t* frame, uint8_t size);
+static uint8_t TransmitTick(DualLink_t* link);
+static uint8_t ReceiveTick(DualLink_t* link, uint8_t line_in);
+static uint8_t NextConductor(uint8_t conductor);
+static uint8_t Crc8(const uint8_t* data, uint8_t length);
+
+// Public API Implementation
+
+void DualLink_Init(DualLink_t* link, DualLinkRole_t role)
+{
+    uint8_t* bytes = (uint8_t*)link;
+
+    for (uint16_t i = 0U; i < sizeof(DualLink_t); i++)
+    {
+        bytes[i] = 0U;
+    }
+    link->role = role;
+    link->conductor = DUALLINK_NO_CONDUCTOR;
+}
+
+void DualLink_StartScan(DualLink_t* link)
+{
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        link->map.rows[i] = 0U;
+    }
+    link->conductor = NextConductor(DUALLINK_NO_CONDUCTOR);
+    link->attempts = 0U;
+    link->retries = 0U;
+    link->state = DUALLINK_STATE_DRIVE;
+}
+
+DualLinkEvent_t DualLink_Tick(DualLink_t* link, uint8_t line_in, uint8_t* line_out)
+{
+    DualLinkEvent_t event = DUALLINK_EVENT_NONE;
+
+    *line_out = DUALLINK_LINE_RELEASE;
+
+    // Half duplex: nothing is received while sending
+    if (link->state == DUALLINK_STATE_SEND)
+    {
+        *line_out = TransmitTick(link);
+        if (link->tx_size == 0U)
+        {
+            link->state = (link->role == DUALLINK_MAIN) ? DUALLINK_STATE_WAIT : DUALLINK_STATE_IDLE;
+            link->timer = DUALLINK_TIMEOUT_TICKS;
+        }
+        return DUALLINK_EVENT_NONE;
+    }
+
+    uint8_t frame_size = ReceiveTick(link, line_in);
+
+    switch (link->state)
+    {
+        case DUALLINK_STATE_IDLE:
+            // Only a remote acts on frames between scans
+            if ((link->role == DUALLINK_REMOTE) && (frame_size == DUALLINK_REQUEST_SIZE) &&
+                ((link->rx_frame[0] & 0xF8U) == DUALLINK_REQUEST))
+            {
+                link->tx_size = 0U;
+                link->timer = DUALLINK_TURNAROUND_TICKS;
+                link->state = DUALLINK_STATE_TURNAROUND;
+                event = DUALLINK_EVENT_SAMPLE;
+            }
+            break;
+
+        case DUALLINK_STATE_DRIVE:
+            link->timer = DUALLINK_SETTLE_TICKS;
+            link->state = DUALLINK_STATE_SETTLE;
+            event = DUALLINK_EVENT_DRIVE;
+            break;
+
+        case DUALLINK_STATE_SETTLE:
+            if (--link->timer == 0U)
+            {
+                uint8_t request[DUALLINK_REQUEST_SIZE] = { (uint8_t)(DUALLINK_REQUEST | link->conductor), 0U };
+                SendFrame(link, request, DUALLINK_REQUEST_SIZE);
+            }
+            break;
+
+        case DUALLINK_STATE_WAIT:
+            if ((frame_size == DUALLINK_REPLY_SIZE) && (link->rx_frame[0] == DUALLINK_REPLY))
+            {
+                // The link conductors carry the reply itself, they are not part of the row
+                link->map.rows[link->conductor] = link->rx_frame[1] & (uint8_t)~DUALLINK_LINK_MASK;
+                link->conductor = NextConductor(link->conductor);
+                link->attempts = 0U;
+                if (link->conductor == DUALLINK_NO_CONDUCTOR)
+                {
+                    link->map.rows[DUALLINK_DATA_CONDUCTOR] = 1U << DUALLINK_DATA_CONDUCTOR;
+                    link->map.rows[DUALLINK_GROUND_CONDUCTOR] = 1U << DUALLINK_GROUND_CONDUCTOR;
+                    link->state = DUALLINK_STATE_IDLE;
+                    event = DUALLINK_EVENT_DONE;
+                }
+                else
+                {
+                    link->state = DUALLINK_STATE_DRIVE;
+                }
+            }
+            else if (--link->timer == 0U)
+            {
+                link->attempts++;
+                if (link->attempts >= DUALLINK_RETRIES)
+                {
+                    link->conductor = DUALLINK_NO_CONDUCTOR;
+                    link->state = DUALLINK_STATE_IDLE;
+                    event = DUALLINK_EVENT_FAILED;
+                }
+                else
+                {
+                    uint8_t request[DUALLINK_REQUEST_SIZE] = { (uint8_t)(DUALLINK_REQUEST | link->conductor), 0U };
+                    link->retries++;
+                    SendFrame(link, request, DUALLINK_REQUEST_SIZE);
+                }
+            }
+            break;
+
+        case DUALLINK_STATE_TURNAROUND:
+            if (--link->timer == 0U)
+            {
+                // No reply queued: back to listening
+                link->state = (link->tx_size > 0U) ? DUALLINK_STATE_SEND : DUALLINK_STATE_IDLE;
+            }
+            break;
+
+        default:
+            link->state = DUALLINK_STATE_IDLE;
+            break;
+    }
+
+    return event;
+}
+
+void DualLink_Reply(DualLink_t* link, uint8_t levels)
+{
+    uint8_t reply[DUALLINK_REPLY_SIZE] = { DUALLINK_REPLY, levels, 0U };
+
+    SendFrame(link, reply, DUALLINK_REPLY_SIZE);
+
+    // Sent once the turnaround is over
+    link->state = DUALLINK_STATE_TURNAROUND;
+}
+
+uint8_t DualLink_IsIdle(const DualLink_t* link)
+{
+    return ((link->state == DUALLINK_STATE_IDLE) && (link->rx_bit == 0U) && (link->rx_size == 0U)) ? 1U : 0U;
+}
+
+// Private function implementations
+
+static void SendFrame(DualLink_t* link, const uint8_t* frame, uint8_t size)
+{
+    for (uint8_t i = 0U; i < (uint8_t)(size - 1U); i++)
+    {
+        link->tx_frame[i] = frame[i];
+    }
+    link->tx_frame[size - 1U] = Crc8(frame, (uint8_t)(size - 1U));
+    link->tx_size = size;
+    link->tx_index = 0U;
+    link->tx_bit = 0U;
+    link->tx_ticks = 0U;
+    link->state = DUALLINK_STATE_SEND;
+}
+
+static uint8_t TransmitTick(DualLink_t* link)
+{
+    uint8_t level;
+
+    if (link->tx_bit == 0U)
+    {
+        level = DUALLINK_LINE_HIGH;
+    }
+    else if (link->tx_bit == DUALLINK_STOP_BIT)
+    {
+        level = DUALLINK_LINE_LOW;
+    }
+    else
+    {
+        level = (link->tx_frame[link->tx_index] >> (link->tx_bit - 1U)) & 1U;
+    }
+
+    if (++link->tx_ticks >= DUALLINK_TICKS_PER_BIT)
+    {
+        link->tx_ticks = 0U;
+        if (++link->tx_bit > DUALLINK_STOP_BIT)
+        {
+            link->tx_bit = 0U;
+            if (++link->tx_index >= link->tx_size)
+            {
+                link->tx_size = 0U;
+            }
+        }
+    }
+    return level;
+}
+
+static uint8_t ReceiveTick(DualLink_t* link, uint8_t line_in)
+{
+    if (link->rx_bit == 0U)
+    {
+        // Idle low: a high level is the start bit, checked again in its middle
+        if (line_in)
+        {
+            link->rx_bit = 1U;
+            link->rx_ticks = DUALLINK_TICKS_PER_BIT / 2U;
+            link->rx_gap = 0U;
+        }
+        else if ((link->rx_size > 0U) && (++link->rx_gap > DUALLINK_MAX_GAP_TICKS))
+        {
+            link->rx_size = 0U;
+        }
+        return 0U;
+    }
+
+    if (--link->rx_ticks > 0U)
+    {
+        return 0U;
+    }
+    link->rx_ticks = DUALLINK_TICKS_PER_BIT;
+
+    if (link->rx_bit == 1U)
+    {
+        // Too short for a start bit
+        link->rx_bit = line_in ? 2U : 0U;
+        return 0U;
+    }
+
+    if (link->rx_bit < DUALLINK_RX_STOP_BIT)
+    {
+        link->rx_byte = (uint8_t)((link->rx_byte >> 1) | (line_in ? 0x80U : 0x00U));
+        link->rx_bit++;
+        return 0U;
+    }
+
+    link->rx_bit = 0U;
+    if (line_in || (link->rx_size >= DUALLINK_FRAME_SIZE))
+    {
+        // Framing error: the frame so far is lost
+        link->rx_size = 0U;
+        link->rx_errors += (link->rx_errors < 0xFFFFU) ? 1U : 0U;
+        return 0U;
+    }
+
+    link->rx_frame[link->rx_size++] = link->rx_byte;
+
+    // The header tells the frame size
+    uint8_t expected = ((link->rx_frame[0] & 0xF8U) == DUALLINK_REQUEST) ? DUALLINK_REQUEST_SIZE :
+                       (link->rx_frame[0] == DUALLINK_REPLY) ? DUALLINK_REPLY_SIZE : 0U;
+    if (expected == 0U)
+    {
+        link->rx_size = 0U;
+        link->rx_errors += (link->rx_errors < 0xFFFFU) ? 1U : 0U;
+        return 0U;
+    }
+    if (link->rx_size < expected)
+    {
+        return 0U;
+    }
+
+    link->rx_size = 0U;
+    if (Crc8(link->rx_frame, (uint8_t)(expected - 1U)) != link->rx_frame[expected - 1U])
+    {
+        link->rx_errors += (link->rx_errors < 0xFFFFU) ? 1U : 0U;
+        return 0U;
+    }
+    return expected;
+}
+
+static uint8_t NextConductor(uint8_t conductor)
+{
+    // DUALLINK_NO_CONDUCTOR + 1 wraps to the first conductor
+    for (conductor++; conductor < WIREMAP_CONDUCTOR_COUNT; conductor++)
+    {
+        if (!(DUALLINK_LINK_MASK & (1U << conductor)))
+        {
+            return conductor;
+        }
+    }
+    return DUALLINK_NO_CONDUCTOR;
+}
+
+static uint8_t Crc8(const uint8_t* data, uint8_t length)
+{
+    uint8_t crc = 0U;
+
+    for (uint8_t i = 0U; i < length; i++)
+    {
+        crc ^= data[i];
+        for (uint8_t bit = 0U; bit < 8U; bit++)
+        {
+            crc = (crc & 0x80U) ? (uint8_t)((crc << 1) ^ DUALLINK_CRC_POLY) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
@@ -0,0 +1,120 @@
+#ifndef DUALLINK_H
+#define DUALLINK_H
+
+#include <stdint.h>
+#include "WireMap.h"
+
+// Configuration constants
+#define DUALLINK_DATA_CONDUCTOR     6U     /**< RJ45 pin 7, half-duplex data between the units */
+#define DUALLINK_GROUND_CONDUCTOR   7U     /**< RJ45 pin 8, held low at both ends as common ground */
+#define DUALLINK_LINK_MASK          ((1U << DUALLINK_DATA_CONDUCTOR) | (1U << DUALLINK_GROUND_CONDUCTOR))
+#define DUALLINK_NO_CONDUCTOR       0xFFU  /**< Drive event: release every conductor */
+#define DUALLINK_TICK_US            4U     /**< Tick period, the line is read and written once per tick */
+#define DUALLINK_TICKS_PER_BIT      8U     /**< 32 us bits, tolerates 3% clock difference between the units */
+#define DUALLINK_SETTLE_TICKS       12U    /**< Before a request: the conductor settles, the last reply has ended */
+#define DUALLINK_TURNAROUND_TICKS   16U    /**< Gap before answering, the other end has released the line */
+#define DUALLINK_TIMEOUT_TICKS      400U   /**< Request without a complete reply after this long is repeated */
+#define DUALLINK_RETRIES            3U     /**< Requests per conductor before the scan fails */
+#define DUALLINK_FRAME_SIZE         3U     /**< Largest frame: header, row, CRC */
+
+// Line levels written by DualLink_Tick()
+#define DUALLINK_LINE_LOW           0U
+#define DUALLINK_LINE_HIGH          1U
+#define DUALLINK_LINE_RELEASE       2U     /**< Input with pull-down, the other end may drive */
+
+// Type definitions
+/**
+ * @brief Role of a unit on the link
+ */
+typedef enum
+{
+    DUALLINK_MAIN = 0,           /**< Drives the conductors and collects the remote rows */
+    DUALLINK_REMOTE              /**< Far end: samples its jack when asked and answers */
+} DualLinkRole_t;
+
+/**
+ * @brief What the caller has to do after a tick
+ */
+typedef enum
+{
+    DUALLINK_EVENT_NONE = 0,
+    DUALLINK_EVENT_DRIVE,        /**< Main: drive conductor link->conductor high, all others released */
+    DUALLINK_EVENT_SAMPLE,       /**< Remote: read the jack now and pass it to DualLink_Reply() */
+    DUALLINK_EVENT_DONE,         /**< Main: link->map holds the remote wiremap */
+    DUALLINK_EVENT_FAILED        /**< Main: no valid reply after DUALLINK_RETRIES requests */
+} DualLinkEvent_t;
+
+/**
+ * @brief One end of the link
+ * @details Bytes are sent like a UART with an idle-low line: a high start
+ *          bit, 8 data bits LSB first and a low stop bit, each
+ *          DUALLINK_TICKS_PER_BIT ticks long. A request carries the driven
+ *          conductor, the reply the 8 levels the remote sees, both closed by
+ *          a CRC-8. The state machine does no I/O itself, so two instances
+ *          can be wired together on a host.
+ */
+typedef struct
+{
+    DualLinkRole_t role;
+    uint8_t state;               /**< Protocol step of the role */
+    uint16_t timer;              /**< Ticks left in the current step */
+    uint8_t conductor;           /**< Main: conductor being probed */
+    uint8_t attempts;            /**< Main: requests sent for this conductor */
+    uint16_t retries;            /**< Main: repeated requests since DualLink_StartScan() */
+    WireMap_t map;               /**< Main: remote wiremap being collected */
+    uint8_t tx_frame[DUALLINK_FRAME_SIZE];
+    uint8_t tx_size;
+    uint8_t tx_index;            /**< Byte being sent */
+    uint8_t tx_bit;              /**< Bit being sent: 0 start, 1-8 data, 9 stop */
+    uint8_t tx_ticks;            /**< Ticks the current bit has been on the line */
+    uint8_t rx_frame[DUALLINK_FRAME_SIZE];
+    uint8_t rx_size;
+    uint8_t rx_byte;
+    uint8_t rx_bit;              /**< 0 idle, 1 start, 2-9 data, 10 stop */
+    uint8_t rx_ticks;            /**< Ticks until the next sample */
+    uint16_t rx_gap;             /**< Ticks since the last byte of an incomplete frame */
+    uint16_t rx_errors;          /**< Framing and CRC errors, saturating */
+} DualLink_t;
+
+// Public API functions
+
+/**
+ * @brief Reset one end of the link, line released
+ * @param link Pointer to link
+ * @param role Role of this unit
+ */
+void DualLink_Init(DualLink_t* link, DualLinkRole_t role);
+
+/**
+ * @brief Start collecting a remote wiremap (main only)
+ * @details The next tick returns DUALLINK_EVENT_DRIVE for the first conductor.
+ *          The link conductors are not probed; they carried the replies, so
+ *          DUALLINK_EVENT_DONE reports them as straight.
+ * @param link Pointer to link
+ */
+void DualLink_StartScan(DualLink_t* link);
+
+/**
+ * @brief Advance the link by one tick
+ * @param link Pointer to link
+ * @param line_in Level read from the data line this tick
+ * @param line_out Output, DUALLINK_LINE_LOW, DUALLINK_LINE_HIGH or DUALLINK_LINE_RELEASE
+ * @return DualLinkEvent_t Action for the caller
+ */
+DualLinkEvent_t DualLink_Tick(DualLink_t* link, uint8_t line_in, uint8_t* line_out);
+
+/**
+ * @brief Answer a request with the levels of the jack (remote only)
+ * @param link Pointer to link
+ * @param levels Jack levels, bit N for conductor N
+ */
+void DualLink_Reply(DualLink_t* link, uint8_t levels);
+
+/**
+ * @brief Check whether the link is between frames
+ * @param link Pointer to link
+ * @return uint8_t 1 if nothing is being sent or received
+ */
+uint8_t DualLink_IsIdle(const DualLink_t* link);
+
+#endif /* DUALLINK_H */
@@ -0,0 +1,114 @@
+#include "DualLinkHal.h"
+#include "DualLink.h"
+#include "Board.h"
+#include "BoardHal.h"
+
+static const BoardPin_t drive_pins[BOARD_CONDUCTOR_COUNT] = BOARD_DRIVE_PINS;
+static GPIO_TypeDef* const gpio_ports[BOARD_PORT_COUNT] = BOARD_GPIO_PORTS;
+
+// Private variables
+static BoardJackState_t saved_jack;
+static uint8_t driven = DUALLINK_NO_CONDUCTOR;
+static uint32_t tick_period;     /**< SysTick counts per link tick */
+static uint32_t tick_elapsed;    /**< SysTick counts since the last tick started */
+static uint32_t tick_last;       /**< SysTick count at the last poll */
+
+// Public API Implementation
+
+void DualLinkHal_Begin(void)
+{
+    BoardHal_SaveJack(&saved_jack, drive_pins);
+
+    // OUTDR is low for all lines: inputs pull down, the ground conductor is a low output
+    BoardHal_SetJack(&saved_jack, BOARD_GPIO_CFG_INPUT_PULL);
+    BoardHal_ConfigurePin(&drive_pins[DUALLINK_GROUND_CONDUCTOR], BOARD_GPIO_CFG_OUTPUT_PP);
+    driven = DUALLINK_NO_CONDUCTOR;
+
+    tick_period = DUALLINK_TICK_US * ((SystemCoreClock / 1000000UL) / BoardHal_SysTickDivider());
+    tick_elapsed = 0U;
+    tick_last = SysTick->CNT;
+}
+
+void DualLinkHal_Drive(uint8_t conductor)
+{
+    if (driven != DUALLINK_NO_CONDUCTOR)
+    {
+        GPIO_TypeDef* port = gpio_ports[drive_pins[driven].port];
+
+        // Pull the conductor low actively before releasing it
+        port->BCR = 1UL << drive_pins[driven].pin;
+        BoardHal_ConfigurePin(&drive_pins[driven], BOARD_GPIO_CFG_INPUT_PULL);
+    }
+
+    driven = conductor;
+    if (conductor != DUALLINK_NO_CONDUCTOR)
+    {
+        BoardHal_ConfigurePin(&drive_pins[conductor], BOARD_GPIO_CFG_OUTPUT_PP);
+        gpio_ports[drive_pins[conductor].port]->BSHR = 1UL << drive_pins[conductor].pin;
+    }
+}
+
+uint8_t DualLinkHal_Sense(void)
+{
+    uint32_t inputs[BOARD_PORT_COUNT];
+    uint8_t levels = 0U;
+
+    // All ports back to back, then packed
+    for (uint8_t p = 0U; p < BOARD_PORT_COUNT; p++)
+    {
+        inputs[p] = gpio_ports[p]->INDR;
+    }
+    for (uint8_t i = 0U; i < BOARD_CONDUCTOR_COUNT; i++)
+    {
+        if (inputs[drive_pins[i].port] & (1UL << drive_pins[i].pin))
+        {
+            levels |= (uint8_t)(1U << i);
+        }
+    }
+    return levels;
+}
+
+void DualLinkHal_SetLine(uint8_t level)
+{
+    const BoardPin_t* pin = &drive_pins[DUALLINK_DATA_CONDUCTOR];
+    GPIO_TypeDef* port = gpio_ports[pin->port];
+
+    if (level == DUALLINK_LINE_RELEASE)
+    {
+        // Low OUTDR first, so the input pulls down
+        port->BCR = 1UL << pin->pin;
+        BoardHal_ConfigurePin(pin, BOARD_GPIO_CFG_INPUT_PULL);
+        return;
+    }
+
+    port->BSHR = (level == DUALLINK_LINE_HIGH) ? (1UL << pin->pin) : (1UL << (pin->pin + 16U));
+    BoardHal_ConfigurePin(pin, BOARD_GPIO_CFG_OUTPUT_PP);
+}
+
+uint8_t DualLinkHal_ReadLine(void)
+{
+    const BoardPin_t* pin = &drive_pins[DUALLINK_DATA_CONDUCTOR];
+
+    return (gpio_ports[pin->port]->INDR & (1UL << pin->pin)) ? 1U : 0U;
+}
+
+void DualLinkHal_WaitTick(void)
+{
+    while (tick_elapsed < tick_period)
+    {
+        tick_elapsed += BoardHal_SysTickElapsed(&tick_last);
+    }
+
+    // Keep the overshoot, the schedule does not drift
+    tick_elapsed -= tick_period;
+    if (tick_elapsed > tick_period)
+    {
+        tick_elapsed = tick_period;
+    }
+}
+
+void DualLinkHal_End(void)
+{
+    BoardHal_RestoreJack(&saved_jack);
+    driven = DUALLINK_NO_CONDUCTOR;
+}
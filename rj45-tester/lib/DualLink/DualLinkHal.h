@@ -0,0 +1,58 @@
+#ifndef DUALLINKHAL_H
+#define DUALLINKHAL_H
+
+#include <stdint.h>
+
+/**
+ * @file DualLinkHal.h
+ * @brief Near jack access used by the DualLink protocol
+ * @details Implemented for the tester board in DualLinkHal.cpp. Both units
+ *          work on their near jack only: the main unit drives its LED lines,
+ *          the remote unit reads its own. The host simulator in
+ *          tools/dual-link-sim.cpp runs the protocol without this HAL.
+ */
+
+/**
+ * @brief Save the near jack lines and set them up for the link
+ * @details Every conductor becomes a pulled-down input except the ground
+ *          conductor, a low output at both ends. The tick clock starts here.
+ */
+void DualLinkHal_Begin(void);
+
+/**
+ * @brief Drive one conductor high, the previously driven one is released
+ * @param conductor Conductor index (0-7) or DUALLINK_NO_CONDUCTOR to release all
+ */
+void DualLinkHal_Drive(uint8_t conductor);
+
+/**
+ * @brief Read the levels of all near jack lines
+ * @return uint8_t Levels, bit N for conductor N
+ */
+uint8_t DualLinkHal_Sense(void);
+
+/**
+ * @brief Set the data line
+ * @param level DUALLINK_LINE_LOW, DUALLINK_LINE_HIGH or DUALLINK_LINE_RELEASE
+ */
+void DualLinkHal_SetLine(uint8_t level);
+
+/**
+ * @brief Read the data line
+ * @return uint8_t 1 if high
+ */
+uint8_t DualLinkHal_ReadLine(void);
+
+/**
+ * @brief Wait for the start of the next tick
+ * @details Ticks follow a fixed SysTick schedule from DualLinkHal_Begin(), a
+ *          late tick is made up by a shorter wait for the next one.
+ */
+void DualLinkHal_WaitTick(void);
+
+/**
+ * @brief Restore the near jack lines saved by DualLinkHal_Begin()
+ */
+void DualLinkHal_End(void);
+
+#endif /* DUALLINKHAL_H */
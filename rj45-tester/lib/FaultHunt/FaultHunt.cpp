@@ -0,0 +1,62 @@
+#include "FaultHunt.h"
+
+// Public API Implementation
+
+void FaultHunt_Reset(FaultHunt_t* hunt, const WireMap_t* reference)
+{
+    hunt->reference = *reference;
+
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        hunt->lost_bits[i] = 0U;
+        hunt->extra_bits[i] = 0U;
+        hunt->glitch_count[i] = 0U;
+    }
+
+    hunt->faulty_mask = 0U;
+    hunt->latched_mask = 0U;
+    hunt->scan_count = 0U;
+}
+
+uint8_t FaultHunt_Update(FaultHunt_t* hunt, const WireMap_t* map)
+{
+    uint8_t faulty_mask = 0U;
+
+    // Kept branch-free per row, this runs thousands of times per second
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        uint8_t difference = (uint8_t)(map->rows[i] ^ hunt->reference.rows[i]);
+
+        hunt->lost_bits[i] |= (uint8_t)(difference & hunt->reference.rows[i]);
+        hunt->extra_bits[i] |= (uint8_t)(difference & map->rows[i]);
+        faulty_mask |= (uint8_t)(((difference != 0U) ? 1U : 0U) << i);
+    }
+
+    // Count each glitch once, on its first faulty scan
+    uint8_t new_glitches = (uint8_t)(faulty_mask & (uint8_t)~hunt->faulty_mask);
+    if (new_glitches != 0U)
+    {
+        for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+        {
+            if ((new_glitches & (1U << i)) && (hunt->glitch_count[i] < UINT16_MAX))
+            {
+                hunt->glitch_count[i]++;
+            }
+        }
+    }
+
+    hunt->faulty_mask = faulty_mask;
+    hunt->latched_mask |= faulty_mask;
+    hunt->scan_count++;
+
+    return new_glitches;
+}
+
+void FaultHunt_GetWorst(const FaultHunt_t* hunt, WireMap_t* worst)
+{
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        worst->rows[i] = (uint8_t)((hunt->reference.rows[i] & (uint8_t)~hunt->lost_bits[i]) |
+                                   hunt->extra_bits[i]);
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef FAULTHUNT_H
+#define FAULTHUNT_H
+
+#include <stdint.h>
+#include "WireMap.h"
+
+// Type definitions
+/**
+ * @brief Intermittent-fault tracker fed with back-to-back scans
+ * @details Every scan is compared against the reference matrix taken at the
+ *          last reset. Deviations are counted per conductor and latched
+ *          until the next reset, so a dropout that lasted a single scan
+ *          stays visible.
+ */
+typedef struct
+{
+    WireMap_t reference;                          /**< Matrix considered good, taken at reset */
+    uint8_t lost_bits[WIREMAP_CONDUCTOR_COUNT];   /**< Far pins that dropped out at least once, per conductor */
+    uint8_t extra_bits[WIREMAP_CONDUCTOR_COUNT];  /**< Far pins that appeared at least once (shorts), per conductor */
+    uint16_t glitch_count[WIREMAP_CONDUCTOR_COUNT]; /**< Transitions from good to faulty, per conductor (saturating) */
+    uint8_t faulty_mask;                          /**< Conductors deviating in the last scan */
+    uint8_t latched_mask;                         /**< Conductors that deviated since reset */
+    uint32_t scan_count;                          /**< Scans processed since reset */
+} FaultHunt_t;
+
+// Public API functions
+
+/**
+ * @brief Clear all counters and latches and take a new reference
+ * @param hunt Pointer to tracker
+ * @param reference Matrix considered good from now on
+ */
+void FaultHunt_Reset(FaultHunt_t* hunt, const WireMap_t* reference);
+
+/**
+ * @brief Compare one scan against the reference and update counters
+ * @param hunt Pointer to tracker
+ * @param map Latest scanned matrix
+ * @return uint8_t Conductors that started a new glitch with this scan
+ */
+uint8_t FaultHunt_Update(FaultHunt_t* hunt, const WireMap_t* map);
+
+/**
+ * @brief Build the worst matrix seen since reset
+ * @details Reference with every dropout removed and every extra contact added
+ * @param hunt Pointer to tracker
+ * @param worst Pointer to matrix to fill
+ */
+void FaultHunt_GetWorst(const FaultHunt_t* hunt, WireMap_t* worst);
+
+#endif /* FAULTHUNT_H */
@@ -0,0 +1,229 @@
+#include <string.h>
+#include "FlashLog.h"
+#include "FlashLogHal.h"
+#include "ResultProtocol.h"
+
+// Private constants
+#define FLASHLOG_SLOT_COUNT         (FLASHLOGHAL_SIZE / FLASHLOG_RECORD_SIZE)
+#define FLASHLOG_CRC_LENGTH         (FLASHLOG_RECORD_SIZE - 2U)
+
+// Private variables
+static FlashLogRecord_t queue[FLASHLOG_QUEUE_SIZE];
+static uint8_t queue_head = 0U;   /**< Next record to program */
+static uint8_t queue_count = 0U;
+static uint8_t head_slot = 0U;    /**< Next slot to program */
+static uint8_t ahead_erased = 0U; /**< Page after the head page is known to be erased */
+static uint32_t next_sequence = 0U;
+static uint16_t boot = 0U;
+static uint8_t valid_slots[FLASHLOG_SLOT_COUNT]; /**< Slots holding valid records, oldest first */
+static uint8_t valid_count = 0U;
+
+// Private function prototypes
+static const FlashLogRecord_t* Slot(uint8_t slot);
+static uint8_t IsValid(const FlashLogRecord_t* record);
+static uint8_t IsErased(uint16_t offset, uint16_t length);
+static void BuildIndex(void);
+static void ErasePage(uint16_t page);
+
+// Public API Implementation
+
+void FlashLog_Init(void)
+{
+    uint32_t rejected[(FLASHLOG_SLOT_COUNT + 31U) / 32U] = { 0U };
+
+    queue_head = 0U;
+    queue_count = 0U;
+    head_slot = 0U;
+    ahead_erased = 0U;
+    next_sequence = 0U;
+    boot = 0U;
+
+    // Newest by sequence word; only a torn write fails the CRC, then try the next newest
+    for (;;)
+    {
+        uint8_t newest = FLASHLOG_SLOT_COUNT;
+
+        for (uint8_t s = 0U; s < FLASHLOG_SLOT_COUNT; s++)
+        {
+            uint32_t sequence = Slot(s)->sequence;
+
+            if ((sequence != FLASHLOG_NO_SEQUENCE) && !(rejected[s / 32U] & (1UL << (s % 32U))) &&
+                ((newest == FLASHLOG_SLOT_COUNT) || (sequence > Slot(newest)->sequence)))
+            {
+                newest = s;
+            }
+        }
+
+        if (newest == FLASHLOG_SLOT_COUNT)
+        {
+            BuildIndex();
+            return;
+        }
+        if (IsValid(Slot(newest)))
+        {
+            head_slot = (uint8_t)((newest + 1U) % FLASHLOG_SLOT_COUNT);
+            next_sequence = Slot(newest)->sequence + 1U;
+            boot = (uint16_t)(Slot(newest)->boot + 1U);
+            BuildIndex();
+            return;
+        }
+        rejected[newest / 32U] |= (1UL << (newest % 32U));
+    }
+}
+
+uint8_t FlashLog_Write(const FlashLogRecord_t* record)
+{
+    if (queue_count == FLASHLOG_QUEUE_SIZE)
+    {
+        return 0U;
+    }
+
+    FlashLogRecord_t* entry = &queue[(queue_head + queue_count) % FLASHLOG_QUEUE_SIZE];
+    *entry = *record;
+    entry->sequence = next_sequence++;
+    entry->boot = boot;
+    entry->crc = ResultProtocol_Crc16((const uint8_t*)entry, FLASHLOG_CRC_LENGTH);
+    queue_count++;
+
+    return 1U;
+}
+
+void FlashLog_Task(void)
+{
+    uint16_t offset = (uint16_t)(head_slot * FLASHLOG_RECORD_SIZE);
+    uint16_t page = (uint16_t)(offset - (offset % FLASHLOGHAL_PAGE_SIZE));
+
+    if (queue_count > 0U)
+    {
+        if (!IsErased(offset, FLASHLOG_RECORD_SIZE))
+        {
+            // Only without erase-ahead: first use of the region or after a torn write
+            if (offset == page)
+            {
+                ErasePage(page);
+            }
+            else
+            {
+                head_slot = (uint8_t)(((page + FLASHLOGHAL_PAGE_SIZE) % FLASHLOGHAL_SIZE) / FLASHLOG_RECORD_SIZE);
+                ahead_erased = 0U;
+            }
+            return;
+        }
+
+        FlashLogHal_Program(offset, (const uint16_t*)&queue[queue_head], FLASHLOG_RECORD_SIZE / 2U);
+        if (IsValid(Slot(head_slot)))
+        {
+            // The head slot is newer than every indexed one
+            valid_slots[valid_count++] = head_slot;
+        }
+        queue_head = (uint8_t)((queue_head + 1U) % FLASHLOG_QUEUE_SIZE);
+        queue_count--;
+
+        uint8_t next_slot = (uint8_t)((head_slot + 1U) % FLASHLOG_SLOT_COUNT);
+        if ((next_slot * FLASHLOG_RECORD_SIZE) % FLASHLOGHAL_PAGE_SIZE == 0U)
+        {
+            // Entered a new page, the one after it is next to be erased
+            ahead_erased = 0U;
+        }
+        head_slot = next_slot;
+        return;
+    }
+
+    // Idle: erase the oldest page now rather than when a record is waiting
+    if (!ahead_erased)
+    {
+        uint16_t ahead = (uint16_t)((page + FLASHLOGHAL_PAGE_SIZE) % FLASHLOGHAL_SIZE);
+
+        if (!IsErased(ahead, FLASHLOGHAL_PAGE_SIZE))
+        {
+            ErasePage(ahead);
+        }
+        ahead_erased = 1U;
+    }
+}
+
+uint8_t FlashLog_GetCount(void)
+{
+    return valid_count;
+}
+
+uint8_t FlashLog_Read(uint8_t index, FlashLogRecord_t* record)
+{
+    if (index >= valid_count)
+    {
+        return 0U;
+    }
+
+    memcpy(record, Slot(valid_slots[index]), sizeof(*record));
+    return 1U;
+}
+
+uint16_t FlashLog_GetBoot(void)
+{
+    return boot;
+}
+
+// Private function implementations
+
+static const FlashLogRecord_t* Slot(uint8_t slot)
+{
+    return (const FlashLogRecord_t*)(FlashLogHal_GetBase() + (slot * FLASHLOG_RECORD_SIZE));
+}
+
+static uint8_t IsValid(const FlashLogRecord_t* record)
+{
+    return (record->sequence != FLASHLOG_NO_SEQUENCE) &&
+           (ResultProtocol_Crc16((const uint8_t*)record, FLASHLOG_CRC_LENGTH) == record->crc);
+}
+
+static uint8_t IsErased(uint16_t offset, uint16_t length)
+{
+    const uint32_t* word = (const uint32_t*)(FlashLogHal_GetBase() + offset);
+
+    for (uint16_t i = 0U; i < (length / 4U); i++)
+    {
+        if (word[i] != 0xFFFFFFFFUL)
+        {
+            return 0U;
+        }
+    }
+    return 1U;
+}
+
+/**
+ * @brief Index the valid slots, the only full CRC pass over the region
+ * @details Slots are programmed in ring order, so the ones after the head
+ *          hold the oldest records.
+ */
+static void BuildIndex(void)
+{
+    valid_count = 0U;
+    for (uint8_t n = 0U; n < FLASHLOG_SLOT_COUNT; n++)
+    {
+        uint8_t slot = (uint8_t)((head_slot + n) % FLASHLOG_SLOT_COUNT);
+
+        if (IsValid(Slot(slot)))
+        {
+            valid_slots[valid_count++] = slot;
+        }
+    }
+}
+
+/**
+ * @brief Erase a page and drop its slots from the index
+ */
+static void ErasePage(uint16_t page)
+{
+    uint8_t kept = 0U;
+
+    FlashLogHal_ErasePage(page);
+
+    for (uint8_t i = 0U; i < valid_count; i++)
+    {
+        if ((valid_slots[i] * FLASHLOG_RECORD_SIZE) / FLASHLOGHAL_PAGE_SIZE != page / FLASHLOGHAL_PAGE_SIZE)
+        {
+            valid_slots[kept++] = valid_slots[i];
+        }
+    }
+    valid_count = kept;
+}
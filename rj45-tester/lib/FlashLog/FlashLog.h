@@ -0,0 +1,86 @@
+#ifndef FLASHLOG_H
+#define FLASHLOG_H
+
+#include <stdint.h>
+
+// Configuration constants
+#define FLASHLOG_RECORD_SIZE        32U    /**< Bytes per record, two records per flash page */
+#define FLASHLOG_QUEUE_SIZE         4U     /**< Records waiting to be programmed */
+#define FLASHLOG_NO_SEQUENCE        0xFFFFFFFFUL /**< Sequence word of an erased slot */
+
+// Type definitions
+/**
+ * @brief What produced a history record
+ */
+typedef enum
+{
+    FLASHLOG_KIND_SCAN = 0,      /**< Cable verdict in wiremap mode */
+    FLASHLOG_KIND_HUNT,          /**< Worst state and glitch counters of a fault hunt */
+    FLASHLOG_KIND_BATCH          /**< Latched batch test verdict */
+} FlashLogKind_t;
+
+/**
+ * @brief One test result as stored in flash
+ * @details Sequence, boot and crc are filled by FlashLog_Write()
+ */
+typedef struct
+{
+    uint32_t sequence;           /**< Record number, counts up over the life of the log */
+    uint32_t time_ms;            /**< millis() when recorded */
+    uint16_t boot;               /**< Power-up count */
+    uint8_t kind;                /**< FlashLogKind_t */
+    uint8_t verdict;             /**< WireClass_t */
+    uint8_t rows[8];             /**< Connectivity matrix */
+    uint8_t glitch_count[8];     /**< Fault hunting glitches per conductor, saturating at 255 */
+    uint8_t latched_mask;        /**< Fault hunting latched conductors */
+    uint8_t reversed_pairs;      /**< Swapped pairs of a WIRECLASS_REVERSED_PAIR verdict */
+    uint16_t crc;                /**< CRC-16/CCITT-FALSE over the bytes before it */
+} FlashLogRecord_t;
+
+static_assert(sizeof(FlashLogRecord_t) == FLASHLOG_RECORD_SIZE, "FlashLogRecord_t must fill one slot");
+
+// Public API functions
+
+/**
+ * @brief Find the newest record and continue after it
+ * @details Reads one word per slot to find the newest record, then checks
+ *          every CRC once to index the valid records in order. The index
+ *          follows programming and erasing, reads never scan the region.
+ */
+void FlashLog_Init(void);
+
+/**
+ * @brief Queue a record for programming, never touches the flash
+ * @param record Record to store, sequence, boot and crc are filled in
+ * @return uint8_t 1 if queued, 0 if the queue was full and the record dropped
+ */
+uint8_t FlashLog_Write(const FlashLogRecord_t* record);
+
+/**
+ * @brief Do at most one flash operation: program a queued record or erase ahead
+ * @details The page after the newest record is erased while the queue is empty,
+ *          so programming a record never waits for an erase. Call between scans.
+ */
+void FlashLog_Task(void);
+
+/**
+ * @brief Get the number of valid records in flash
+ * @return uint8_t Number of records
+ */
+uint8_t FlashLog_GetCount(void);
+
+/**
+ * @brief Read a stored record, a copy from the slot the index points to
+ * @param index 0 for the oldest record, FlashLog_GetCount() - 1 for the newest
+ * @param record Pointer to record to fill
+ * @return uint8_t 1 if found, 0 if index is out of range
+ */
+uint8_t FlashLog_Read(uint8_t index, FlashLogRecord_t* record);
+
+/**
+ * @brief Get the power-up count of this session
+ * @return uint16_t Boot number written to new records
+ */
+uint16_t FlashLog_GetBoot(void);
+
+#endif /* FLASHLOG_H */
@@ -0,0 +1,73 @@
+#include "FlashLogHal.h"
+#include <ch32v00x.h>
+
+// Private constants
+#define HAL_FLASH_KEY1              0x45670123UL
+#define HAL_FLASH_KEY2              0xCDEF89ABUL
+#define HAL_FLASH_CTLR_PG           0x00000001UL /**< Standard half-word programming */
+#define HAL_FLASH_CTLR_STRT         0x00000040UL /**< Start erase */
+#define HAL_FLASH_CTLR_LOCK         0x00000080UL
+#define HAL_FLASH_CTLR_FLOCK        0x00008000UL /**< Fast mode lock */
+#define HAL_FLASH_CTLR_FTER         0x00020000UL /**< Fast 64-byte page erase */
+#define HAL_FLASH_STATR_BSY         0x00000001UL
+#define HAL_FLASH_STATR_EOP         0x00000020UL
+
+// Private function prototypes
+static void Unlock(void);
+static void WaitReady(void);
+
+// Public API Implementation
+
+const uint8_t* FlashLogHal_GetBase(void)
+{
+    return (const uint8_t*)FLASHLOGHAL_BASE;
+}
+
+void FlashLogHal_ErasePage(uint16_t offset)
+{
+    Unlock();
+
+    FLASH->CTLR |= HAL_FLASH_CTLR_FTER;
+    FLASH->ADDR = FLASHLOGHAL_BASE + offset;
+    FLASH->CTLR |= HAL_FLASH_CTLR_STRT;
+    WaitReady();
+    FLASH->CTLR &= ~HAL_FLASH_CTLR_FTER;
+
+    FLASH->CTLR |= HAL_FLASH_CTLR_LOCK | HAL_FLASH_CTLR_FLOCK;
+}
+
+void FlashLogHal_Program(uint16_t offset, const uint16_t* data, uint8_t count)
+{
+    volatile uint16_t* target = (volatile uint16_t*)(FLASHLOGHAL_BASE + offset);
+
+    Unlock();
+
+    FLASH->CTLR |= HAL_FLASH_CTLR_PG;
+    for (uint8_t i = 0U; i < count; i++)
+    {
+        target[i] = data[i];
+        WaitReady();
+    }
+    FLASH->CTLR &= ~HAL_FLASH_CTLR_PG;
+
+    FLASH->CTLR |= HAL_FLASH_CTLR_LOCK | HAL_FLASH_CTLR_FLOCK;
+}
+
+// Private function implementations
+
+static void Unlock(void)
+{
+    // Standard unlock, then the fast mode unlock needed for 64-byte erases
+    FLASH->KEYR = HAL_FLASH_KEY1;
+    FLASH->KEYR = HAL_FLASH_KEY2;
+    FLASH->MODEKEYR = HAL_FLASH_KEY1;
+    FLASH->MODEKEYR = HAL_FLASH_KEY2;
+}
+
+static void WaitReady(void)
+{
+    while (FLASH->STATR & HAL_FLASH_STATR_BSY)
+    {
+    }
+    FLASH->STATR = HAL_FLASH_STATR_EOP;
+}
@@ -0,0 +1,39 @@
+#ifndef FLASHLOGHAL_H
+#define FLASHLOGHAL_H
+
+#include <stdint.h>
+
+/**
+ * @file FlashLogHal.h
+ * @brief Flash access used by the FlashLog ring
+ * @details The log region is the last FLASHLOGHAL_SIZE bytes of the 16 KB
+ *          code flash, kept free of code by board_upload.maximum_size in
+ *          platformio.ini. Both operations stall the CPU until the flash is
+ *          done, so call them between scans.
+ */
+
+#define FLASHLOGHAL_BASE            0x08003C00UL /**< Start of the log region */
+#define FLASHLOGHAL_SIZE            1024U  /**< Log region size in bytes */
+#define FLASHLOGHAL_PAGE_SIZE       64U    /**< Fast erase page size */
+
+/**
+ * @brief Get the memory-mapped log region for reading
+ * @return const uint8_t* First byte of the region
+ */
+const uint8_t* FlashLogHal_GetBase(void);
+
+/**
+ * @brief Erase one 64-byte page to 0xFF
+ * @param offset Page offset within the region, multiple of FLASHLOGHAL_PAGE_SIZE
+ */
+void FlashLogHal_ErasePage(uint16_t offset);
+
+/**
+ * @brief Program erased flash one half-word at a time
+ * @param offset Offset within the region, even
+ * @param data Half-words to write
+ * @param count Number of half-words
+ */
+void FlashLogHal_Program(uint16_t offset, const uint16_t* data, uint8_t count);
+
+#endif /* FLASHLOGHAL_H */
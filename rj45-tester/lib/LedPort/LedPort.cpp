@@ -0,0 +1,92 @@
+#include "LedPort.h"
+#include "Board.h"
+#include "BoardHal.h"
+
+// Private constants
+#define LEDPORT_NIBBLE_VALUES       16U    /**< Entries per nibble lookup table */
+
+static constexpr BoardPin_t led_pins[BOARD_CONDUCTOR_COUNT] = BOARD_DRIVE_PINS;
+
+/**
+ * @brief Port bits lit by a pattern on one port, evaluated at compile time
+ * @param pattern LED pattern, bit N for conductor N
+ * @param port Port index
+ * @param led First LED to consider (recursion index)
+ * @return uint8_t Output bits of the port for this pattern
+ */
+static constexpr uint8_t PortBits(uint8_t pattern, uint8_t port, uint8_t led = 0U)
+{
+    return (led >= BOARD_CONDUCTOR_COUNT) ? 0U :
+           (uint8_t)(((((pattern >> led) & 1U) != 0U) && (led_pins[led].port == port) ?
+                      (1U << led_pins[led].pin) : 0U) |
+                     PortBits(pattern, port, (uint8_t)(led + 1U)));
+}
+
+// One row of port bits for the 16 values of one pattern nibble
+#define NIBBLE_ROW(port, shift)                                                     \
+    {                                                                               \
+        PortBits(0x0U << (shift), (port)), PortBits(0x1U << (shift), (port)),       \
+        PortBits(0x2U << (shift), (port)), PortBits(0x3U << (shift), (port)),       \
+        PortBits(0x4U << (shift), (port)), PortBits(0x5U << (shift), (port)),       \
+        PortBits(0x6U << (shift), (port)), PortBits(0x7U << (shift), (port)),       \
+        PortBits(0x8U << (shift), (port)), PortBits(0x9U << (shift), (port)),       \
+        PortBits(0xAU << (shift), (port)), PortBits(0xBU << (shift), (port)),       \
+        PortBits(0xCU << (shift), (port)), PortBits(0xDU << (shift), (port)),       \
+        PortBits(0xEU << (shift), (port)), PortBits(0xFU << (shift), (port))        \
+    }
+
+// Compile-time set masks per port for the low and high pattern nibble
+static constexpr uint8_t low_nibble_bits[BOARD_PORT_COUNT][LEDPORT_NIBBLE_VALUES] =
+{
+    NIBBLE_ROW(BOARD_PORT_A, 0U), NIBBLE_ROW(BOARD_PORT_C, 0U), NIBBLE_ROW(BOARD_PORT_D, 0U)
+};
+static constexpr uint8_t high_nibble_bits[BOARD_PORT_COUNT][LEDPORT_NIBBLE_VALUES] =
+{
+    NIBBLE_ROW(BOARD_PORT_A, 4U), NIBBLE_ROW(BOARD_PORT_C, 4U), NIBBLE_ROW(BOARD_PORT_D, 4U)
+};
+
+// All LED bits of each port, used as reset mask
+static constexpr uint8_t port_led_mask[BOARD_PORT_COUNT] =
+{
+    PortBits(0xFFU, BOARD_PORT_A), PortBits(0xFFU, BOARD_PORT_C), PortBits(0xFFU, BOARD_PORT_D)
+};
+
+static_assert((port_led_mask[BOARD_PORT_A] | port_led_mask[BOARD_PORT_C] | port_led_mask[BOARD_PORT_D]) != 0U,
+              "BOARD_DRIVE_PINS must map LEDs to GPIO ports");
+
+static GPIO_TypeDef* const gpio_ports[BOARD_PORT_COUNT] = BOARD_GPIO_PORTS;
+
+// Private function prototypes
+static inline void WritePort(uint8_t port, uint8_t pattern);
+
+// Public API Implementation
+
+void LedPort_Init(void)
+{
+    RCC->APB2PCENR |= RCC_APB2Periph_GPIOA | RCC_APB2Periph_GPIOC | RCC_APB2Periph_GPIOD;
+
+    for (uint8_t p = 0U; p < BOARD_PORT_COUNT; p++)
+    {
+        gpio_ports[p]->BCR = port_led_mask[p];
+        BoardHal_ConfigurePort(p, port_led_mask[p], BOARD_GPIO_CFG_OUTPUT_PP);
+    }
+}
+
+void LedPort_Write(uint8_t pattern)
+{
+    WritePort(BOARD_PORT_A, pattern);
+    WritePort(BOARD_PORT_C, pattern);
+    WritePort(BOARD_PORT_D, pattern);
+}
+
+// Private function implementations
+
+static inline void WritePort(uint8_t port, uint8_t pattern)
+{
+    uint32_t set_bits = (uint32_t)low_nibble_bits[port][pattern & 0x0FU] |
+                        (uint32_t)high_nibble_bits[port][pattern >> 4];
+    uint32_t reset_bits = (uint32_t)port_led_mask[port] & ~set_bits;
+
+    // Low half sets, high half resets, in a single write
+    gpio_ports[port]->BSHR = set_bits | (reset_bits << 16);
+}
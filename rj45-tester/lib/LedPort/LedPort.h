@@ -0,0 +1,22 @@
+#ifndef LEDPORT_H
+#define LEDPORT_H
+
+#include <stdint.h>
+
+// Public API functions
+
+/**
+ * @brief Configure all LED pins as push-pull outputs, all LEDs off
+ */
+void LedPort_Init(void);
+
+/**
+ * @brief Show an LED pattern with one BSHR write per GPIO port
+ * @details The per-port set/reset masks come from compile-time tables built
+ *          from BOARD_DRIVE_PINS, so any pattern, including all 8 LEDs at once,
+ *          costs two table lookups and one register write per port.
+ * @param pattern Bit N set lights the LED of conductor N (RJ45 pin N + 1)
+ */
+void LedPort_Write(uint8_t pattern);
+
+#endif /* LEDPORT_H */
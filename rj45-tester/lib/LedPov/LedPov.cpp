@@ -0,0 +1,110 @@
+#include "LedPov.h"
+#include "LedPort.h"
+#include "Board.h"
+
+// Private constants
+#define LEDPOV_TIMER_CLOCK_HZ       1000000UL /**< TIM2 counter clock after prescaler */
+#define LEDPOV_PHASE_SHIFT          9U        /**< Refresh ticks per blink phase = 1 << shift */
+
+// Private variables
+static LedPovStyle_t styles[BOARD_CONDUCTOR_COUNT];
+static uint8_t frames[2][LEDPOV_BLINK_PHASES][LEDPOV_DUTY_STEPS]; /**< Front and back framebuffer */
+static volatile uint8_t front = 0U;
+static volatile uint16_t tick = 0U;
+
+// Private function prototypes
+extern "C" void TIM2_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
+static uint8_t IsLit(LedPovStyle_t style, uint8_t phase, uint8_t step);
+
+// Public API Implementation
+
+void LedPov_Init(void)
+{
+    for (uint8_t i = 0U; i < BOARD_CONDUCTOR_COUNT; i++)
+    {
+        styles[i] = LEDPOV_OFF;
+    }
+    LedPov_Commit();
+
+    RCC->APB1PCENR |= RCC_APB1Periph_TIM2;
+
+    TIM2->CTLR1 = 0U;
+    TIM2->PSC = (uint16_t)((SystemCoreClock / LEDPOV_TIMER_CLOCK_HZ) - 1U);
+    TIM2->ATRLR = (uint16_t)((LEDPOV_TIMER_CLOCK_HZ / LEDPOV_REFRESH_HZ) - 1U);
+    TIM2->SWEVGR = TIM_UG;
+    TIM2->INTFR = 0U;
+    TIM2->DMAINTENR = TIM_UIE;
+
+    NVIC_EnableIRQ(TIM2_IRQn);
+    TIM2->CTLR1 = TIM_CEN;
+}
+
+void LedPov_SetLed(uint8_t led, LedPovStyle_t style)
+{
+    if (led < BOARD_CONDUCTOR_COUNT)
+    {
+        styles[led] = style;
+    }
+}
+
+void LedPov_Commit(void)
+{
+    uint8_t back = (uint8_t)(front ^ 1U);
+
+    for (uint8_t phase = 0U; phase < LEDPOV_BLINK_PHASES; phase++)
+    {
+        for (uint8_t step = 0U; step < LEDPOV_DUTY_STEPS; step++)
+        {
+            uint8_t pattern = 0U;
+            for (uint8_t i = 0U; i < BOARD_CONDUCTOR_COUNT; i++)
+            {
+                pattern |= (uint8_t)(IsLit(styles[i], phase, step) << i);
+            }
+            frames[back][phase][step] = pattern;
+        }
+    }
+
+    // Single byte store, the interrupt sees either the old or the new frame set
+    front = back;
+}
+
+void LedPov_Suspend(void)
+{
+    TIM2->DMAINTENR = 0U;
+}
+
+void LedPov_Resume(void)
+{
+    // A pending update flag fires the interrupt right away
+    TIM2->DMAINTENR = TIM_UIE;
+}
+
+// Private function implementations
+
+static uint8_t IsLit(LedPovStyle_t style, uint8_t phase, uint8_t step)
+{
+    switch (style)
+    {
+        case LEDPOV_ON:
+            return 1U;
+        case LEDPOV_DIM:
+            return (step == 0U) ? 1U : 0U;
+        case LEDPOV_BLINK_FAST:
+            return ((phase & 1U) == 0U) ? 1U : 0U;
+        case LEDPOV_BLINK_SLOW:
+            return (phase < (LEDPOV_BLINK_PHASES / 2U)) ? 1U : 0U;
+        default:
+            return 0U;
+    }
+}
+
+void TIM2_IRQHandler(void)
+{
+    TIM2->INTFR = (uint16_t)~TIM_UIF;
+
+    uint16_t t = tick;
+    tick = (uint16_t)(t + 1U);
+
+    LedPort_Write(frames[front][(t >> LEDPOV_PHASE_SHIFT) & (LEDPOV_BLINK_PHASES - 1U)]
+                               [t & (LEDPOV_DUTY_STEPS - 1U)]);
+}
@@ -0,0 +1,59 @@
+#ifndef LEDPOV_H
+#define LEDPOV_H
+
+#include <stdint.h>
+
+// Configuration constants
+#define LEDPOV_REFRESH_HZ           2000U  /**< TIM2 update rate, one duty step per interrupt */
+#define LEDPOV_DUTY_STEPS           8U     /**< Duty steps per PWM period (250 Hz at 2 kHz refresh) */
+#define LEDPOV_BLINK_PHASES         4U     /**< Blink phases, each 512 refresh ticks (256 ms) long */
+
+// Type definitions
+/**
+ * @brief Appearance of one LED
+ */
+typedef enum
+{
+    LEDPOV_OFF = 0,              /**< Dark */
+    LEDPOV_ON,                   /**< Full brightness */
+    LEDPOV_DIM,                  /**< 1/8 duty, clearly lit but faint */
+    LEDPOV_BLINK_FAST,           /**< Full brightness, 2 Hz blink */
+    LEDPOV_BLINK_SLOW            /**< Full brightness, 1 Hz blink */
+} LedPovStyle_t;
+
+// Public API functions
+
+/**
+ * @brief Start the TIM2 refresh interrupt with all LEDs off
+ * @details LedPort_Init() must have configured the LED pins. TIM2 is owned by
+ *          this module and must not be used through the core HardwareTimer.
+ */
+void LedPov_Init(void);
+
+/**
+ * @brief Set the appearance of one LED in the back buffer
+ * @param led LED index (conductor 0-7)
+ * @param style Appearance
+ */
+void LedPov_SetLed(uint8_t led, LedPovStyle_t style);
+
+/**
+ * @brief Render the back buffer and show it from the next refresh tick on
+ * @details Builds all duty/blink frames once, so the interrupt only does a
+ *          table lookup and one LedPort_Write()
+ */
+void LedPov_Commit(void);
+
+/**
+ * @brief Stop LED writes from the refresh interrupt
+ * @details Call before the drive lines are used for a wiremap scan. A tick
+ *          that falls inside the pause is delayed, not lost.
+ */
+void LedPov_Suspend(void);
+
+/**
+ * @brief Allow LED writes from the refresh interrupt again
+ */
+void LedPov_Resume(void);
+
+#endif /* LEDPOV_H */
@@ -0,0 +1,103 @@
+#include "PanelScan.h"
+#include "PanelScanHal.h"
+
+// Private variables
+static uint8_t drive_buffer[PANELSCAN_PORT_COUNT]; /**< DMA source, must outlive the exchange */
+static uint8_t sense_buffer[PANELSCAN_PORT_COUNT]; /**< DMA destination */
+
+// Private function prototypes
+static void FillDrive(uint8_t probe);
+static void StoreSense(PanelMap_t* panel, uint8_t probe);
+
+// Public API Implementation
+
+void PanelScan_Init(void)
+{
+    PanelScanHal_Init();
+
+    // Shift in an all-released pattern, the registers power up undefined
+    for (uint8_t p = 0U; p < PANELSCAN_PORT_COUNT; p++)
+    {
+        drive_buffer[p] = 0U;
+    }
+    PanelScanHal_Exchange(drive_buffer, sense_buffer, PANELSCAN_PORT_COUNT);
+}
+
+void PanelScan_Scan(PanelMap_t* panel)
+{
+    for (uint8_t p = 0U; p < PANELSCAN_PORT_COUNT; p++)
+    {
+        panel->foreign_mask[p] = 0U;
+    }
+
+    // The chains are pipelined: each exchange returns the previous probe
+    for (uint8_t probe = 0U; probe < PANELSCAN_EXCHANGES; probe++)
+    {
+        FillDrive(probe);
+        PanelScanHal_Exchange(drive_buffer, sense_buffer, PANELSCAN_PORT_COUNT);
+        if (probe > 0U)
+        {
+            StoreSense(panel, (uint8_t)(probe - 1U));
+        }
+    }
+
+    // Open conductors read 0 in every identity probe, they are already in the matrix
+    for (uint8_t p = 0U; p < PANELSCAN_PORT_COUNT; p++)
+    {
+        uint8_t reached = 0U;
+
+        for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+        {
+            reached |= panel->maps[p].rows[i];
+        }
+        panel->foreign_mask[p] &= reached;
+    }
+}
+
+// Private function implementations
+
+static void FillDrive(uint8_t probe)
+{
+    if (probe < WIREMAP_CONDUCTOR_COUNT)
+    {
+        // Same conductor on every port
+        uint8_t pattern = (uint8_t)(1U << probe);
+
+        for (uint8_t p = 0U; p < PANELSCAN_PORT_COUNT; p++)
+        {
+            drive_buffer[p] = pattern;
+        }
+        return;
+    }
+
+    uint8_t bit = (uint8_t)(probe - WIREMAP_CONDUCTOR_COUNT);
+    for (uint8_t p = 0U; p < PANELSCAN_PORT_COUNT; p++)
+    {
+        // Port codes start at 1, so every port is driven in at least one probe.
+        // The last exchange only reads back and drives nothing.
+        uint8_t code = (uint8_t)(p + 1U);
+        drive_buffer[p] = ((bit < PANELSCAN_ID_PROBES) && ((code >> bit) & 1U)) ? 0xFFU : 0x00U;
+    }
+}
+
+static void StoreSense(PanelMap_t* panel, uint8_t probe)
+{
+    if (probe < WIREMAP_CONDUCTOR_COUNT)
+    {
+        for (uint8_t p = 0U; p < PANELSCAN_PORT_COUNT; p++)
+        {
+            panel->maps[p].rows[probe] = sense_buffer[p];
+        }
+        return;
+    }
+
+    // Every far conductor of a port must carry the code of that same port
+    uint8_t bit = (uint8_t)(probe - WIREMAP_CONDUCTOR_COUNT);
+    for (uint8_t p = 0U; p < PANELSCAN_PORT_COUNT; p++)
+    {
+        uint8_t code = (uint8_t)(p + 1U);
+        uint8_t expected = ((code >> bit) & 1U) ? 0xFFU : 0x00U;
+
+        panel->foreign_mask[p] |= (uint8_t)(sense_buffer[p] ^ expected);
+    }
+}
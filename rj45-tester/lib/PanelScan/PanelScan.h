@@ -0,0 +1,65 @@
+#ifndef PANELSCAN_H
+#define PANELSCAN_H
+
+#include <stdint.h>
+#include "WireMap.h"
+
+// Configuration constants
+#ifndef PANELSCAN_PORT_COUNT
+#define PANELSCAN_PORT_COUNT        24U    /**< Panel ports, one 74HC595 and one 74HC165 each */
+#endif
+// A PanelMap_t takes 9 bytes per port, 48 ports fit the 2 KB of the CH32V003
+
+#if (PANELSCAN_PORT_COUNT == 0U) || (PANELSCAN_PORT_COUNT > 255U)
+#error "PANELSCAN_PORT_COUNT must be between 1 and 255"
+#endif
+
+/**
+ * @brief Identity probes needed to give every port a distinct non-zero code
+ */
+#define PANELSCAN_ID_PROBES                     \
+    ((PANELSCAN_PORT_COUNT < 2U)   ? 1U :       \
+     (PANELSCAN_PORT_COUNT < 4U)   ? 2U :       \
+     (PANELSCAN_PORT_COUNT < 8U)   ? 3U :       \
+     (PANELSCAN_PORT_COUNT < 16U)  ? 4U :       \
+     (PANELSCAN_PORT_COUNT < 32U)  ? 5U :       \
+     (PANELSCAN_PORT_COUNT < 64U)  ? 6U :       \
+     (PANELSCAN_PORT_COUNT < 128U) ? 7U : 8U)
+
+/**
+ * @brief Chain exchanges per panel scan: conductor probes, identity probes and one to read back
+ */
+#define PANELSCAN_EXCHANGES         (WIREMAP_CONDUCTOR_COUNT + PANELSCAN_ID_PROBES + 1U)
+
+// Type definitions
+/**
+ * @brief Scan result of a whole patch panel
+ * @details maps[N] is the connectivity matrix of port N as if it were a single
+ *          cable. Wires that land on another port show up in foreign_mask of
+ *          the far port they reach, since their own row in maps stays empty.
+ */
+typedef struct
+{
+    WireMap_t maps[PANELSCAN_PORT_COUNT];             /**< Matrix per port */
+    uint8_t foreign_mask[PANELSCAN_PORT_COUNT];       /**< Far conductors reached from another port */
+} PanelMap_t;
+
+// Public API functions
+
+/**
+ * @brief Initialize the register chains, all conductors released
+ */
+void PanelScan_Init(void);
+
+/**
+ * @brief Scan every port of the panel
+ * @details Conductor N of all ports is driven at once, so the 8 matrix rows of
+ *          every port take 8 chain exchanges whatever the port count. Each
+ *          port then gets a binary code of PANELSCAN_ID_PROBES bits, driven on
+ *          all its conductors one bit per exchange, which catches wires that
+ *          end up on another port. Cost per port is one byte per exchange.
+ * @param panel Pointer to result to fill
+ */
+void PanelScan_Scan(PanelMap_t* panel);
+
+#endif /* PANELSCAN_H */
@@ -0,0 +1,85 @@
+#include "PanelScanHal.h"
+#include "Board.h"
+#include "BoardHal.h"
+
+// Private constants
+#define HAL_SETTLE_LOOPS            24U    /**< Busy loops for latched drive lines to reach the far side (~2 us) */
+#define HAL_SPI_PRESCALER           SPI_BaudRatePrescaler_4 /**< 12 MHz SCK at 48 MHz HCLK */
+
+static const BoardPin_t latch_pin = BOARD_PANEL_LATCH_PIN;
+static const BoardPin_t load_pin = BOARD_PANEL_LOAD_PIN;
+static const BoardPin_t sck_pin = { BOARD_PORT_C, 5U };
+static const BoardPin_t mosi_pin = { BOARD_PORT_C, 6U };
+static const BoardPin_t miso_pin = { BOARD_PORT_C, 7U };
+static GPIO_TypeDef* const gpio_ports[BOARD_PORT_COUNT] = BOARD_GPIO_PORTS;
+
+// Private function prototypes
+static void SettleDelay(uint32_t loops);
+
+// Public API Implementation
+
+void PanelScanHal_Init(void)
+{
+    RCC->APB2PCENR |= RCC_APB2Periph_GPIOC | RCC_APB2Periph_GPIOD | RCC_APB2Periph_SPI1;
+    RCC->AHBPCENR |= RCC_AHBPeriph_DMA1;
+
+    // RCLK idles low, SH/LD idles high (shift mode)
+    gpio_ports[latch_pin.port]->BCR = 1UL << latch_pin.pin;
+    gpio_ports[load_pin.port]->BSHR = 1UL << load_pin.pin;
+    BoardHal_ConfigurePin(&latch_pin, BOARD_GPIO_CFG_OUTPUT_PP);
+    BoardHal_ConfigurePin(&load_pin, BOARD_GPIO_CFG_OUTPUT_PP);
+
+    BoardHal_ConfigurePin(&sck_pin, BOARD_GPIO_CFG_AF_PP);
+    BoardHal_ConfigurePin(&mosi_pin, BOARD_GPIO_CFG_AF_PP);
+    BoardHal_ConfigurePin(&miso_pin, BOARD_GPIO_CFG_INPUT_FLOAT);
+
+    // Mode 0, MSB first: bit 7 ends in QH of the 595 and comes from H of the 165
+    SPI1->CTLR1 = SPI_Mode_Master | SPI_NSS_Soft | HAL_SPI_PRESCALER;
+    SPI1->CTLR2 = SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx;
+    SPI1->CTLR1 |= SPI_CTLR1_SPE;
+
+    DMA1_Channel2->CFGR = 0U;
+    DMA1_Channel2->PADDR = (uint32_t)(uintptr_t)&SPI1->DATAR;
+    DMA1_Channel3->CFGR = 0U;
+    DMA1_Channel3->PADDR = (uint32_t)(uintptr_t)&SPI1->DATAR;
+}
+
+void PanelScanHal_Exchange(const uint8_t* drive, uint8_t* sense, uint16_t length)
+{
+    // Receive first, so no byte can arrive before its channel is armed
+    DMA1->INTFCR = DMA1_IT_GL2 | DMA1_IT_GL3;
+    DMA1_Channel2->MADDR = (uint32_t)(uintptr_t)sense;
+    DMA1_Channel2->CNTR = length;
+    DMA1_Channel2->CFGR = DMA_MemoryInc_Enable | DMA_CFGR1_EN;
+    DMA1_Channel3->MADDR = (uint32_t)(uintptr_t)drive;
+    DMA1_Channel3->CNTR = length;
+    DMA1_Channel3->CFGR = DMA_DIR_PeripheralDST | DMA_MemoryInc_Enable | DMA_CFGR1_EN;
+
+    // The last received byte completes the burst, the CPU does nothing per byte
+    while ((DMA1->INTFR & DMA1_FLAG_TC2) == 0U)
+    {
+    }
+    DMA1_Channel2->CFGR = 0U;
+    DMA1_Channel3->CFGR = 0U;
+
+    GPIO_TypeDef* latch_port = gpio_ports[latch_pin.port];
+    GPIO_TypeDef* load_port = gpio_ports[load_pin.port];
+
+    // Present the new pattern, then capture the far side for the next exchange
+    latch_port->BSHR = 1UL << latch_pin.pin;
+    latch_port->BCR = 1UL << latch_pin.pin;
+    SettleDelay(HAL_SETTLE_LOOPS);
+    load_port->BCR = 1UL << load_pin.pin;
+    load_port->BSHR = 1UL << load_pin.pin;
+}
+
+// Private function implementations
+
+static void SettleDelay(uint32_t loops)
+{
+    while (loops > 0U)
+    {
+        __asm__ volatile ("nop");
+        loops--;
+    }
+}
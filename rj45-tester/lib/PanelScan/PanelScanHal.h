@@ -0,0 +1,32 @@
+#ifndef PANELSCANHAL_H
+#define PANELSCANHAL_H
+
+#include <stdint.h>
+
+/**
+ * @file PanelScanHal.h
+ * @brief Shift-register chain access used by the PanelScan engine
+ * @details Implemented for the panel front end in PanelScanHal.cpp. The host
+ *          benchmark in tools/panel-scan-bench.cpp models the chains and a
+ *          wired patch panel instead.
+ */
+
+/**
+ * @brief Configure SPI1, its DMA channels and the latch and load lines
+ */
+void PanelScanHal_Init(void);
+
+/**
+ * @brief Exchange one byte per port with both register chains
+ * @details Shifts drive into the 74HC595 chain while shifting out what the
+ *          74HC165 chain captured at the end of the previous exchange, then
+ *          latches drive onto the near jacks, lets the far side settle and
+ *          captures it for the next exchange. Both directions run by DMA in
+ *          one full-duplex burst.
+ * @param drive Conductors to drive high, byte N for port N
+ * @param sense Far side levels seen during the previous exchange, byte N for port N
+ * @param length Number of ports in the chains
+ */
+void PanelScanHal_Exchange(const uint8_t* drive, uint8_t* sense, uint16_t length);
+
+#endif /* PANELSCANHAL_H */
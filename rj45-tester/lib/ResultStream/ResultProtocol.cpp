@@ -0,0 +1,109 @@
+#include "ResultProtocol.h"
+
+// Public API Implementation
+
+uint16_t ResultProtocol_Crc16(const uint8_t* data, size_t length)
+{
+    uint16_t crc = 0xFFFFU;
+
+    for (size_t i = 0U; i < length; i++)
+    {
+        crc ^= (uint16_t)((uint16_t)data[i] << 8);
+        for (uint8_t bit = 0U; bit < 8U; bit++)
+        {
+            crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+size_t ResultProtocol_CobsEncode(const uint8_t* src, size_t length, uint8_t* dst)
+{
+    size_t code_index = 0U;
+    size_t out = 1U;
+    uint8_t code = 1U;
+
+    for (size_t i = 0U; i < length; i++)
+    {
+        if (src[i] == 0U)
+        {
+            dst[code_index] = code;
+            code_index = out++;
+            code = 1U;
+        }
+        else
+        {
+            dst[out++] = src[i];
+            code++;
+            if (code == 0xFFU)
+            {
+                dst[code_index] = code;
+                code_index = out++;
+                code = 1U;
+            }
+        }
+    }
+
+    dst[code_index] = code;
+    dst[out++] = RESULTPROTOCOL_DELIMITER;
+
+    return out;
+}
+
+size_t ResultProtocol_CobsDecode(const uint8_t* src, size_t length, uint8_t* dst)
+{
+    size_t in = 0U;
+    size_t out = 0U;
+
+    while (in < length)
+    {
+        uint8_t code = src[in++];
+        if ((code == 0U) || ((size_t)(in + code - 1U) > length))
+        {
+            return 0U;
+        }
+
+        for (uint8_t i = 1U; i < code; i++)
+        {
+            if (src[in] == 0U)
+            {
+                return 0U;
+            }
+            dst[out++] = src[in++];
+        }
+
+        // A block shorter than 254 data bytes stands for a zero, except at the end
+        if ((code != 0xFFU) && (in < length))
+        {
+            dst[out++] = 0U;
+        }
+    }
+
+    return out;
+}
+
+void ResultProtocol_PutU16(uint8_t* dst, uint16_t value)
+{
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8);
+}
+
+void ResultProtocol_PutU32(uint8_t* dst, uint32_t value)
+{
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8);
+    dst[2] = (uint8_t)(value >> 16);
+    dst[3] = (uint8_t)(value >> 24);
+}
+
+uint16_t ResultProtocol_GetU16(const uint8_t* src)
+{
+    return (uint16_t)(src[0] | ((uint16_t)src[1] << 8));
+}
+
+uint32_t ResultProtocol_GetU32(const uint8_t* src)
+{
+    return (uint32_t)src[0] | ((uint32_t)src[1] << 8) |
+           ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+}
@@ -0,0 +1,87 @@
+#ifndef RESULTPROTOCOL_H
+#define RESULTPROTOCOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file ResultProtocol.h
+ * @brief Binary result frame format, shared by the firmware and tools/rj45-decode
+ * @details A frame is COBS encoded and terminated by a single 0x00 byte:
+ *
+ *          | type u8 | seq u16 | timestamp_ms u32 | body | crc u16 |
+ *
+ *          All fields are little endian. The CRC is CRC-16/CCITT-FALSE over
+ *          everything before it. The sequence number counts every frame the
+ *          firmware produced, including frames dropped because the transmit
+ *          buffer was full, so a gap on the host side is a lost frame.
+ */
+
+// Frame types
+#define RESULTPROTOCOL_TYPE_SCAN    0x01U  /**< One scan with its verdict */
+#define RESULTPROTOCOL_TYPE_HUNT    0x02U  /**< Fault hunting counters */
+#define RESULTPROTOCOL_TYPE_BATCH   0x03U  /**< Batch test verdict and session counters */
+#define RESULTPROTOCOL_TYPE_LOG     0x04U  /**< Log record, formatted on the host */
+#define RESULTPROTOCOL_TYPE_HISTORY 0x05U  /**< Stored test record from the flash history */
+
+// Frame layout
+#define RESULTPROTOCOL_HEADER_SIZE  7U     /**< type + seq + timestamp */
+#define RESULTPROTOCOL_CRC_SIZE     2U
+#define RESULTPROTOCOL_SCAN_BODY    10U    /**< rows[8], verdict, reversed_pairs */
+#define RESULTPROTOCOL_HUNT_BODY    21U    /**< scan_count u32, latched_mask, glitch_count[8] u16 */
+#define RESULTPROTOCOL_BATCH_BODY   16U    /**< tested, passed, failed u16, state, verdict, ttv_ms u16, median_ms u16, cables_per_hour u32 */
+#define RESULTPROTOCOL_LOG_MAX_ARGS 2U     /**< Log body: format id, then up to 2 u32 arguments */
+#define RESULTPROTOCOL_HISTORY_BODY 30U    /**< sequence u32, time_ms u32, boot u16, kind, verdict, rows[8], glitch_count[8], latched_mask, reversed_pairs */
+#define RESULTPROTOCOL_MAX_PAYLOAD  (RESULTPROTOCOL_HEADER_SIZE + RESULTPROTOCOL_HISTORY_BODY + RESULTPROTOCOL_CRC_SIZE)
+#define RESULTPROTOCOL_MAX_ENCODED  (RESULTPROTOCOL_MAX_PAYLOAD + (RESULTPROTOCOL_MAX_PAYLOAD / 254U) + 2U) /**< Including delimiter */
+#define RESULTPROTOCOL_DELIMITER    0x00U
+
+// Public API functions
+
+/**
+ * @brief CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+ * @param data Bytes to check
+ * @param length Number of bytes
+ * @return uint16_t CRC value
+ */
+uint16_t ResultProtocol_Crc16(const uint8_t* data, size_t length);
+
+/**
+ * @brief COBS encode a payload and append the frame delimiter
+ * @param src Payload
+ * @param length Payload length (at most 254 bytes)
+ * @param dst Output buffer, at least length + 2 bytes
+ * @return size_t Encoded length including the delimiter
+ */
+size_t ResultProtocol_CobsEncode(const uint8_t* src, size_t length, uint8_t* dst);
+
+/**
+ * @brief COBS decode one frame without its delimiter
+ * @param src Encoded bytes
+ * @param length Encoded length
+ * @param dst Output buffer, at least length bytes
+ * @return size_t Decoded length, 0 if the encoding is invalid
+ */
+size_t ResultProtocol_CobsDecode(const uint8_t* src, size_t length, uint8_t* dst);
+
+/**
+ * @brief Store a little-endian 16-bit value
+ */
+void ResultProtocol_PutU16(uint8_t* dst, uint16_t value);
+
+/**
+ * @brief Store a little-endian 32-bit value
+ */
+void ResultProtocol_PutU32(uint8_t* dst, uint32_t value);
+
+/**
+ * @brief Load a little-endian 16-bit value
+ */
+uint16_t ResultProtocol_GetU16(const uint8_t* src);
+
+/**
+ * @brief Load a little-endian 32-bit value
+ */
+uint32_t ResultProtocol_GetU32(const uint8_t* src);
+
+#endif /* RESULTPROTOCOL_H */
@@ -0,0 +1,218 @@
+#include <Arduino.h>
+#include "ResultStream.h"
+#include "ResultProtocol.h"
+
+// Private variables
+static uint8_t tx_buffer[RESULTSTREAM_BUFFER_SIZE];
+static volatile uint16_t tx_head = 0U;    /**< Next byte to write, main loop only */
+static volatile uint16_t tx_tail = 0U;    /**< Next byte to send, DMA interrupt only once running */
+static volatile uint16_t tx_in_flight = 0U; /**< Bytes of the running DMA transfer, 0 when idle */
+static uint16_t sequence = 0U;
+static uint32_t dropped_count = 0U;
+
+// Private function prototypes
+extern "C" void DMA1_Channel4_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
+static uint8_t SendFrame(uint8_t* payload, uint8_t body_length);
+static void WriteHeader(uint8_t* payload, uint8_t type, uint32_t timestamp_ms);
+static void StartTransfer(void);
+
+// Public API Implementation
+
+void ResultStream_Init(void)
+{
+    RCC->AHBPCENR |= RCC_AHBPeriph_DMA1;
+
+    DMA1_Channel4->CFGR = 0U;
+    DMA1_Channel4->PADDR = (uint32_t)(uintptr_t)&USART1->DATAR;
+    DMA1->INTFCR = DMA1_IT_GL4;
+    NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+
+    // The UART requests a byte whenever its data register is empty
+    USART1->CTLR3 |= USART_DMAReq_Tx;
+}
+
+uint8_t ResultStream_SendScan(const WireMap_t* map, WireClass_t verdict, uint8_t reversed_pairs)
+{
+    uint8_t payload[RESULTPROTOCOL_MAX_PAYLOAD];
+    uint8_t* body = &payload[RESULTPROTOCOL_HEADER_SIZE];
+
+    WriteHeader(payload, RESULTPROTOCOL_TYPE_SCAN, millis());
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        body[i] = map->rows[i];
+    }
+    body[8] = (uint8_t)verdict;
+    body[9] = reversed_pairs;
+
+    return SendFrame(payload, RESULTPROTOCOL_SCAN_BODY);
+}
+
+uint8_t ResultStream_SendHunt(const FaultHunt_t* hunt)
+{
+    uint8_t payload[RESULTPROTOCOL_MAX_PAYLOAD];
+    uint8_t* body = &payload[RESULTPROTOCOL_HEADER_SIZE];
+
+    WriteHeader(payload, RESULTPROTOCOL_TYPE_HUNT, millis());
+    ResultProtocol_PutU32(&body[0], hunt->scan_count);
+    body[4] = hunt->latched_mask;
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        ResultProtocol_PutU16(&body[5U + (2U * i)], hunt->glitch_count[i]);
+    }
+
+    return SendFrame(payload, RESULTPROTOCOL_HUNT_BODY);
+}
+
+uint8_t ResultStream_SendBatch(const BatchTest_t* batch)
+{
+    uint8_t payload[RESULTPROTOCOL_MAX_PAYLOAD];
+    uint8_t* body = &payload[RESULTPROTOCOL_HEADER_SIZE];
+    uint8_t last = (uint8_t)((batch->ttv_next + BATCHTEST_HISTORY_SIZE - 1U) % BATCHTEST_HISTORY_SIZE);
+
+    WriteHeader(payload, RESULTPROTOCOL_TYPE_BATCH, millis());
+    ResultProtocol_PutU16(&body[0], batch->tested);
+    ResultProtocol_PutU16(&body[2], batch->passed);
+    ResultProtocol_PutU16(&body[4], batch->failed);
+    body[6] = (uint8_t)batch->state;
+    body[7] = (uint8_t)batch->verdict;
+    ResultProtocol_PutU16(&body[8], batch->ttv_ms[last]);
+    ResultProtocol_PutU16(&body[10], BatchTest_GetMedianTimeToVerdict(batch));
+    ResultProtocol_PutU32(&body[12], BatchTest_GetCablesPerHour(batch));
+
+    return SendFrame(payload, RESULTPROTOCOL_BATCH_BODY);
+}
+
+uint8_t ResultStream_SendHistory(const FlashLogRecord_t* record)
+{
+    uint8_t payload[RESULTPROTOCOL_MAX_PAYLOAD];
+    uint8_t* body = &payload[RESULTPROTOCOL_HEADER_SIZE];
+
+    WriteHeader(payload, RESULTPROTOCOL_TYPE_HISTORY, millis());
+    ResultProtocol_PutU32(&body[0], record->sequence);
+    ResultProtocol_PutU32(&body[4], record->time_ms);
+    ResultProtocol_PutU16(&body[8], record->boot);
+    body[10] = record->kind;
+    body[11] = record->verdict;
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        body[12U + i] = record->rows[i];
+        body[20U + i] = record->glitch_count[i];
+    }
+    body[28] = record->latched_mask;
+    body[29] = record->reversed_pairs;
+
+    return SendFrame(payload, RESULTPROTOCOL_HISTORY_BODY);
+}
+
+uint8_t ResultStream_SendLog(uint8_t format_id, uint32_t timestamp_ms, const uint32_t* args, uint8_t arg_count)
+{
+    uint8_t payload[RESULTPROTOCOL_MAX_PAYLOAD];
+    uint8_t* body = &payload[RESULTPROTOCOL_HEADER_SIZE];
+
+    if (arg_count > RESULTPROTOCOL_LOG_MAX_ARGS)
+    {
+        arg_count = RESULTPROTOCOL_LOG_MAX_ARGS;
+    }
+
+    WriteHeader(payload, RESULTPROTOCOL_TYPE_LOG, timestamp_ms);
+    body[0] = format_id;
+    for (uint8_t i = 0U; i < arg_count; i++)
+    {
+        ResultProtocol_PutU32(&body[1U + (4U * i)], args[i]);
+    }
+
+    return SendFrame(payload, (uint8_t)(1U + (4U * arg_count)));
+}
+
+uint16_t ResultStream_GetFreeSpace(void)
+{
+    // One slot stays empty to tell a full ring from an empty one
+    return (uint16_t)(RESULTSTREAM_BUFFER_SIZE - 1U -
+                      ((tx_head - tx_tail) & (RESULTSTREAM_BUFFER_SIZE - 1U)));
+}
+
+uint8_t ResultStream_IsBusy(void)
+{
+    return (tx_tail != tx_head) ? 1U : 0U;
+}
+
+uint32_t ResultStream_GetDroppedCount(void)
+{
+    return dropped_count;
+}
+
+// Private function implementations
+
+static void WriteHeader(uint8_t* payload, uint8_t type, uint32_t timestamp_ms)
+{
+    // Every frame gets a number, dropped ones included
+    payload[0] = type;
+    ResultProtocol_PutU16(&payload[1], sequence++);
+    ResultProtocol_PutU32(&payload[3], timestamp_ms);
+}
+
+static uint8_t SendFrame(uint8_t* payload, uint8_t body_length)
+{
+    uint8_t encoded[RESULTPROTOCOL_MAX_ENCODED];
+    uint8_t length = (uint8_t)(RESULTPROTOCOL_HEADER_SIZE + body_length);
+
+    ResultProtocol_PutU16(&payload[length], ResultProtocol_Crc16(payload, length));
+    length = (uint8_t)(length + RESULTPROTOCOL_CRC_SIZE);
+
+    uint8_t encoded_length = (uint8_t)ResultProtocol_CobsEncode(payload, length, encoded);
+
+    if (ResultStream_GetFreeSpace() < encoded_length)
+    {
+        dropped_count++;
+        return 0U;
+    }
+
+    uint16_t head = tx_head;
+    for (uint8_t i = 0U; i < encoded_length; i++)
+    {
+        tx_buffer[head] = encoded[i];
+        head = (uint16_t)((head + 1U) & (RESULTSTREAM_BUFFER_SIZE - 1U));
+    }
+    tx_head = head;
+
+    // Kick the DMA if it went idle, the interrupt chains further transfers
+    __disable_irq();
+    if (tx_in_flight == 0U)
+    {
+        StartTransfer();
+    }
+    __enable_irq();
+
+    return 1U;
+}
+
+static void StartTransfer(void)
+{
+    uint16_t tail = tx_tail;
+    uint16_t head = tx_head;
+
+    if (tail == head)
+    {
+        return;
+    }
+
+    // Contiguous part only, the wrapped rest follows in the next transfer
+    uint16_t count = (head > tail) ? (uint16_t)(head - tail) : (uint16_t)(RESULTSTREAM_BUFFER_SIZE - tail);
+
+    tx_in_flight = count;
+    DMA1_Channel4->CFGR = 0U;
+    DMA1_Channel4->MADDR = (uint32_t)(uintptr_t)&tx_buffer[tail];
+    DMA1_Channel4->CNTR = count;
+    DMA1_Channel4->CFGR = DMA_DIR_PeripheralDST | DMA_MemoryInc_Enable | DMA_IT_TC | DMA_CFGR1_EN;
+}
+
+void DMA1_Channel4_IRQHandler(void)
+{
+    DMA1->INTFCR = DMA1_IT_GL4;
+    DMA1_Channel4->CFGR = 0U;
+
+    tx_tail = (uint16_t)((tx_tail + tx_in_flight) & (RESULTSTREAM_BUFFER_SIZE - 1U));
+    tx_in_flight = 0U;
+
+    StartTransfer();
+}
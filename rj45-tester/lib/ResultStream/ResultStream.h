@@ -0,0 +1,89 @@
+#ifndef RESULTSTREAM_H
+#define RESULTSTREAM_H
+
+#include <stdint.h>
+#include "BatchTest.h"
+#include "FaultHunt.h"
+#include "FlashLog.h"
+#include "WireClass.h"
+#include "WireMap.h"
+
+// Configuration constants
+#define RESULTSTREAM_BUFFER_SIZE    256U   /**< Transmit ring size in bytes (power of 2) */
+
+#if (RESULTSTREAM_BUFFER_SIZE & (RESULTSTREAM_BUFFER_SIZE - 1U)) != 0U
+#error "RESULTSTREAM_BUFFER_SIZE must be a power of 2"
+#endif
+
+// Public API functions
+
+/**
+ * @brief Set up DMA1 channel 4 to feed USART1 from the transmit ring
+ * @details Call after Serial.begin() has configured USART1. DMA1 channel 4
+ *          and its interrupt are owned by this module.
+ */
+void ResultStream_Init(void);
+
+/**
+ * @brief Queue one scan result as a binary frame
+ * @details Never waits: the frame is copied into the transmit ring and sent
+ *          by DMA. A frame that does not fit is dropped and shows up as a
+ *          sequence gap on the host side
+ * @param map Scanned matrix
+ * @param verdict Classification of the matrix
+ * @param reversed_pairs Swapped pairs reported by WireClass_Classify()
+ * @return uint8_t 1 if queued, 0 if dropped
+ */
+uint8_t ResultStream_SendScan(const WireMap_t* map, WireClass_t verdict, uint8_t reversed_pairs);
+
+/**
+ * @brief Queue the fault hunting counters as a binary frame
+ * @param hunt Tracker to report
+ * @return uint8_t 1 if queued, 0 if dropped
+ */
+uint8_t ResultStream_SendHunt(const FaultHunt_t* hunt);
+
+/**
+ * @brief Queue the batch test verdict and session counters as a binary frame
+ * @param batch Session to report
+ * @return uint8_t 1 if queued, 0 if dropped
+ */
+uint8_t ResultStream_SendBatch(const BatchTest_t* batch);
+
+/**
+ * @brief Queue one stored history record as a binary frame
+ * @param record Record read back from the flash history
+ * @return uint8_t 1 if queued, 0 if dropped
+ */
+uint8_t ResultStream_SendHistory(const FlashLogRecord_t* record);
+
+/**
+ * @brief Queue one log record as a binary frame
+ * @param format_id Index into the shared format table (UartLogFormats.h)
+ * @param timestamp_ms Time the record was logged
+ * @param args Arguments of the record
+ * @param arg_count Number of arguments (at most RESULTPROTOCOL_LOG_MAX_ARGS)
+ * @return uint8_t 1 if queued, 0 if dropped
+ */
+uint8_t ResultStream_SendLog(uint8_t format_id, uint32_t timestamp_ms, const uint32_t* args, uint8_t arg_count);
+
+/**
+ * @brief Get free space of the transmit ring
+ * @details A frame always fits when this is at least RESULTPROTOCOL_MAX_ENCODED
+ * @return uint16_t Free bytes
+ */
+uint16_t ResultStream_GetFreeSpace(void);
+
+/**
+ * @brief Check whether queued bytes are still waiting for the UART
+ * @return uint8_t 1 while bytes are queued
+ */
+uint8_t ResultStream_IsBusy(void);
+
+/**
+ * @brief Get number of frames dropped because the transmit ring was full
+ * @return uint32_t Dropped frame count
+ */
+uint32_t ResultStream_GetDroppedCount(void);
+
+#endif /* RESULTSTREAM_H */
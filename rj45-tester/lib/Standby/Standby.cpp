@@ -0,0 +1,110 @@
+#include "Standby.h"
+#include "Board.h"
+#include "BoardHal.h"
+
+// Private constants
+#define STANDBY_EXTICR_PORTC        0x2UL  /**< EXTICR source selection of port C */
+#define STANDBY_EXTICR_PORTD        0x3UL  /**< EXTICR source selection of port D */
+#define STANDBY_SCTLR_SLEEPDEEP     (1UL << 2)
+#define STANDBY_HSI_MHZ             24U    /**< Core clock right after wake-up */
+#define STANDBY_PULLUP_LOOPS        48U    /**< Busy loops for the pull-ups to charge idle lines (~4 us) */
+
+// Private function prototypes
+static uint32_t ExtiSelect(uint8_t pin_mask, uint32_t source);
+static uint8_t CableLinesLow(void);
+static uint16_t RestoreClock(void);
+
+// Public API Implementation
+
+StandbyWake_t Standby_Enter(uint16_t* clock_us)
+{
+    uint32_t lines = BOARD_WAKE_PORTC_MASK | BOARD_WAKE_PORTD_MASK | BOARD_WAKE_SERIAL_MASK;
+    uint32_t port_select = ExtiSelect(BOARD_WAKE_PORTC_MASK, STANDBY_EXTICR_PORTC) |
+                           ExtiSelect(BOARD_WAKE_PORTD_MASK | BOARD_WAKE_SERIAL_MASK, STANDBY_EXTICR_PORTD);
+    StandbyWake_t wake = STANDBY_ABORTED;
+
+    RCC->APB1PCENR |= RCC_APB1Periph_PWR;
+    RCC->APB2PCENR |= RCC_APB2Periph_AFIO;
+
+    // The last byte must leave the shift register, USART1 stops with the clock
+    while ((USART1->STATR & USART_FLAG_TC) == 0U)
+    {
+    }
+
+    // Pull the sense lines up, a conductor to a low drive line pulls its line down
+    GPIOC->BSHR = BOARD_SENSE_PORTC_MASK;
+    GPIOD->BSHR = BOARD_SENSE_PORTD_MASK;
+
+    AFIO->EXTICR = (AFIO->EXTICR & ~ExtiSelect((uint8_t)lines, 0x3UL)) | port_select;
+    EXTI->FTENR |= lines;
+    EXTI->EVENR |= lines;
+
+    for (uint32_t loops = STANDBY_PULLUP_LOOPS; loops > 0U; loops--)
+    {
+        __asm__ volatile ("nop");
+    }
+
+    // A line that is already low gives no edge and would never wake the chip
+    if (!CableLinesLow() && ((GPIOD->INDR & BOARD_WAKE_SERIAL_MASK) != 0U))
+    {
+        PWR->CTLR |= PWR_CTLR_PDDS;
+        NVIC->SCTLR |= STANDBY_SCTLR_SLEEPDEEP;
+        __WFE();
+        NVIC->SCTLR &= ~STANDBY_SCTLR_SLEEPDEEP;
+
+        *clock_us = RestoreClock();
+        wake = CableLinesLow() ? STANDBY_WAKE_CABLE : STANDBY_WAKE_SERIAL;
+    }
+
+    EXTI->EVENR &= ~lines;
+    EXTI->FTENR &= ~lines;
+    GPIOC->BCR = BOARD_SENSE_PORTC_MASK;
+    GPIOD->BCR = BOARD_SENSE_PORTD_MASK;
+
+    return wake;
+}
+
+// Private function implementations
+
+static uint32_t ExtiSelect(uint8_t pin_mask, uint32_t source)
+{
+    uint32_t select = 0U;
+
+    // Two bits per EXTI line, line N takes pin N of the selected port
+    for (uint8_t pin = 0U; pin < 8U; pin++)
+    {
+        if (pin_mask & (1U << pin))
+        {
+            select |= source << (pin * 2U);
+        }
+    }
+    return select;
+}
+
+static uint8_t CableLinesLow(void)
+{
+    return (((GPIOC->INDR & BOARD_WAKE_PORTC_MASK) != BOARD_WAKE_PORTC_MASK) ||
+            ((GPIOD->INDR & BOARD_WAKE_PORTD_MASK) != BOARD_WAKE_PORTD_MASK)) ? 1U : 0U;
+}
+
+static uint16_t RestoreClock(void)
+{
+    uint32_t start = SysTick->CNT;
+
+    // Standby leaves the core on HSI with the PLL off, the PLL settings are kept
+    RCC->CTLR |= RCC_PLLON;
+    while ((RCC->CTLR & RCC_PLLRDY) == 0U)
+    {
+    }
+
+    // Still counted at HSI, before the switch
+    uint32_t ticks = BoardHal_SysTickElapsed(&start);
+    RCC->CFGR0 = (RCC->CFGR0 & ~RCC_SW) | RCC_SW_PLL;
+    while ((RCC->CFGR0 & RCC_SWS) != RCC_SWS_PLL)
+    {
+    }
+
+    uint32_t ticks_per_us = STANDBY_HSI_MHZ / BoardHal_SysTickDivider();
+
+    return (uint16_t)(ticks / ticks_per_us);
+}
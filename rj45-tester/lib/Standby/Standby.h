@@ -0,0 +1,33 @@
+#ifndef STANDBY_H
+#define STANDBY_H
+
+#include <stdint.h>
+
+// Type definitions
+/**
+ * @brief What ended a standby
+ */
+typedef enum
+{
+    STANDBY_ABORTED = 0,         /**< A wake line was already low, standby not entered */
+    STANDBY_WAKE_CABLE,          /**< An inserted cable pulled a sense line low */
+    STANDBY_WAKE_SERIAL          /**< A character arrived on USART1 RX */
+} StandbyWake_t;
+
+// Public API functions
+
+/**
+ * @brief Stop all clocks until a cable is inserted or a character arrives
+ * @details The sense lines switch to pull-ups with falling edge EXTI events,
+ *          so a conductor that reaches a near drive line wakes the chip. The
+ *          drive lines must be low outputs, all DMA transfers finished and
+ *          the display refresh suspended. RAM and registers are kept; on wake
+ *          the 48 MHz PLL clock is restarted and the sense lines are pulled
+ *          down again before returning. The character that woke the chip is
+ *          lost, the UART had no clock to receive it.
+ * @param clock_us Time the PLL took to lock after wake-up, in microseconds
+ * @return StandbyWake_t Wake source, or STANDBY_ABORTED
+ */
+StandbyWake_t Standby_Enter(uint16_t* clock_us);
+
+#endif /* STANDBY_H */
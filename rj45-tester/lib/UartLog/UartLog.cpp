@@ -0,0 +1,70 @@
+#include <Arduino.h>
+#include "UartLog.h"
+#include "ResultProtocol.h"
+#include "ResultStream.h"
+
+// Private type definitions
+/**
+ * @brief Buffered log record, fixed size so writing it is a handful of stores
+ */
+typedef struct
+{
+    uint32_t timestamp_ms;       /**< millis() when logged */
+    uint32_t args[UARTLOG_MAX_ARGS]; /**< Raw arguments */
+    uint8_t format;              /**< UartLogFormat_t */
+} UartLogRecord_t;
+
+#define UARTLOG_ARG_COUNT(id, arg_count, format) (arg_count),
+#define UARTLOG_FORMAT_STRING(id, arg_count, format) format,
+
+// Private variables
+static const uint8_t arg_counts[UARTLOG_FORMAT_COUNT] = { UARTLOG_FORMATS(UARTLOG_ARG_COUNT) };
+static const char* const format_strings[UARTLOG_FORMAT_COUNT] = { UARTLOG_FORMATS(UARTLOG_FORMAT_STRING) };
+static UartLogRecord_t records[UARTLOG_RECORD_COUNT];
+static uint8_t record_head = 0U;
+static uint8_t record_tail = 0U;
+static uint32_t dropped_count = 0U;
+
+// Public API Implementation
+
+void UartLog_Write(UartLogFormat_t format, uint32_t arg0, uint32_t arg1)
+{
+    uint8_t head = record_head;
+
+    if ((uint8_t)(head - record_tail) >= UARTLOG_RECORD_COUNT)
+    {
+        dropped_count++;
+        return;
+    }
+
+    UartLogRecord_t* record = &records[head & (UARTLOG_RECORD_COUNT - 1U)];
+    record->timestamp_ms = millis();
+    record->args[0] = arg0;
+    record->args[1] = arg1;
+    record->format = (uint8_t)format;
+
+    record_head = (uint8_t)(head + 1U);
+}
+
+void UartLog_Task(void)
+{
+    // Records wait here while the transmit ring is full instead of being dropped
+    while ((record_tail != record_head) && (ResultStream_GetFreeSpace() >= RESULTPROTOCOL_MAX_ENCODED))
+    {
+        const UartLogRecord_t* record = &records[record_tail & (UARTLOG_RECORD_COUNT - 1U)];
+        uint8_t arg_count = (record->format < UARTLOG_FORMAT_COUNT) ? arg_counts[record->format] : 0U;
+
+        ResultStream_SendLog(record->format, record->timestamp_ms, record->args, arg_count);
+        record_tail++;
+    }
+}
+
+const char* UartLog_GetFormat(UartLogFormat_t format)
+{
+    return (format < UARTLOG_FORMAT_COUNT) ? format_strings[format] : "?";
+}
+
+uint32_t UartLog_GetDroppedCount(void)
+{
+    return dropped_count;
+}
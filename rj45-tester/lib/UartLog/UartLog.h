@@ -0,0 +1,49 @@
+#ifndef UARTLOG_H
+#define UARTLOG_H
+
+#include <stdint.h>
+#include "UartLogFormats.h"
+
+// Configuration constants
+#define UARTLOG_RECORD_COUNT        16U    /**< Records buffered before dropping (power of 2) */
+#define UARTLOG_MAX_ARGS            2U     /**< Arguments per record */
+
+#if (UARTLOG_RECORD_COUNT & (UARTLOG_RECORD_COUNT - 1U)) != 0U
+#error "UARTLOG_RECORD_COUNT must be a power of 2"
+#endif
+
+// Public API functions
+
+/**
+ * @brief Store a log record, never waits
+ * @details Only copies the format id, the time and the arguments into a RAM
+ *          ring, a few dozen cycles. Formatting happens on the host. When the
+ *          ring is full the record is dropped and counted. Main loop only,
+ *          not for use from interrupts.
+ * @param format Format table entry
+ * @param arg0 First argument (ignored if the format has none)
+ * @param arg1 Second argument (ignored if the format has fewer)
+ */
+void UartLog_Write(UartLogFormat_t format, uint32_t arg0, uint32_t arg1);
+
+/**
+ * @brief Move buffered records into the binary result stream
+ * @details Frames as many records as fit into the transmit ring, the rest
+ *          stays buffered for the next call. Call from the main loop.
+ */
+void UartLog_Task(void);
+
+/**
+ * @brief Get the format string of a table entry
+ * @param format Format table entry
+ * @return const char* printf() format string, "?" for unknown entries
+ */
+const char* UartLog_GetFormat(UartLogFormat_t format);
+
+/**
+ * @brief Get number of records dropped because the ring was full
+ * @return uint32_t Dropped record count
+ */
+uint32_t UartLog_GetDroppedCount(void);
+
+#endif /* UARTLOG_H */
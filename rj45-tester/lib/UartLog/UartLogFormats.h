@@ -0,0 +1,78 @@
+#ifndef UARTLOGFORMATS_H
+#define UARTLOGFORMATS_H
+
+/**
+ * @file UartLogFormats.h
+ * @brief Log format table, shared by the firmware and tools/rj45-decode
+ * @details The firmware only sends the index of an entry and its arguments,
+ *          the host formats them with printf(). Arguments are sent as u32,
+ *          so use %lu / %lX, or %s for a WireClass_t, which the host prints
+ *          by name. Append new entries at the end to keep old captures
+ *          decodable.
+ *
+ *          X(id, argument count, format string)
+ */
+#define UARTLOG_FORMATS(X)                                                          \
+    X(LOG_MODE_WIREMAP,     0, "Wiremap mode")                                      \
+    X(LOG_MODE_HUNT,        0, "Fault hunting mode")                                \
+    X(LOG_MODE_BATCH,       0, "Batch test mode")                                   \
+    X(LOG_HUNT_CLEARED,     0, "Latched faults cleared")                            \
+    X(LOG_BATCH_CLEARED,    0, "Batch counters cleared")                            \
+    X(LOG_BINARY_OUTPUT,    0, "Binary output")                                     \
+    X(LOG_TEXT_OUTPUT,      0, "Text output")                                       \
+    X(LOG_GLITCH,           2, "Glitch on conductors 0x%02lX at scan %lu")          \
+    X(LOG_FRAMES_DROPPED,   1, "%lu frames dropped, transmit ring full")            \
+    X(LOG_RECORDS_DROPPED,  1, "%lu log records dropped, log ring full")           \
+    X(LOG_RC_CONDUCTOR,     2, "Pin %lu: %lu pF")                                   \
+    X(LOG_RC_LENGTH,        2, "Cable length %lu cm, open pins 0x%02lX")            \
+    X(LOG_RC_LOADED,        1, "Far end connected on pins 0x%02lX, unplug it")      \
+    X(LOG_RC_ZEROED,        0, "Length zero stored")                                \
+    X(LOG_RC_CALIBRATED,    1, "Length calibrated to %lu pF/m")                     \
+    X(LOG_RC_CAL_FAILED,    0, "Length calibration failed")                         \
+    X(LOG_PANEL_PORT,       2, "Port %lu: %s")                                      \
+    X(LOG_PANEL_SUMMARY,    2, "Panel: %lu of %lu ports pass")                      \
+    X(LOG_CONSOLE_UNKNOWN,  0, "Unknown command, try help")                         \
+    X(LOG_CONSOLE_BAD_ARG,  0, "Value missing or out of range")                     \
+    X(LOG_CONSOLE_TOO_LONG, 0, "Command line too long")                             \
+    X(LOG_CONSOLE_HELP,     0, "Commands: h p n c b t d r z k mode display scan batch report standby res dual stats") \
+    X(LOG_SET_SCAN,         1, "Scan period %lu ms")                                \
+    X(LOG_SET_BATCH,        1, "Batch scan period %lu ms")                          \
+    X(LOG_SET_REPORT,       1, "Report period %lu ms")                              \
+    X(LOG_DISPLAY_RESULT,   0, "Display shows the result")                          \
+    X(LOG_DISPLAY_OFF,      0, "Display off")                                       \
+    X(LOG_DISPLAY_TEST,     0, "Display test, all LEDs on")                         \
+    X(LOG_STATS_UPTIME,     2, "Up %lu ms, %lu scans")                              \
+    X(LOG_STATS_RATE,       1, "%lu scans/s since the last stats")                  \
+    X(LOG_STATS_HISTORY,    2, "History %lu records, boot %lu")                     \
+    X(LOG_STATS_CONSOLE,    2, "Console %lu lines, %lu errors")                     \
+    X(LOG_SET_STANDBY,      1, "Standby after %lu ms")                              \
+    X(LOG_STANDBY,          0, "Standby until a cable or a key")                    \
+    X(LOG_STANDBY_ABORTED,  0, "Standby aborted, a line is active")                 \
+    X(LOG_WAKE_CABLE,       2, "Cable woke the tester, PLL %lu us, verdict %lu us later") \
+    X(LOG_WAKE_SERIAL,      1, "Key woke the tester, PLL %lu us")                   \
+    X(LOG_RES_CONDUCTOR,    2, "Pin %lu: %lu mOhm")                                 \
+    X(LOG_RES_SUMMARY,      2, "Resistance %lu mOhm, high pins 0x%02lX")            \
+    X(LOG_RES_SUPPLY,       1, "Supply %lu mV")                                     \
+    X(LOG_RES_UNMEASURED,   1, "No current on pins 0x%02lX, far end plugged in?")   \
+    X(LOG_RES_ZEROED,       0, "Resistance zero stored")                            \
+    X(LOG_DUAL_OFF,         0, "Dual-unit mode off")                                \
+    X(LOG_DUAL_MAIN,        0, "Dual-unit main, a remote tester reads the far end") \
+    X(LOG_DUAL_REMOTE,      0, "Dual-unit remote, answering on the near jack")      \
+    X(LOG_DUAL_NO_REMOTE,   0, "No answer from the remote tester")                  \
+    X(LOG_DUAL_SCAN,        2, "Remote scan %lu us, %lu retries")                   \
+    X(LOG_DUAL_BUSY,        0, "Near jack held by the remote role")                 \
+    X(LOG_CONSOLE_OVERRUN,  0, "Console input lost, line dropped")                  \
+    X(LOG_CONSOLE_LOST,     1, "%lu received bytes lost, console ring full")
+
+#define UARTLOG_FORMAT_ID(id, arg_count, format) id,
+
+/**
+ * @brief Log format identifiers, index into UARTLOG_FORMATS
+ */
+typedef enum
+{
+    UARTLOG_FORMATS(UARTLOG_FORMAT_ID)
+    UARTLOG_FORMAT_COUNT
+} UartLogFormat_t;
+
+#endif /* UARTLOGFORMATS_H */
@@ -0,0 +1,181 @@
+#include <stddef.h>
+#include "WireClass.h"
+
+// Private constants
+#define WIRECLASS_HASH_BITS         5U          /**< log2 of the lookup table size */
+#define WIRECLASS_HASH_SLOTS        (1U << WIRECLASS_HASH_BITS)
+#define WIRECLASS_HASH_MULTIPLIER   0x8296F5EBUL /**< Collision-free for the signatures below, checked at compile time */
+#define WIRECLASS_EMPTY_KEY         0xFFFFFFFFUL /**< Never produced by a packed 24-bit map */
+
+// Private type definitions
+/**
+ * @brief Known wiring signature
+ */
+typedef struct
+{
+    uint32_t key;                /**< Far conductor of each near conductor, 3 bits each */
+    uint8_t verdict;             /**< WireClass_t of this signature */
+    uint8_t reversed_pairs;      /**< Swapped pairs, for WIRECLASS_REVERSED_PAIR */
+} WireClassSignature_t;
+
+/**
+ * @brief Pack a far conductor map into 8x3 bits
+ */
+static constexpr uint32_t PackMap(uint8_t c0, uint8_t c1, uint8_t c2, uint8_t c3,
+                                  uint8_t c4, uint8_t c5, uint8_t c6, uint8_t c7)
+{
+    return (uint32_t)c0 | ((uint32_t)c1 << 3) | ((uint32_t)c2 << 6) | ((uint32_t)c3 << 9) |
+           ((uint32_t)c4 << 12) | ((uint32_t)c5 << 15) | ((uint32_t)c6 << 18) | ((uint32_t)c7 << 21);
+}
+
+/**
+ * @brief Exchange the far conductors of near conductors a and b in a packed map
+ */
+static constexpr uint32_t SwapConductors(uint32_t key, uint8_t a, uint8_t b)
+{
+    return (key & ~((7UL << (3U * a)) | (7UL << (3U * b)))) |
+           (((key >> (3U * b)) & 7UL) << (3U * a)) |
+           (((key >> (3U * a)) & 7UL) << (3U * b));
+}
+
+/**
+ * @brief Straight map with the wires of the selected pairs swapped
+ * @param pairs Bit 0 = pins 1-2, bit 1 = pins 3-6, bit 2 = pins 4-5, bit 3 = pins 7-8
+ */
+static constexpr uint32_t ReversedPairsKey(uint8_t pairs)
+{
+    return ((pairs & 0x08U) != 0U) ? SwapConductors(ReversedPairsKey((uint8_t)(pairs & 0x07U)), 6U, 7U) :
+           ((pairs & 0x04U) != 0U) ? SwapConductors(ReversedPairsKey((uint8_t)(pairs & 0x03U)), 3U, 4U) :
+           ((pairs & 0x02U) != 0U) ? SwapConductors(ReversedPairsKey((uint8_t)(pairs & 0x01U)), 2U, 5U) :
+           ((pairs & 0x01U) != 0U) ? SwapConductors(PackMap(0, 1, 2, 3, 4, 5, 6, 7), 0U, 1U) :
+           PackMap(0, 1, 2, 3, 4, 5, 6, 7);
+}
+
+#define REVERSED_PAIR_SIGNATURE(pairs) { ReversedPairsKey(pairs), WIRECLASS_REVERSED_PAIR, (pairs) }
+
+// Every complete one-to-one map with a name
+static constexpr WireClassSignature_t signatures[] =
+{
+    { PackMap(0, 1, 2, 3, 4, 5, 6, 7), WIRECLASS_STRAIGHT,          0U },
+    { PackMap(2, 5, 0, 3, 4, 1, 6, 7), WIRECLASS_CROSSOVER,         0U },
+    { PackMap(2, 5, 0, 6, 7, 1, 3, 4), WIRECLASS_CROSSOVER_GIGABIT, 0U },
+    { PackMap(7, 6, 5, 4, 3, 2, 1, 0), WIRECLASS_ROLLOVER,          0U },
+    REVERSED_PAIR_SIGNATURE(0x1U), REVERSED_PAIR_SIGNATURE(0x2U), REVERSED_PAIR_SIGNATURE(0x3U),
+    REVERSED_PAIR_SIGNATURE(0x4U), REVERSED_PAIR_SIGNATURE(0x5U), REVERSED_PAIR_SIGNATURE(0x6U),
+    REVERSED_PAIR_SIGNATURE(0x7U), REVERSED_PAIR_SIGNATURE(0x8U), REVERSED_PAIR_SIGNATURE(0x9U),
+    REVERSED_PAIR_SIGNATURE(0xAU), REVERSED_PAIR_SIGNATURE(0xBU), REVERSED_PAIR_SIGNATURE(0xCU),
+    REVERSED_PAIR_SIGNATURE(0xDU), REVERSED_PAIR_SIGNATURE(0xEU), REVERSED_PAIR_SIGNATURE(0xFU)
+};
+
+static constexpr uint8_t SIGNATURE_COUNT = (uint8_t)(sizeof(signatures) / sizeof(signatures[0]));
+
+/**
+ * @brief Multiplicative hash of a packed map
+ */
+static constexpr uint8_t HashSlot(uint32_t key)
+{
+    return (uint8_t)((uint32_t)(key * WIRECLASS_HASH_MULTIPLIER) >> (32U - WIRECLASS_HASH_BITS));
+}
+
+/**
+ * @brief Signature stored in a table slot, evaluated at compile time
+ * @param slot Table slot
+ * @param i First signature to consider (recursion index)
+ */
+static constexpr WireClassSignature_t SlotEntry(uint8_t slot, uint8_t i = 0U)
+{
+    return (i >= SIGNATURE_COUNT) ? WireClassSignature_t{ WIRECLASS_EMPTY_KEY, WIRECLASS_MISWIRED, 0U } :
+           (HashSlot(signatures[i].key) == slot) ? signatures[i] :
+           SlotEntry(slot, (uint8_t)(i + 1U));
+}
+
+/**
+ * @brief Number of signatures hashing to a slot
+ */
+static constexpr uint8_t SlotUses(uint8_t slot, uint8_t i = 0U)
+{
+    return (i >= SIGNATURE_COUNT) ? 0U :
+           (uint8_t)(((HashSlot(signatures[i].key) == slot) ? 1U : 0U) + SlotUses(slot, (uint8_t)(i + 1U)));
+}
+
+/**
+ * @brief Check that no two signatures share a slot
+ */
+static constexpr bool IsCollisionFree(uint8_t slot = 0U)
+{
+    return (slot >= WIRECLASS_HASH_SLOTS) ? true :
+           (SlotUses(slot) <= 1U) && IsCollisionFree((uint8_t)(slot + 1U));
+}
+
+static_assert(IsCollisionFree(), "WIRECLASS_HASH_MULTIPLIER must map every signature to its own slot");
+
+// Eight consecutive table slots
+#define SLOT_ROW(base)                                                              \
+    SlotEntry((base) + 0U), SlotEntry((base) + 1U), SlotEntry((base) + 2U),         \
+    SlotEntry((base) + 3U), SlotEntry((base) + 4U), SlotEntry((base) + 5U),         \
+    SlotEntry((base) + 6U), SlotEntry((base) + 7U)
+
+// Compile-time perfect hash table, indexed by HashSlot()
+static constexpr WireClassSignature_t signature_table[WIRECLASS_HASH_SLOTS] =
+{
+    SLOT_ROW(0U), SLOT_ROW(8U), SLOT_ROW(16U), SLOT_ROW(24U)
+};
+
+static const char* const verdict_names[WIRECLASS_COUNT] =
+{
+    "NO CABLE", "STRAIGHT", "CROSSOVER", "GIGABIT CROSSOVER", "ROLLOVER",
+    "REVERSED PAIR", "MISWIRED", "OPEN", "SHORT"
+};
+
+// Public API Implementation
+
+WireClass_t WireClass_Classify(const WireMapReport_t* report, uint8_t* reversed_pairs)
+{
+    WireClass_t verdict;
+    uint8_t pairs = 0U;
+
+    if (report->open_mask == 0xFFU)
+    {
+        verdict = WIRECLASS_NO_CABLE;
+    }
+    else if (report->short_mask != 0U)
+    {
+        verdict = WIRECLASS_SHORT;
+    }
+    else if (report->open_mask != 0U)
+    {
+        verdict = WIRECLASS_OPEN;
+    }
+    else
+    {
+        // No open and no short: every far conductor is reached exactly once
+        uint32_t key = 0U;
+        for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+        {
+            key |= (uint32_t)report->far_conductor[i] << (3U * i);
+        }
+
+        const WireClassSignature_t* entry = &signature_table[HashSlot(key)];
+        if (entry->key == key)
+        {
+            verdict = (WireClass_t)entry->verdict;
+            pairs = entry->reversed_pairs;
+        }
+        else
+        {
+            verdict = WIRECLASS_MISWIRED;
+        }
+    }
+
+    if (reversed_pairs != NULL)
+    {
+        *reversed_pairs = pairs;
+    }
+
+    return verdict;
+}
+
+const char* WireClass_GetName(WireClass_t verdict)
+{
+    return (verdict < WIRECLASS_COUNT) ? verdict_names[verdict] : "?";
+}
@@ -0,0 +1,49 @@
+#ifndef WIRECLASS_H
+#define WIRECLASS_H
+
+#include <stdint.h>
+#include "WireMap.h"
+
+// Type definitions
+/**
+ * @brief Wiring verdict for a complete cable
+ * @details A pin-to-pin map cannot tell a T568A from a T568B straight cable,
+ *          both give WIRECLASS_STRAIGHT. A T568A-to-T568B cable gives
+ *          WIRECLASS_CROSSOVER.
+ */
+typedef enum
+{
+    WIRECLASS_NO_CABLE = 0,      /**< No conductor connected */
+    WIRECLASS_STRAIGHT,          /**< Pin N to pin N (T568A or T568B on both ends) */
+    WIRECLASS_CROSSOVER,         /**< 10/100 crossover: 1-3 and 2-6 exchanged */
+    WIRECLASS_CROSSOVER_GIGABIT, /**< Full crossover: also 4-7 and 5-8 exchanged */
+    WIRECLASS_ROLLOVER,          /**< Pin N to pin 9 - N (console cable) */
+    WIRECLASS_REVERSED_PAIR,     /**< Straight with the two wires of one or more pairs swapped */
+    WIRECLASS_MISWIRED,          /**< Every conductor connected once, in no known order */
+    WIRECLASS_OPEN,              /**< At least one conductor open, none shorted */
+    WIRECLASS_SHORT,             /**< At least one conductor shorted */
+    WIRECLASS_COUNT              /**< Number of verdicts */
+} WireClass_t;
+
+// Public API functions
+
+/**
+ * @brief Classify an analyzed scan in constant time
+ * @details Complete one-to-one maps are packed to 8x3 bits and looked up in
+ *          a perfect hash table generated at compile time
+ * @param report Pointer to analysis of the scanned matrix
+ * @param reversed_pairs Optional output (may be NULL): bit P set when the
+ *        wires of pair P (0 = pins 1-2, 1 = 3-6, 2 = 4-5, 3 = 7-8) are swapped,
+ *        only meaningful for WIRECLASS_REVERSED_PAIR
+ * @return WireClass_t Verdict
+ */
+WireClass_t WireClass_Classify(const WireMapReport_t* report, uint8_t* reversed_pairs);
+
+/**
+ * @brief Get printable name of a verdict
+ * @param verdict Verdict
+ * @return const char* Short upper-case name
+ */
+const char* WireClass_GetName(WireClass_t verdict);
+
+#endif /* WIRECLASS_H */
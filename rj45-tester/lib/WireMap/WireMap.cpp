@@ -0,0 +1,87 @@
+#include "WireMap.h"
+#include "WireMapHal.h"
+
+// Public API Implementation
+
+void WireMap_Init(void)
+{
+    WireMapHal_Init();
+}
+
+void WireMap_Scan(WireMap_t* map)
+{
+    WireMapHal_BeginScan();
+
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        map->rows[i] = WireMapHal_Probe(i);
+    }
+
+    WireMapHal_EndScan();
+}
+
+void WireMap_Analyze(const WireMap_t* map, WireMapReport_t* report)
+{
+    // Far conductors reached from more than one near conductor
+    uint8_t seen_mask = 0U;
+    uint8_t shared_mask = 0U;
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        shared_mask |= (uint8_t)(seen_mask & map->rows[i]);
+        seen_mask |= map->rows[i];
+    }
+
+    report->ok_mask = 0U;
+    report->open_mask = 0U;
+    report->short_mask = 0U;
+    report->crossed_mask = 0U;
+
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        uint8_t row = map->rows[i];
+        uint8_t near_mask = (uint8_t)(1U << i);
+
+        report->far_conductor[i] = WIREMAP_NO_CONDUCTOR;
+
+        if (row == 0U)
+        {
+            report->open_mask |= near_mask;
+        }
+        else if (((row & (uint8_t)(row - 1U)) != 0U) || ((row & shared_mask) != 0U))
+        {
+            // More than one far pin, or a far pin shared with another conductor
+            report->short_mask |= near_mask;
+        }
+        else
+        {
+            uint8_t far = 0U;
+            while ((row >> far) != 1U)
+            {
+                far++;
+            }
+            report->far_conductor[i] = far;
+
+            if (row == near_mask)
+            {
+                report->ok_mask |= near_mask;
+            }
+            else
+            {
+                report->crossed_mask |= near_mask;
+            }
+        }
+    }
+}
+
+uint8_t WireMap_IsEqual(const WireMap_t* a, const WireMap_t* b)
+{
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        if (a->rows[i] != b->rows[i])
+        {
+            return 0U;
+        }
+    }
+
+    return 1U;
+}
@@ -0,0 +1,63 @@
+#ifndef WIREMAP_H
+#define WIREMAP_H
+
+#include <stdint.h>
+
+// Configuration constants
+#define WIREMAP_CONDUCTOR_COUNT     8U     /**< Conductors in an RJ45 cable */
+#define WIREMAP_NO_CONDUCTOR        0xFFU  /**< Far conductor of an open or shorted near conductor */
+
+// Type definitions
+/**
+ * @brief 8x8 connectivity bitmatrix
+ * @details Bit J of rows[I] is set when far-end conductor J was high while
+ *          near-end conductor I was driven. A good straight cable gives
+ *          rows[I] == (1 << I).
+ */
+typedef struct
+{
+    uint8_t rows[WIREMAP_CONDUCTOR_COUNT];  /**< Sense bitmask per driven conductor */
+} WireMap_t;
+
+/**
+ * @brief Per-conductor interpretation of a connectivity matrix
+ * @details Every near conductor is in exactly one of the four masks
+ */
+typedef struct
+{
+    uint8_t ok_mask;             /**< Conductors connected only to their own far pin */
+    uint8_t open_mask;           /**< Conductors connected to no far pin */
+    uint8_t short_mask;          /**< Conductors sharing a far pin with another conductor */
+    uint8_t crossed_mask;        /**< Conductors connected to exactly one other far pin */
+    uint8_t far_conductor[WIREMAP_CONDUCTOR_COUNT]; /**< Far conductor reached, or WIREMAP_NO_CONDUCTOR */
+} WireMapReport_t;
+
+// Public API functions
+
+/**
+ * @brief Initialize drive and sense lines
+ */
+void WireMap_Init(void);
+
+/**
+ * @brief Drive each conductor in turn and record all 8 far-end levels
+ * @details Takes a few microseconds per conductor. The drive lines are the
+ *          LED pins, whose output configuration is restored afterwards.
+ * @param map Pointer to matrix to fill
+ */
+void WireMap_Scan(WireMap_t* map);
+
+/**
+ * @brief Classify every conductor of a matrix as ok, open, shorted or crossed
+ * @param map Pointer to scanned matrix
+ * @param report Pointer to report to fill
+ */
+void WireMap_Analyze(const WireMap_t* map, WireMapReport_t* report);
+
+/**
+ * @brief Compare two matrices
+ * @return uint8_t 1 if both matrices are identical, 0 otherwise
+ */
+uint8_t WireMap_IsEqual(const WireMap_t* a, const WireMap_t* b);
+
+#endif /* WIREMAP_H */
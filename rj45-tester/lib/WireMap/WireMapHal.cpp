@@ -0,0 +1,74 @@
+#include "WireMapHal.h"
+#include "Board.h"
+#include "BoardHal.h"
+
+// Private constants
+#define HAL_SETTLE_LOOPS            24U    /**< Busy loops for a driven line to reach the far end (~2 us) */
+#define HAL_DISCHARGE_LOOPS         12U    /**< Busy loops to pull a probed line back low (~1 us) */
+
+static const BoardPin_t drive_pins[BOARD_CONDUCTOR_COUNT] = BOARD_DRIVE_PINS;
+static GPIO_TypeDef* const gpio_ports[BOARD_PORT_COUNT] = BOARD_GPIO_PORTS;
+
+// Private variables
+static BoardJackState_t saved_jack; /**< Drive lines before the scan */
+
+// Private function prototypes
+static void SettleDelay(uint32_t loops);
+
+// Public API Implementation
+
+void WireMapHal_Init(void)
+{
+    RCC->APB2PCENR |= RCC_APB2Periph_GPIOA | RCC_APB2Periph_GPIOC | RCC_APB2Periph_GPIOD;
+
+    // Far jack sense lines read low unless a driven conductor reaches them
+    GPIOC->BCR = BOARD_SENSE_PORTC_MASK;
+    GPIOD->BCR = BOARD_SENSE_PORTD_MASK;
+    BoardHal_ConfigurePort(BOARD_PORT_C, BOARD_SENSE_PORTC_MASK, BOARD_GPIO_CFG_INPUT_PULL);
+    BoardHal_ConfigurePort(BOARD_PORT_D, BOARD_SENSE_PORTD_MASK, BOARD_GPIO_CFG_INPUT_PULL);
+}
+
+void WireMapHal_BeginScan(void)
+{
+    // Drive lines become pulled-down inputs, other pins are left alone
+    BoardHal_SaveJack(&saved_jack, drive_pins);
+    BoardHal_SetJack(&saved_jack, BOARD_GPIO_CFG_INPUT_PULL);
+}
+
+uint8_t WireMapHal_Probe(uint8_t conductor)
+{
+    GPIO_TypeDef* port = gpio_ports[drive_pins[conductor].port];
+    uint32_t pin_mask = 1UL << drive_pins[conductor].pin;
+
+    // OUTDR is already low, so the pin starts as a low output, then goes high
+    BoardHal_ConfigurePin(&drive_pins[conductor], BOARD_GPIO_CFG_OUTPUT_PP);
+    port->BSHR = pin_mask;
+    SettleDelay(HAL_SETTLE_LOOPS);
+
+    // Both sense ports back to back
+    uint32_t portc = GPIOC->INDR;
+    uint32_t portd = GPIOD->INDR;
+
+    // Actively discharge the conductor before the next probe
+    port->BCR = pin_mask;
+    SettleDelay(HAL_DISCHARGE_LOOPS);
+    BoardHal_ConfigurePin(&drive_pins[conductor], BOARD_GPIO_CFG_INPUT_PULL);
+
+    return BOARD_SENSE_PACK(portc, portd);
+}
+
+void WireMapHal_EndScan(void)
+{
+    BoardHal_RestoreJack(&saved_jack);
+}
+
+// Private function implementations
+
+static void SettleDelay(uint32_t loops)
+{
+    while (loops > 0U)
+    {
+        __asm__ volatile ("nop");
+        loops--;
+    }
+}
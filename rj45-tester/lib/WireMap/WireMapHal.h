@@ -0,0 +1,37 @@
+#ifndef WIREMAPHAL_H
+#define WIREMAPHAL_H
+
+#include <stdint.h>
+
+/**
+ * @file WireMapHal.h
+ * @brief GPIO access used by the WireMap scan engine
+ * @details Implemented for the tester board in WireMapHal.cpp. Host builds
+ *          provide their own implementation to run the scan logic against
+ *          modeled cables.
+ */
+
+/**
+ * @brief Configure sense lines as inputs with pull-down
+ */
+void WireMapHal_Init(void);
+
+/**
+ * @brief Save drive line configuration and release all drive lines
+ */
+void WireMapHal_BeginScan(void);
+
+/**
+ * @brief Drive one conductor high and read all far-end levels
+ * @details The conductor is discharged and released again before returning
+ * @param conductor Near-end conductor index (0-7)
+ * @return uint8_t Far-end levels, bit N for conductor N
+ */
+uint8_t WireMapHal_Probe(uint8_t conductor);
+
+/**
+ * @brief Restore drive line configuration saved by WireMapHal_BeginScan
+ */
+void WireMapHal_EndScan(void);
+
+#endif /* WIREMAPHAL_H */
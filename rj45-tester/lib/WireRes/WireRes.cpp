@@ -0,0 +1,201 @@
+#include "WireRes.h"
+#include "WireResHal.h"
+
+// Private constants
+#define WIRERES_FULL_SCALE          ((uint32_t)WIRERESHAL_ADC_FULL_SCALE << WIRERES_EXTRA_BITS)
+#define WIRERES_MAX_DROP_UV         4000000UL /**< Keeps drop x 1000 within 32 bits */
+
+// Private variables
+// Path resistance of the zero cable; until WireRes_SetZero() driver resistance is included
+static uint32_t zero_mohm[WIRERES_CONDUCTOR_COUNT];
+
+// Private function prototypes
+static uint8_t PathResistance(const WireResLevels_t* levels, uint32_t path_mohm[WIRERES_CONDUCTOR_COUNT]);
+static uint8_t FlagHigh(const uint16_t* resistance_mohm, uint8_t group_mask, uint32_t min_excess);
+static uint16_t MedianOf(const uint16_t* values, uint8_t valid_mask);
+
+// Public API Implementation
+
+void WireRes_Measure(WireResResult_t* result)
+{
+    WireResLevels_t levels;
+
+    WireRes_Sample(&levels);
+    WireRes_Analyze(&levels, result);
+}
+
+void WireRes_Sample(WireResLevels_t* levels)
+{
+    for (uint8_t i = 0U; i < WIRERES_CONDUCTOR_COUNT; i++)
+    {
+        levels->drive[i] = 0U;
+
+        // Both far read samples back to back, the supply has no time to move in between
+        if (!(WIRERES_NEAR_MASK & (1U << i)))
+        {
+            WireResHal_Select(i, 0U);
+            levels->drive[i] = WireRes_Oversample(WIRERES_FAR_SAMPLE_COUNT);
+            WireResHal_Release();
+        }
+
+        WireResHal_Select(i, 1U);
+        levels->sense[i] = WireRes_Oversample((WIRERES_NEAR_MASK & (1U << i)) ? WIRERES_SAMPLE_COUNT :
+                                              WIRERES_FAR_SAMPLE_COUNT);
+        WireResHal_Release();
+    }
+
+    WireResHal_Select(WIRERESHAL_VREF, 1U);
+    levels->vref = WireRes_Oversample(WIRERES_SAMPLE_COUNT);
+    WireResHal_Release();
+}
+
+uint16_t WireRes_Oversample(uint32_t count)
+{
+    uint16_t samples[WIRERES_BURST_SIZE];
+    uint32_t sum = 0U;
+
+    for (uint32_t taken = 0U; taken < count; taken += WIRERES_BURST_SIZE)
+    {
+        WireResHal_Burst(samples, WIRERES_BURST_SIZE);
+        for (uint8_t i = 0U; i < WIRERES_BURST_SIZE; i++)
+        {
+            sum += samples[i];
+        }
+    }
+
+    // Mean in 1/2^WIRERES_EXTRA_BITS steps, rounded; 512 x 1023 << 5 fits 32 bits
+    return (uint16_t)(((sum << WIRERES_EXTRA_BITS) + (count / 2U)) / count);
+}
+
+void WireRes_Analyze(const WireResLevels_t* levels, WireResResult_t* result)
+{
+    uint32_t path_mohm[WIRERES_CONDUCTOR_COUNT];
+
+    result->vdd_mv = (uint16_t)((levels->vref > 0U) ? ((WIRERES_VREFINT_MV * WIRERES_FULL_SCALE) / levels->vref) : 0U);
+    result->unmeasured_mask = PathResistance(levels, path_mohm);
+
+    for (uint8_t i = 0U; i < WIRERES_CONDUCTOR_COUNT; i++)
+    {
+        if (result->unmeasured_mask & (1U << i))
+        {
+            result->resistance_mohm[i] = WIRERES_NOT_MEASURED;
+            continue;
+        }
+
+        // The zero cable carried the same driver and board resistance
+        uint32_t mohm = (path_mohm[i] > zero_mohm[i]) ? (path_mohm[i] - zero_mohm[i]) : 0U;
+        result->resistance_mohm[i] = (uint16_t)((mohm < WIRERES_NOT_MEASURED) ? mohm : (WIRERES_NOT_MEASURED - 1U));
+    }
+
+    uint8_t valid_mask = (uint8_t)~result->unmeasured_mask;
+    result->cable_mohm = MedianOf(result->resistance_mohm, valid_mask);
+    result->high_mask = FlagHigh(result->resistance_mohm, valid_mask & WIRERES_NEAR_MASK,
+                                 WIRERES_NEAR_EXCESS_MOHM) |
+                        FlagHigh(result->resistance_mohm, valid_mask & (uint8_t)~WIRERES_NEAR_MASK,
+                                 WIRERES_FAR_EXCESS_MOHM);
+}
+
+void WireRes_SetZero(const WireResLevels_t* levels)
+{
+    uint32_t path_mohm[WIRERES_CONDUCTOR_COUNT];
+    uint8_t unmeasured = PathResistance(levels, path_mohm);
+
+    for (uint8_t i = 0U; i < WIRERES_CONDUCTOR_COUNT; i++)
+    {
+        zero_mohm[i] = (unmeasured & (1U << i)) ? 0U : path_mohm[i];
+    }
+}
+
+// Private function implementations
+
+static uint8_t PathResistance(const WireResLevels_t* levels, uint32_t path_mohm[WIRERES_CONDUCTOR_COUNT])
+{
+    // The ADC is ratiometric to VDD, the reference gives the size of a level
+    uint32_t uv_per_level_x256 = (levels->vref > 0U) ? ((WIRERES_VREFINT_MV * 256000UL) / levels->vref) : 0U;
+    uint8_t unmeasured = 0U;
+
+    for (uint8_t i = 0U; i < WIRERES_CONDUCTOR_COUNT; i++)
+    {
+        uint32_t sense = (levels->sense[i] < WIRERES_FULL_SCALE) ? levels->sense[i] : (WIRERES_FULL_SCALE - 1U);
+        uint32_t sense_uv = (sense * uv_per_level_x256) / 256U;
+        uint32_t top;
+        uint32_t current_ua;
+
+        // The load sets the current: the LED on a near line, the pull-down on a far line
+        if (WIRERES_NEAR_MASK & (1U << i))
+        {
+            top = WIRERES_FULL_SCALE;
+            current_ua = (sense_uv > (WIRERES_LED_FORWARD_MV * 1000UL)) ?
+                         (sense_uv - (WIRERES_LED_FORWARD_MV * 1000UL)) / WIRERES_LED_OHMS : 0U;
+        }
+        else
+        {
+            top = levels->drive[i];
+            current_ua = sense_uv / WIRERES_PULLDOWN_OHMS;
+        }
+
+        if (current_ua < WIRERES_MIN_CURRENT_UA)
+        {
+            unmeasured |= (uint8_t)(1U << i);
+            path_mohm[i] = 0U;
+            continue;
+        }
+
+        // Near read: VDD to the pin, driver included. Far read: driving pin to the pin
+        uint32_t drop_uv = (top > sense) ? (((top - sense) * uv_per_level_x256) / 256U) : 0U;
+        if (drop_uv > WIRERES_MAX_DROP_UV)
+        {
+            drop_uv = WIRERES_MAX_DROP_UV;
+        }
+        path_mohm[i] = (drop_uv * 1000UL) / current_ua;
+    }
+
+    return unmeasured;
+}
+
+static uint8_t FlagHigh(const uint16_t* resistance_mohm, uint8_t group_mask, uint32_t min_excess)
+{
+    uint16_t median = MedianOf(resistance_mohm, group_mask);
+    uint8_t high = 0U;
+
+    // All conductors of a cable have the same length, a bad joint stands out
+    uint32_t excess = ((uint32_t)median * WIRERES_EXCESS_PERCENT) / 100U;
+    if (excess < min_excess)
+    {
+        excess = min_excess;
+    }
+
+    for (uint8_t i = 0U; i < WIRERES_CONDUCTOR_COUNT; i++)
+    {
+        if ((group_mask & (1U << i)) && (resistance_mohm[i] > (median + excess)))
+        {
+            high |= (uint8_t)(1U << i);
+        }
+    }
+    return high;
+}
+
+static uint16_t MedianOf(const uint16_t* values, uint8_t valid_mask)
+{
+    uint16_t sorted[WIRERES_CONDUCTOR_COUNT];
+    uint8_t count = 0U;
+
+    // Insertion sort of the valid values, at most 8
+    for (uint8_t i = 0U; i < WIRERES_CONDUCTOR_COUNT; i++)
+    {
+        if (!(valid_mask & (1U << i)))
+        {
+            continue;
+        }
+        uint8_t j = count;
+        while ((j > 0U) && (sorted[j - 1U] > values[i]))
+        {
+            sorted[j] = sorted[j - 1U];
+            j--;
+        }
+        sorted[j] = values[i];
+        count++;
+    }
+
+    return (count > 0U) ? sorted[count / 2U] : 0U;
+}
@@ -0,0 +1,96 @@
+#ifndef WIRERES_H
+#define WIRERES_H
+
+#include <stdint.h>
+
+// Configuration constants
+#define WIRERES_CONDUCTOR_COUNT     8U
+#define WIRERES_NEAR_MASK           0xE1U   /**< Conductors read at the near jack, BOARD_ADC_NEAR_MASK */
+#define WIRERES_EXTRA_BITS          5U      /**< Levels are kept in 1/32 of an ADC step */
+#define WIRERES_SAMPLE_COUNT        256U    /**< Conversions per near read input and the reference, 4 bits gained */
+#define WIRERES_FAR_SAMPLE_COUNT    512U    /**< Conversions per far read input, its drop is only a few ADC levels */
+#define WIRERES_BURST_SIZE          64U     /**< Conversions per DMA burst, kept on the stack */
+#define WIRERES_VREFINT_MV          1200UL  /**< Internal reference voltage */
+#define WIRERES_LED_OHMS            330UL   /**< LED series resistor, load of conductors read at the near jack */
+#define WIRERES_LED_FORWARD_MV      1900UL  /**< LED forward voltage at a few mA */
+#define WIRERES_PULLDOWN_OHMS       35000UL /**< Typical internal pull-down, load of conductors read at the far jack */
+#define WIRERES_MIN_CURRENT_UA      20UL    /**< Less current than this: conductor open, nothing to measure */
+#define WIRERES_NEAR_EXCESS_MOHM    5000UL  /**< Near read conductor this much above its group median is a bad joint... */
+#define WIRERES_FAR_EXCESS_MOHM     20000UL /**< Far read conductor, ~100 uA gives a drop of only a few ADC levels... */
+#define WIRERES_EXCESS_PERCENT      25UL    /**< ...or this share above the median, whichever is larger */
+#define WIRERES_NOT_MEASURED        0xFFFFU /**< Resistance of a conductor without current */
+
+// Type definitions
+/**
+ * @brief Oversampled ADC levels of one measurement
+ * @details Levels are in 1/2^WIRERES_EXTRA_BITS of an ADC step.
+ */
+typedef struct
+{
+    uint16_t sense[WIRERES_CONDUCTOR_COUNT]; /**< ADC end of each conductor with the measuring current */
+    uint16_t drive[WIRERES_CONDUCTOR_COUNT]; /**< ADC end without current, far read conductors only */
+    uint16_t vref;               /**< Internal reference */
+} WireResLevels_t;
+
+/**
+ * @brief Resistance estimate of one measurement
+ * @details Resistances are relative to the cable used for WireRes_SetZero(),
+ *          board and driver resistance are removed that way.
+ */
+typedef struct
+{
+    uint16_t resistance_mohm[WIRERES_CONDUCTOR_COUNT]; /**< Conductor resistance or WIRERES_NOT_MEASURED */
+    uint16_t cable_mohm;         /**< Median conductor resistance */
+    uint16_t vdd_mv;             /**< Supply voltage from the internal reference */
+    uint8_t unmeasured_mask;     /**< Conductors without measuring current: open or far end unplugged */
+    uint8_t high_mask;           /**< Conductors clearly above their group median: bad joint or corroded contact */
+} WireResResult_t;
+
+// Public API functions
+
+/**
+ * @brief Oversample all 8 conductors and the internal reference, then analyze
+ * @details 8 x WIRERES_FAR_SAMPLE_COUNT and 5 x WIRERES_SAMPLE_COUNT
+ *          conversions, about 4 ms
+ * @param result Pointer to result to fill
+ */
+void WireRes_Measure(WireResResult_t* result);
+
+/**
+ * @brief Oversample the levels of all 8 conductors and the internal reference
+ * @details Far read conductors are sampled twice: without current for the
+ *          level of the driving pin, then with the pull-down current. The
+ *          drop between the two is the conductor alone, whatever the supply
+ *          and the LED on the driving pin do.
+ * @param levels Output, oversampled levels
+ */
+void WireRes_Sample(WireResLevels_t* levels);
+
+/**
+ * @brief Oversample the selected ADC input
+ * @details Averages the conversions and keeps WIRERES_EXTRA_BITS more bits
+ *          than a single conversion, rounded. 4^n conversions carry n of them,
+ *          the rest is noise.
+ * @param count Conversions to take, a multiple of WIRERES_BURST_SIZE
+ * @return uint16_t Level in 1/2^WIRERES_EXTRA_BITS of an ADC step
+ */
+uint16_t WireRes_Oversample(uint32_t count);
+
+/**
+ * @brief Turn oversampled levels into resistances and flag bad conductors
+ * @details Near and far read conductors have different loads, so each group
+ *          is compared with its own median: a pull-down that is off its
+ *          typical value scales all far read conductors alike.
+ * @param levels Levels from WireRes_Sample()
+ * @param result Pointer to result to fill
+ */
+void WireRes_Analyze(const WireResLevels_t* levels, WireResResult_t* result);
+
+/**
+ * @brief Store the path resistance of a short good cable as zero
+ * @details Driver, board and jack resistance are removed from later results
+ * @param levels Levels of that cable, from WireRes_Sample()
+ */
+void WireRes_SetZero(const WireResLevels_t* levels);
+
+#endif /* WIRERES_H */
@@ -0,0 +1,127 @@
+#include "WireResHal.h"
+#include "WireRes.h"
+#include "Board.h"
+#include "BoardHal.h"
+
+// Private constants
+#define HAL_SETTLE_LOOPS            240U   /**< Busy loops for a selected input to settle (~20 us) */
+#define HAL_SAMPTR_FAST             0x0UL  /**< 3 cycle sample time for the low impedance conductors */
+#define HAL_SAMPTR_VREF             0x4UL  /**< 43 cycle sample time, the reference needs it */
+
+static_assert(WIRERES_NEAR_MASK == BOARD_ADC_NEAR_MASK, "WireRes load model must match the board");
+
+static const BoardPin_t drive_pins[BOARD_CONDUCTOR_COUNT] = BOARD_DRIVE_PINS;
+static const BoardPin_t sense_pins[BOARD_CONDUCTOR_COUNT] = BOARD_SENSE_PINS;
+static const uint8_t adc_channels[BOARD_CONDUCTOR_COUNT] = BOARD_ADC_CHANNELS;
+static GPIO_TypeDef* const gpio_ports[BOARD_PORT_COUNT] = BOARD_GPIO_PORTS;
+
+// Private variables
+static BoardJackState_t saved_near;
+static BoardJackState_t saved_far;
+
+// Private function prototypes
+static void SetPin(const BoardPin_t* pin, uint32_t cfg, uint8_t level);
+
+// Public API Implementation
+
+void WireResHal_Init(void)
+{
+    RCC->APB2PCENR |= RCC_APB2Periph_ADC1;
+    RCC->AHBPCENR |= RCC_AHBPeriph_DMA1;
+
+    ADC1->CTLR2 |= ADC_ADON;
+    ADC1->CTLR2 |= ADC_RSTCAL;
+    while (ADC1->CTLR2 & ADC_RSTCAL)
+    {
+    }
+    ADC1->CTLR2 |= ADC_CAL;
+    while (ADC1->CTLR2 & ADC_CAL)
+    {
+    }
+
+    // Channels 0-7 are driven by a GPIO through tens of ohms, short sampling is enough
+    uint32_t samptr = 0U;
+    for (uint8_t channel = 0U; channel < 8U; channel++)
+    {
+        samptr |= HAL_SAMPTR_FAST << (channel * 3U);
+    }
+    samptr |= HAL_SAMPTR_VREF << (BOARD_ADC_VREF_CHANNEL * 3U);
+    ADC1->SAMPTR2 = samptr;
+
+    // Software trigger, one channel in the regular sequence, reference on
+    ADC1->RSQR1 = 0U;
+    ADC1->CTLR2 |= ADC_EXTSEL | ADC_EXTTRIG | ADC_TSVREFE;
+}
+
+void WireResHal_Select(uint8_t conductor, uint8_t loaded)
+{
+    uint8_t channel = BOARD_ADC_VREF_CHANNEL;
+
+    BoardHal_SaveJack(&saved_near, drive_pins);
+    BoardHal_SaveJack(&saved_far, sense_pins);
+
+    if (conductor < BOARD_CONDUCTOR_COUNT)
+    {
+        channel = adc_channels[conductor];
+
+        if (BOARD_ADC_NEAR_MASK & (1U << conductor))
+        {
+            // Far end drives, the LED and its resistor on the near line carry the current
+            SetPin(&drive_pins[conductor], BOARD_GPIO_CFG_ANALOG, 0U);
+            SetPin(&sense_pins[conductor], BOARD_GPIO_CFG_OUTPUT_PP, 1U);
+        }
+        else
+        {
+            // Near end drives, the far pull-down carries the current and the ADC reads the pad;
+            // pulled up instead, the pad follows the driving pin
+            SetPin(&drive_pins[conductor], BOARD_GPIO_CFG_OUTPUT_PP, 1U);
+            SetPin(&sense_pins[conductor], BOARD_GPIO_CFG_INPUT_PULL, loaded ? 0U : 1U);
+        }
+    }
+
+    ADC1->RSQR3 = channel;
+
+    for (uint32_t loops = HAL_SETTLE_LOOPS; loops > 0U; loops--)
+    {
+        __asm__ volatile ("nop");
+    }
+}
+
+void WireResHal_Burst(uint16_t* samples, uint8_t count)
+{
+    // The conversion still running when the last burst stopped is dropped here
+    (void)ADC1->RDATAR;
+
+    DMA1_Channel1->CFGR = 0U;
+    DMA1_Channel1->PADDR = (uint32_t)(uintptr_t)&ADC1->RDATAR;
+    DMA1_Channel1->MADDR = (uint32_t)(uintptr_t)samples;
+    DMA1_Channel1->CNTR = count;
+    DMA1_Channel1->CFGR = DMA_MemoryInc_Enable | DMA_PeripheralDataSize_HalfWord |
+                          DMA_MemoryDataSize_HalfWord | DMA_CFGR1_EN;
+
+    // Continuous conversions back to back, DMA takes each result before the next one
+    ADC1->CTLR2 |= ADC_CONT | ADC_DMA;
+    ADC1->CTLR2 |= ADC_SWSTART;
+
+    while ((DMA1->INTFR & DMA1_FLAG_TC1) == 0U)
+    {
+    }
+
+    ADC1->CTLR2 &= ~(ADC_CONT | ADC_DMA);
+    DMA1_Channel1->CFGR = 0U;
+    DMA1->INTFCR = DMA1_IT_GL1;
+}
+
+void WireResHal_Release(void)
+{
+    BoardHal_RestoreJack(&saved_far);
+    BoardHal_RestoreJack(&saved_near);
+}
+
+// Private function implementations
+
+static void SetPin(const BoardPin_t* pin, uint32_t cfg, uint8_t level)
+{
+    gpio_ports[pin->port]->BSHR = level ? (1UL << pin->pin) : (1UL << (pin->pin + 16U));
+    BoardHal_ConfigurePin(pin, cfg);
+}
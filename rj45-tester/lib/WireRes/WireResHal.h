@@ -0,0 +1,46 @@
+#ifndef WIRERESHAL_H
+#define WIRERESHAL_H
+
+#include <stdint.h>
+
+/**
+ * @file WireResHal.h
+ * @brief ADC bursts used by the WireRes resistance estimator
+ * @details Implemented for the tester board in WireResHal.cpp. The host model
+ *          in tools/wire-res-model.cpp provides its own implementation.
+ */
+
+#define WIRERESHAL_VREF             8U     /**< Select the internal reference instead of a conductor */
+#define WIRERESHAL_ADC_FULL_SCALE   1024U  /**< Conversion result range, 10 bits */
+
+/**
+ * @brief Enable and calibrate the ADC and its DMA channel
+ */
+void WireResHal_Init(void);
+
+/**
+ * @brief Put a measuring current through one conductor and connect its ADC end
+ * @details Conductors read at the near jack are driven high from the far
+ *          jack, the LED on the near line is the load. Conductors read at
+ *          the far jack are driven high from the near jack, the far pull-down
+ *          is the load; with loaded 0 the far pin is pulled up instead, no
+ *          current flows and the ADC reads the level of the driving pin.
+ *          The far end must be plugged in.
+ * @param conductor Conductor index (0-7) or WIRERESHAL_VREF
+ * @param loaded 1 for the measuring current, 0 for the drive level (far read conductors only)
+ */
+void WireResHal_Select(uint8_t conductor, uint8_t loaded);
+
+/**
+ * @brief Convert the selected input back to back, moved to memory by DMA
+ * @param samples Buffer for the conversion results
+ * @param count Number of conversions
+ */
+void WireResHal_Burst(uint16_t* samples, uint8_t count);
+
+/**
+ * @brief Restore the drive and sense lines changed by WireResHal_Select()
+ */
+void WireResHal_Release(void);
+
+#endif /* WIRERESHAL_H */
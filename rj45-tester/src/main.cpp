@@ -1,10 +1,36 @@
 #include <Arduino.h>
+#include "BatchTest.h"
+#include "Board.h"
+#include "BoardHal.h"
+#include "CableRc.h"
+#include "CableRcHal.h"
+#include "Console.h"
+#include "ConsoleHal.h"
+#include "DualLink.h"
+#include "DualLinkHal.h"
+#include "FaultHunt.h"
+#include "FlashLog.h"
+#include "LedPort.h"
+#include "LedPov.h"
+#ifdef RJ45_PANEL
+#include "PanelScan.h"
+#endif
+#include "ResultProtocol.h"
+#include "ResultStream.h"
+#include "Standby.h"
+#include "UartLog.h"
+#include "WireClass.h"
+#include "WireMap.h"
+#include "WireRes.h"
+#include "WireResHal.h"
 
 /**
  * RJ45 Ethernet Cable Tester - Optimized Version
  *
- * This firmware sequentially tests each wire in an RJ45 Ethernet cable by
- * lighting up corresponding LEDs one at a time. This helps identify:
+ * This firmware drives each wire of an RJ45 Ethernet cable in turn and reads
+ * all 8 wires at the far end, building an 8x8 connectivity matrix. The LEDs
+ * show the state of all 8 wires at once, multiplexed from a timer interrupt.
+ * This helps identify:
  * - Broken wires
  * - Incorrect pin connections
  * - Short circuits between wires
@@ -14,7 +40,7 @@
  * - CH32V003F4P6 microcontroller (or compatible)
  * - 8 LEDs connected to the specified pins
  * - Current limiting resistors for LEDs
- * - RJ45 connector for cable testing
+ * - RJ45 connectors for both cable ends (far end on the sense lines, see Board.h)
  */
 
 // ============================
@@ -23,74 +49,1502 @@
 
 #define RJ45_PIN_COUNT 8
 
-// Timing configuration (milliseconds)
-#define LED_DISPLAY_TIME    200   // Time each LED stays on
-#define CYCLE_PAUSE_TIME    500   // Pause between test cycles
-#define TEST_CYCLE_COMPLETE RJ45_PIN_COUNT  // Special index for "all LEDs off"
-
-// Standard RJ45 pinout mapping
-// Pin numbers correspond to RJ45 connector pins 1-8
-const uint8_t LED_PINS[RJ45_PIN_COUNT] = {
-  PC4,  // Pin 1 - White-Orange
-  PC3,  // Pin 2 - Orange
-  PC2,  // Pin 3 - White-Green
-  PC1,  // Pin 4 - Blue
-  PC0,  // Pin 5 - White-Blue
-  PA2,  // Pin 6 - Green
-  PA1,  // Pin 7 - White-Brown
-  PD6   // Pin 8 - Brown
+// Timing configuration (milliseconds), scan and report periods are defaults for the console
+#define SCAN_PERIOD_MS      10    // Time between wiremap scans
+#define REPORT_PERIOD_MS    100   // Time between checks for a changed result
+#define COMMAND_PERIOD_MS   5     // Time between reads of the console ring, which fills in 11 ms
+#define HUNT_REPORT_TIME    1000  // Time between scan rate reports in fault hunting mode
+#define BATCH_SCAN_PERIOD_MS 2    // Time between scans in batch test mode
+#define STANDBY_IDLE_MS     30000 // Time without a cable in wiremap mode before standby, 0 disables it
+#define STANDBY_CHECK_MS    100   // Time between checks for standby
+#define DUAL_SERVE_MS       5     // Time a remote tester answers the link per loop pass, under the 11 ms console ring
+
+// Verdict a cable, or every port of a patch panel, must have to pass
+#define BATCH_EXPECTED_VERDICT WIRECLASS_STRAIGHT
+
+// Panel port verdicts logged per report in binary mode, the log ring holds 16
+#define PANEL_LOGS_PER_REPORT 8
+
+// Cable length measurement
+#define CABLE_RC_CATEGORY   CABLERC_CAT5E // Category of the cables being measured
+#define CABLE_RC_CAL_CM     1000          // Length of the reference cable used by 'k'
+
+// Set to 1 to print the cycle cost of both LED output paths at startup
+#define LED_OUTPUT_BENCHMARK 0
+
+// Set to 1 to raise the RJ45 pin 1 line (PC4) at the end of setup(), the boot
+// time marker for a scope triggered on power-on (README: Bare-Metal Build)
+#define BOOT_TIME_MARKER 0
+
+// Serial pins, remapped so PD5 is free as a sense line
+#define SERIAL_TX_PIN       PD0
+#define SERIAL_RX_PIN       PD1
+
+// LED and drive lines of RJ45 pins 1-8, assigned in Board.h
+const BoardPin_t LED_PINS[RJ45_PIN_COUNT] = BOARD_DRIVE_PINS;
+
+// Arduino pin number of each board port pin, NO_PIN where the package has none
+const uint8_t NO_PIN = 0xFF;
+const uint8_t ARDUINO_PINS[BOARD_PORT_COUNT][8] = {
+  { NO_PIN, PA1, PA2, NO_PIN, NO_PIN, NO_PIN, NO_PIN, NO_PIN },
+  { PC0, PC1, PC2, PC3, PC4, PC5, PC6, PC7 },
+  { PD0, PD1, PD2, PD3, PD4, PD5, PD6, PD7 }
 };
 
 /**
- * Control individual LED state with safety checks
- * @param pinIndex Index of LED to control (0-7 for individual LEDs, 8 for all off)
+ * Arduino pin number of an LED
+ * @param conductor Conductor index, RJ45 pin - 1
+ */
+uint8_t ledPin(uint8_t conductor) {
+  return ARDUINO_PINS[LED_PINS[conductor].port][LED_PINS[conductor].pin];
+}
+
+#if LED_OUTPUT_BENCHMARK
+/**
+ * Compare per-pin digitalWrite() with the port-mask path for one display step
  */
-void controlTestLED(uint8_t pinIndex) {
-  // Validate input range
-  if (pinIndex > RJ45_PIN_COUNT) {
-    return; // Invalid index, ignore
+void benchmarkLEDOutput() {
+  // SysTick runs at HCLK or HCLK/8 depending on STCLK
+  uint32_t cyclesPerTick = BoardHal_SysTickDivider();
+
+  uint32_t start = SysTick->CNT;
+  for (uint8_t i = 0; i < RJ45_PIN_COUNT; i++) {
+    digitalWrite(ledPin(i), LOW);
   }
-  
-  // Turn off all LEDs first
+  digitalWrite(ledPin(0), HIGH);
+  uint32_t digitalWriteCycles = BoardHal_SysTickElapsed(&start) * cyclesPerTick;
+
+  LedPort_Write(0x01U);
+  uint32_t portMaskCycles = BoardHal_SysTickElapsed(&start) * cyclesPerTick;
+
+  LedPort_Write(0xFFU);
+  uint32_t allOnCycles = BoardHal_SysTickElapsed(&start) * cyclesPerTick;
+  LedPort_Write(0x00U);
+
+  Serial.print("LED step, digitalWrite x9: ");
+  Serial.print(digitalWriteCycles);
+  Serial.print(" cycles, port mask: ");
+  Serial.print(portMaskCycles);
+  Serial.print(" cycles, all 8 on: ");
+  Serial.print(allOnCycles);
+  Serial.println(" cycles");
+}
+#endif
+
+/**
+ * Print a scan result over serial
+ * @param map Scanned connectivity matrix
+ * @param report Per-conductor interpretation of the matrix
+ */
+void printWireMap(const WireMap_t* map, const WireMapReport_t* report) {
   for (uint8_t i = 0; i < RJ45_PIN_COUNT; i++) {
-    digitalWrite(LED_PINS[i], LOW);
+    Serial.print("Pin ");
+    Serial.print(i + 1);
+    Serial.print(": ");
+
+    if (report->open_mask & (1U << i)) {
+      Serial.println("OPEN");
+    } else if (report->short_mask & (1U << i)) {
+      Serial.print("SHORT to far pins 0x");
+      Serial.println(map->rows[i], HEX);
+    } else if (report->crossed_mask & (1U << i)) {
+      Serial.print("CROSSED to ");
+      Serial.println(report->far_conductor[i] + 1);
+    } else {
+      Serial.println("OK");
+    }
   }
-  
-  // Turn on selected LED if valid individual pin requested
-  if (pinIndex < RJ45_PIN_COUNT) {
-    digitalWrite(LED_PINS[pinIndex], HIGH);
+}
+
+/**
+ * Print the wiring verdict of a scan result over serial
+ * @param verdict Classification of the matrix
+ * @param reversedPairs Swapped pairs for WIRECLASS_REVERSED_PAIR, bit 0 = pins 1-2 ... bit 3 = pins 7-8
+ */
+void printWireClass(WireClass_t verdict, uint8_t reversedPairs) {
+  static const char* const PAIR_NAMES[4] = { "1-2", "3-6", "4-5", "7-8" };
+
+  Serial.print("Cable: ");
+  Serial.print(WireClass_GetName(verdict));
+  for (uint8_t p = 0; p < 4; p++) {
+    if (reversedPairs & (1U << p)) {
+      Serial.print(' ');
+      Serial.print(PAIR_NAMES[p]);
+    }
+  }
+  Serial.println();
+}
+
+// ============================
+// TASKS
+// ============================
+
+// Operating modes
+enum TesterMode {
+  MODE_WIREMAP,  // Scan every SCAN_PERIOD_MS and step through the matrix
+  MODE_HUNT,     // Rescan back to back and latch intermittent faults
+  MODE_BATCH     // Detect insertion, latch pass/fail and count cables
+};
+
+// What the LEDs show
+enum DisplayMode {
+  DISPLAY_RESULT,  // Conductor styles of the current mode
+  DISPLAY_OFF,     // All dark
+  DISPLAY_TEST     // All on, to check the LEDs
+};
+
+// Settings changed from the console
+uint32_t scanPeriodMs = SCAN_PERIOD_MS;
+uint32_t batchScanPeriodMs = BATCH_SCAN_PERIOD_MS;
+uint32_t reportPeriodMs = REPORT_PERIOD_MS;
+uint32_t standbyIdleMs = STANDBY_IDLE_MS;
+DisplayMode display = DISPLAY_RESULT;
+
+// Latest scan result, shared by all tasks
+TesterMode mode = MODE_WIREMAP;
+WireMap_t currentMap = {{0}};
+WireMapReport_t currentReport;
+WireClass_t currentClass = WIRECLASS_NO_CABLE;
+uint8_t currentReversedPairs = 0;
+FaultHunt_t hunt;
+uint32_t huntWindowStartMs = 0;
+uint32_t huntWindowStartScans = 0;
+bool binaryOutput = false;  // Stream binary frames instead of text
+BatchTest_t batch;
+bool batchVerdictPending = false;
+uint8_t historyDumpNext = 0;   // Next history record to print or stream
+uint8_t historyDumpCount = 0;  // Records in the running dump
+uint32_t scanCount = 0;        // Scans since power-up, for the stats
+Console_t console;
+uint32_t consoleLines = 0;
+uint32_t consoleErrors = 0;
+
+#ifndef RJ45_PANEL
+// Dual-unit mode: two testers linked over the brown pair of the cable
+enum DualRole {
+  DUAL_OFF,     // Single tester, the far jack reads the cable back
+  DUAL_MAIN,    // Scans are answered by a remote tester at the far end
+  DUAL_REMOTE   // The near jack only answers a main tester
+};
+
+DualRole dualRole = DUAL_OFF;
+DualLink_t dualLink;
+bool dualRemoteLost = false;   // Main: the last remote scan got no answer
+bool dualScanActive = false;   // Main: a remote scan is collected by dualTask
+uint32_t dualScanUs = 0;       // Main: link time of the last remote scan, summed over its slices
+uint32_t dualSliceUs = 0;      // Main: link time of the remote scan in progress
+#endif
+
+#ifdef RJ45_PANEL
+// Patch panel build: all ports are scanned, the first failing one is the current result
+PanelMap_t panel;
+WireClass_t panelVerdicts[PANELSCAN_PORT_COUNT];
+uint8_t panelShownPort = 0;
+
+/**
+ * Scan every panel port and make the first failing one, or port 1, the current matrix
+ */
+void scanPanel() {
+  PanelScan_Scan(&panel);
+
+  bool failed = false;
+  panelShownPort = 0;
+  for (uint8_t p = 0; p < PANELSCAN_PORT_COUNT; p++) {
+    WireMapReport_t report;
+    uint8_t reversedPairs;
+
+    WireMap_Analyze(&panel.maps[p], &report);
+    panelVerdicts[p] = WireClass_Classify(&report, &reversedPairs);
+    if (panel.foreign_mask[p]) {
+      panelVerdicts[p] = WIRECLASS_MISWIRED;
+    }
+    if (!failed && panelVerdicts[p] != BATCH_EXPECTED_VERDICT) {
+      panelShownPort = p;
+      failed = true;
+    }
+  }
+  currentMap = panel.maps[panelShownPort];
+}
+#endif
+
+/**
+ * Interpret the current matrix into the shared report and verdict
+ */
+void classifyCurrent() {
+  WireMap_Analyze(&currentMap, &currentReport);
+  currentClass = WireClass_Classify(&currentReport, &currentReversedPairs);
+#ifdef RJ45_PANEL
+  // Wires from another port look fine in the port's own matrix
+  if (panel.foreign_mask[panelShownPort]) {
+    currentClass = WIRECLASS_MISWIRED;
+  }
+#endif
+}
+
+/**
+ * Restart the scan rate measurement window
+ */
+void restartHuntWindow() {
+  huntWindowStartMs = millis();
+  huntWindowStartScans = hunt.scan_count;
+}
+
+void printStatus(UartLogFormat_t id);
+void updateResult();
+
+#ifndef RJ45_PANEL
+/**
+ * Start collecting the wiremap from a remote tester, dualTask runs the link
+ */
+void startRemoteScan() {
+  // The link lines are the LED lines, keep the display interrupt off them until the scan ends
+  LedPov_Suspend();
+  DualLinkHal_Begin();
+  DualLink_StartScan(&dualLink);
+  dualSliceUs = 0;
+  dualScanActive = true;
+}
+
+/**
+ * Release the link lines of a remote scan, finished or not
+ */
+void stopRemoteScan() {
+  DualLinkHal_Drive(DUALLINK_NO_CONDUCTOR);
+  DualLinkHal_End();
+  LedPov_Resume();
+  dualScanActive = false;
+}
+
+/**
+ * Run the remote scan up to the next conductor, about 1.8 ms of link time
+ * @return DUALLINK_EVENT_DONE or DUALLINK_EVENT_FAILED once the scan ended, else DUALLINK_EVENT_DRIVE
+ */
+DualLinkEvent_t scanRemoteSlice() {
+  uint32_t startUs = micros();
+  DualLinkEvent_t event = DUALLINK_EVENT_NONE;
+
+  // A slice ends with the next conductor driven and its request not yet sent, so the
+  // line is quiet while the other tasks run; the link counts ticks, not time
+  while (event == DUALLINK_EVENT_NONE) {
+    uint8_t lineOut;
+
+    DualLinkHal_WaitTick();
+    event = DualLink_Tick(&dualLink, DualLinkHal_ReadLine(), &lineOut);
+    DualLinkHal_SetLine(lineOut);
+    if (event == DUALLINK_EVENT_DRIVE) {
+      DualLinkHal_Drive(dualLink.conductor);
+    }
+  }
+
+  dualSliceUs += micros() - startUs;
+  return event;
+}
+
+/**
+ * Answer the main tester for DUAL_SERVE_MS, finishing a frame in progress
+ */
+void serveRemote() {
+  uint32_t startMs = millis();
+
+  // The link lines stay set up between calls, so a request is never met by an output
+  while (millis() - startMs < DUAL_SERVE_MS || !DualLink_IsIdle(&dualLink)) {
+    uint8_t lineOut;
+
+    DualLinkHal_WaitTick();
+    DualLinkEvent_t event = DualLink_Tick(&dualLink, DualLinkHal_ReadLine(), &lineOut);
+    DualLinkHal_SetLine(lineOut);
+    if (event == DUALLINK_EVENT_SAMPLE) {
+      DualLink_Reply(&dualLink, DualLinkHal_Sense() & (uint8_t)~DUALLINK_LINK_MASK);
+    }
+  }
+
+  // The last tick may have left the stop bit on the line
+  DualLinkHal_SetLine(DUALLINK_LINE_RELEASE);
+}
+
+/**
+ * Switch the dual-unit role
+ * @param newRole Role to take; a remote holds its near jack until it leaves the role
+ */
+void setDualRole(DualRole newRole) {
+  if (dualScanActive) {
+    stopRemoteScan();
+  }
+  if (dualRole == DUAL_REMOTE) {
+    DualLinkHal_End();
+    LedPov_Resume();
+  }
+  dualRole = newRole;
+  dualRemoteLost = false;
+  DualLink_Init(&dualLink, (dualRole == DUAL_REMOTE) ? DUALLINK_REMOTE : DUALLINK_MAIN);
+
+  if (dualRole == DUAL_REMOTE) {
+    // The remote LEDs light from the main tester's drive, not from the display
+    LedPov_Suspend();
+    DualLinkHal_Begin();
+  }
+}
+#endif
+
+/**
+ * Scan the cable and update the shared result
+ */
+void scanTask() {
+#ifdef RJ45_PANEL
+  scanPanel();
+#else
+  if (dualRole == DUAL_REMOTE) {
+    // dualTask answers the link
+    return;
+  } else if (dualRole == DUAL_MAIN) {
+    // dualTask collects the map a conductor per loop pass and updates the result
+    if (!dualScanActive) {
+      startRemoteScan();
+    }
+    return;
+  } else {
+    // The drive lines are the LED lines, keep the display interrupt off them
+    LedPov_Suspend();
+    WireMap_Scan(&currentMap);
+    LedPov_Resume();
+  }
+#endif
+  updateResult();
+}
+
+/**
+ * Run the dual-unit link for one loop pass: serve the main tester, or advance a remote scan
+ */
+void dualTask() {
+#ifndef RJ45_PANEL
+  if (dualRole == DUAL_REMOTE) {
+    serveRemote();
+    return;
+  }
+  if (!dualScanActive) {
+    return;
+  }
+
+  DualLinkEvent_t event = scanRemoteSlice();
+  if (event != DUALLINK_EVENT_DONE && event != DUALLINK_EVENT_FAILED) {
+    return;
+  }
+  stopRemoteScan();
+  dualScanUs = dualSliceUs;
+
+  bool answered = (event == DUALLINK_EVENT_DONE);
+  for (uint8_t i = 0; i < RJ45_PIN_COUNT; i++) {
+    currentMap.rows[i] = answered ? dualLink.map.rows[i] : 0;
+  }
+  if (!answered && !dualRemoteLost) {
+    printStatus(LOG_DUAL_NO_REMOTE);
+  }
+  dualRemoteLost = !answered;
+  updateResult();
+#endif
+}
+
+/**
+ * Take a new matrix in currentMap into the result of the current mode
+ */
+void updateResult() {
+  scanCount++;
+
+  if (mode == MODE_HUNT) {
+    // Only scans that start a new glitch are streamed, the rest are counted
+    uint8_t newGlitches = FaultHunt_Update(&hunt, &currentMap);
+    if (newGlitches && binaryOutput) {
+      UartLog_Write(LOG_GLITCH, newGlitches, hunt.scan_count);
+      classifyCurrent();
+      ResultStream_SendScan(&currentMap, currentClass, currentReversedPairs);
+    }
+  } else if (mode == MODE_BATCH) {
+    classifyCurrent();
+    if (BatchTest_Update(&batch, &currentMap, currentClass, millis())) {
+      batchVerdictPending = true;
+      if (binaryOutput) {
+        ResultStream_SendScan(&currentMap, currentClass, currentReversedPairs);
+      }
+    }
+  } else {
+    classifyCurrent();
+    if (binaryOutput) {
+      ResultStream_SendScan(&currentMap, currentClass, currentReversedPairs);
+    }
+  }
+}
+
+/**
+ * LED appearance of one conductor in the latest result
+ * @param pin Conductor index
+ * @return Style shown by the multiplexed display
+ */
+LedPovStyle_t conductorStyle(uint8_t pin) {
+  uint8_t pinMask = 1U << pin;
+
+#ifndef RJ45_PANEL
+  // The link pair idles low: a lit LED would send a start bit or short the ground
+  if (dualRole == DUAL_MAIN && (DUALLINK_LINK_MASK & pinMask)) {
+    return LEDPOV_OFF;
+  }
+#endif
+
+  if (display == DISPLAY_OFF) {
+    return LEDPOV_OFF;
+  } else if (display == DISPLAY_TEST) {
+    return LEDPOV_ON;
+  }
+
+  if (mode == MODE_HUNT) {
+    // Latched faults blink until cleared, conductors that never glitched stay on
+    if (hunt.latched_mask & pinMask) {
+      return LEDPOV_BLINK_FAST;
+    }
+    return (hunt.reference.rows[pin] != 0) ? LEDPOV_ON : LEDPOV_OFF;
+  }
+
+  if (mode == MODE_BATCH) {
+    // Pass lights everything, a failure shows its faults like wiremap mode
+    if (batch.state == BATCHTEST_WAITING) {
+      return LEDPOV_OFF;
+    } else if (batch.state == BATCHTEST_CONFIRMING) {
+      return LEDPOV_DIM;
+    } else if (batch.state == BATCHTEST_PASSED) {
+      return LEDPOV_ON;
+    }
+  }
+
+  if (currentReport.open_mask & pinMask) {
+    return LEDPOV_DIM;
+  } else if (currentReport.short_mask & pinMask) {
+    return LEDPOV_BLINK_SLOW;
+  } else if (currentReport.crossed_mask & pinMask) {
+    return LEDPOV_BLINK_FAST;
+  }
+  return LEDPOV_ON;
+}
+
+/**
+ * Show the whole latest result at once on the multiplexed display
+ */
+void displayTask() {
+  static LedPovStyle_t shown[RJ45_PIN_COUNT];
+  static bool valid = false;
+  bool changed = !valid;
+
+  for (uint8_t i = 0; i < RJ45_PIN_COUNT; i++) {
+    LedPovStyle_t style = conductorStyle(i);
+    if (style != shown[i]) {
+      shown[i] = style;
+      LedPov_SetLed(i, style);
+      changed = true;
+    }
+  }
+
+  // Rendering the frames is only needed when a conductor changed
+  if (changed) {
+    LedPov_Commit();
+    valid = true;
+  }
+}
+
+/**
+ * Print scan rate and glitch counters once per HUNT_REPORT_TIME
+ */
+void reportHunt() {
+  uint32_t now = millis();
+  uint32_t elapsed = now - huntWindowStartMs;
+  if (elapsed < HUNT_REPORT_TIME) {
+    return;
+  }
+
+  // Kept to one short line, scanning pauses while Serial is sending
+  uint32_t scans = hunt.scan_count - huntWindowStartScans;
+  Serial.print("Hunt ");
+  Serial.print((scans * 1000UL) / elapsed);
+  Serial.print(" scans/s, glitches");
+  for (uint8_t i = 0; i < RJ45_PIN_COUNT; i++) {
+    Serial.print(' ');
+    Serial.print(hunt.glitch_count[i]);
+  }
+  Serial.println();
+
+  restartHuntWindow();
+}
+
+/**
+ * Queue a test result for the flash history
+ * @param kind What produced the result
+ * @param map Matrix to store, its verdict is stored with it
+ */
+void recordHistory(FlashLogKind_t kind, const WireMap_t* map) {
+  FlashLogRecord_t record = {};
+  WireMapReport_t report;
+
+  record.time_ms = millis();
+  record.kind = kind;
+  WireMap_Analyze(map, &report);
+  record.verdict = WireClass_Classify(&report, &record.reversed_pairs);
+  for (uint8_t i = 0; i < RJ45_PIN_COUNT; i++) {
+    record.rows[i] = map->rows[i];
+  }
+
+  if (kind == FLASHLOG_KIND_HUNT) {
+    for (uint8_t i = 0; i < RJ45_PIN_COUNT; i++) {
+      record.glitch_count[i] = (hunt.glitch_count[i] > 255) ? 255 : hunt.glitch_count[i];
+    }
+    record.latched_mask = hunt.latched_mask;
+  }
+
+  // Programmed later by streamTask(), between scans
+  FlashLog_Write(&record);
+}
+
+/**
+ * Store the worst state of the running fault hunt
+ */
+void recordHunt() {
+  WireMap_t worst;
+
+  FaultHunt_GetWorst(&hunt, &worst);
+  recordHistory(FLASHLOG_KIND_HUNT, &worst);
+}
+
+/**
+ * Store a wiremap result once it stayed the same for a whole report period
+ */
+void recordWiremap() {
+  static WireMap_t candidate = {{0}};
+  static WireMap_t recorded = {{0}};
+  bool stable = WireMap_IsEqual(&currentMap, &candidate);
+
+  candidate = currentMap;
+  if (!stable || WireMap_IsEqual(&currentMap, &recorded)) {
+    return;
+  }
+
+  // Unplugging clears the last record, so the same cable plugged again is stored again
+  recorded = currentMap;
+  if (currentClass != WIRECLASS_NO_CABLE) {
+    recordHistory(FLASHLOG_KIND_SCAN, &currentMap);
+  }
+}
+
+/**
+ * Print one stored history record as a line
+ * @param record Record read from the history
+ */
+void printHistoryRecord(const FlashLogRecord_t* record) {
+  static const char* const KIND_NAMES[3] = { "SCAN", "HUNT", "BATCH" };
+
+  Serial.print('#');
+  Serial.print(record->sequence);
+  Serial.print(" boot ");
+  Serial.print(record->boot);
+  Serial.print(" at ");
+  Serial.print(record->time_ms);
+  Serial.print(" ms ");
+  Serial.print(KIND_NAMES[record->kind < 3 ? record->kind : 0]);
+  Serial.print(' ');
+  Serial.print(WireClass_GetName((WireClass_t)record->verdict));
+  Serial.print(" rows");
+  for (uint8_t r = 0; r < RJ45_PIN_COUNT; r++) {
+    Serial.print(' ');
+    Serial.print(record->rows[r], HEX);
+  }
+  if (record->kind == FLASHLOG_KIND_HUNT) {
+    Serial.print(" glitches");
+    for (uint8_t r = 0; r < RJ45_PIN_COUNT; r++) {
+      Serial.print(' ');
+      Serial.print(record->glitch_count[r]);
+    }
+  }
+  Serial.println();
+}
+
+/**
+ * Print the latched verdict with the session counters
+ */
+void reportBatch() {
+  uint8_t last = (batch.ttv_next + BATCHTEST_HISTORY_SIZE - 1) % BATCHTEST_HISTORY_SIZE;
+  bool unstable = (batch.state == BATCHTEST_FAILED) && (batch.verdict == batch.expected);
+
+  Serial.print(batch.verdict_ms);
+  Serial.print(" ms Cable ");
+  Serial.print(batch.tested);
+  Serial.print(batch.state == BATCHTEST_PASSED ? ": PASS " : ": FAIL ");
+  Serial.print(unstable ? "UNSTABLE" : WireClass_GetName(batch.verdict));
+  Serial.print(" in ");
+  Serial.print(batch.ttv_ms[last]);
+  Serial.print(" ms | passed ");
+  Serial.print(batch.passed);
+  Serial.print(", failed ");
+  Serial.print(batch.failed);
+  Serial.print(" | ");
+  Serial.print(BatchTest_GetCablesPerHour(&batch));
+  Serial.print(" cables/h, median ");
+  Serial.print(BatchTest_GetMedianTimeToVerdict(&batch));
+  Serial.println(" ms");
+}
+
+/**
+ * Log how many frames and log records were lost since the last report
+ */
+void reportDrops() {
+  static uint32_t lastFramesDropped = 0;
+  static uint32_t lastRecordsDropped = 0;
+  uint32_t framesDropped = ResultStream_GetDroppedCount();
+  uint32_t recordsDropped = UartLog_GetDroppedCount();
+
+  if (framesDropped != lastFramesDropped) {
+    UartLog_Write(LOG_FRAMES_DROPPED, framesDropped - lastFramesDropped, 0);
+    lastFramesDropped = framesDropped;
+  }
+  if (recordsDropped != lastRecordsDropped) {
+    UartLog_Write(LOG_RECORDS_DROPPED, recordsDropped - lastRecordsDropped, 0);
+    lastRecordsDropped = recordsDropped;
+  }
+}
+
+#ifdef RJ45_PANEL
+/**
+ * Print or log every panel port whose verdict changed, then the pass count
+ */
+void reportPanel() {
+  static WireClass_t lastVerdicts[PANELSCAN_PORT_COUNT];
+  uint8_t logged = 0;
+  uint8_t passed = 0;
+  bool changed = false;
+
+  for (uint8_t p = 0; p < PANELSCAN_PORT_COUNT; p++) {
+    if (panelVerdicts[p] == BATCH_EXPECTED_VERDICT) {
+      passed++;
+    }
+    if (panelVerdicts[p] == lastVerdicts[p]) {
+      continue;
+    }
+
+    // Ports over the limit stay changed and follow in the next report
+    if (binaryOutput) {
+      if (logged == PANEL_LOGS_PER_REPORT) {
+        return;
+      }
+      UartLog_Write(LOG_PANEL_PORT, p + 1, panelVerdicts[p]);
+      logged++;
+    } else {
+      Serial.print("Port ");
+      Serial.print(p + 1);
+      Serial.print(": ");
+      Serial.print(WireClass_GetName(panelVerdicts[p]));
+      if (panel.foreign_mask[p]) {
+        Serial.print(", wires from another port on 0x");
+        Serial.print(panel.foreign_mask[p], HEX);
+      }
+      Serial.println();
+    }
+    lastVerdicts[p] = panelVerdicts[p];
+    changed = true;
+  }
+
+  if (!changed) {
+    return;
+  }
+  if (binaryOutput) {
+    UartLog_Write(LOG_PANEL_SUMMARY, passed, PANELSCAN_PORT_COUNT);
+  } else {
+    Serial.print("Panel: ");
+    Serial.print(passed);
+    Serial.print(" of ");
+    Serial.print(PANELSCAN_PORT_COUNT);
+    Serial.println(" ports pass");
+  }
+}
+#endif
+
+/**
+ * Print the result whenever it changed
+ */
+void reportTask() {
+  if (mode == MODE_BATCH) {
+    if (batchVerdictPending) {
+      batchVerdictPending = false;
+      recordHistory(FLASHLOG_KIND_BATCH, &batch.candidate);
+      if (binaryOutput) {
+        ResultStream_SendBatch(&batch);
+      } else {
+        reportBatch();
+      }
+    }
+    return;
+  }
+
+  if (mode == MODE_WIREMAP) {
+    recordWiremap();
+#ifdef RJ45_PANEL
+    reportPanel();
+#endif
+  }
+
+  // Scan frames are queued by scanTask(), only the counters are periodic
+  if (binaryOutput) {
+    if (mode == MODE_HUNT) {
+      ResultStream_SendHunt(&hunt);
+    }
+    reportDrops();
+    return;
+  }
+
+  if (mode == MODE_HUNT) {
+    reportHunt();
+    return;
+  }
+
+#ifndef RJ45_PANEL
+  static WireMap_t lastMap = {{0}};
+
+  if (!WireMap_IsEqual(&currentMap, &lastMap)) {
+    printWireClass(currentClass, currentReversedPairs);
+    printWireMap(&currentMap, &currentReport);
+    lastMap = currentMap;
+  }
+#endif
+}
+
+/**
+ * Frame buffered log records and history dumps, the DMA sends them without
+ * the CPU, then do at most one flash operation for the history
+ */
+void streamTask() {
+  UartLog_Task();
+
+  // One text line per pass, so the console ring is read between lines
+  if (!binaryOutput && historyDumpNext < historyDumpCount) {
+    FlashLogRecord_t record;
+    if (FlashLog_Read(historyDumpNext, &record)) {
+      printHistoryRecord(&record);
+    }
+    historyDumpNext++;
+  }
+
+  while (binaryOutput && historyDumpNext < historyDumpCount &&
+         ResultStream_GetFreeSpace() >= RESULTPROTOCOL_MAX_ENCODED) {
+    FlashLogRecord_t record;
+    if (FlashLog_Read(historyDumpNext, &record)) {
+      ResultStream_SendHistory(&record);
+    }
+    historyDumpNext++;
+  }
+
+  FlashLog_Task();
+}
+
+/**
+ * Print a status line, or log it as a record while binary frames are streamed
+ * @param id Format table entry without arguments
+ */
+void printStatus(UartLogFormat_t id) {
+  if (binaryOutput) {
+    UartLog_Write(id, 0, 0);
+  } else {
+    Serial.println(UartLog_GetFormat(id));
+  }
+}
+
+/**
+ * Time the charge of all conductors, far end unplugged
+ * @param timeNs Charge time per conductor in ns
+ */
+void measureCableRc(uint32_t timeNs[RJ45_PIN_COUNT]) {
+  // The conductors are the LED lines, keep the display interrupt off them
+  LedPov_Suspend();
+  CableRcHal_Measure(timeNs);
+  LedPov_Resume();
+}
+
+/**
+ * Measure and print capacitance and length of every conductor
+ */
+void reportCableRc() {
+  uint32_t timeNs[RJ45_PIN_COUNT];
+  CableRcResult_t rc;
+
+  measureCableRc(timeNs);
+  CableRc_Analyze(timeNs, CABLE_RC_CATEGORY, &rc);
+
+  if (rc.loaded_mask == 0xFF) {
+    if (binaryOutput) {
+      UartLog_Write(LOG_RC_LOADED, rc.loaded_mask, 0);
+    } else {
+      Serial.println("Length: far end connected, unplug it");
+    }
+    return;
+  }
+
+  if (binaryOutput) {
+    for (uint8_t i = 0; i < RJ45_PIN_COUNT; i++) {
+      UartLog_Write(LOG_RC_CONDUCTOR, i + 1, rc.capacitance_pf[i]);
+    }
+    UartLog_Write(LOG_RC_LENGTH, rc.cable_length_cm, rc.open_mask);
+    if (rc.loaded_mask) {
+      UartLog_Write(LOG_RC_LOADED, rc.loaded_mask, 0);
+    }
+    return;
+  }
+
+  Serial.print("Length: ");
+  Serial.print(rc.cable_length_cm);
+  Serial.println(" cm");
+  for (uint8_t i = 0; i < RJ45_PIN_COUNT; i++) {
+    Serial.print("Pin ");
+    Serial.print(i + 1);
+    if (rc.loaded_mask & (1U << i)) {
+      Serial.println(": LOADED");
+      continue;
+    }
+    Serial.print(": ");
+    Serial.print(rc.capacitance_pf[i]);
+    Serial.print(" pF");
+    if (rc.open_mask & (1U << i)) {
+      Serial.print(", OPEN at ");
+      Serial.print(rc.length_cm[i]);
+      Serial.print(" cm");
+    }
+    Serial.println();
+  }
+}
+
+#ifndef RJ45_PANEL
+/**
+ * Measure the resistance of every conductor and print it, or store it as zero
+ * @param zero Store the plugged cable as zero instead of printing
+ */
+void reportWireRes(bool zero) {
+  WireResLevels_t levels;
+  WireResResult_t res;
+
+  // The conductors are the LED lines, keep the display interrupt off them
+  LedPov_Suspend();
+  WireRes_Sample(&levels);
+  LedPov_Resume();
+
+  WireRes_Analyze(&levels, &res);
+  if (zero) {
+    WireRes_SetZero(&levels);
+    printStatus(LOG_RES_ZEROED);
+  }
+
+  if (binaryOutput) {
+    if (!zero) {
+      for (uint8_t i = 0; i < RJ45_PIN_COUNT; i++) {
+        if (!(res.unmeasured_mask & (1U << i))) {
+          UartLog_Write(LOG_RES_CONDUCTOR, i + 1, res.resistance_mohm[i]);
+        }
+      }
+      UartLog_Write(LOG_RES_SUMMARY, res.cable_mohm, res.high_mask);
+      UartLog_Write(LOG_RES_SUPPLY, res.vdd_mv, 0);
+    }
+    if (res.unmeasured_mask) {
+      UartLog_Write(LOG_RES_UNMEASURED, res.unmeasured_mask, 0);
+    }
+    return;
+  }
+
+  if (zero) {
+    if (res.unmeasured_mask) {
+      Serial.println("Resistance: no current on some pins, far end plugged in?");
+    }
+    return;
+  }
+
+  Serial.print("Resistance: ");
+  Serial.print(res.cable_mohm);
+  Serial.print(" mOhm, VDD ");
+  Serial.print(res.vdd_mv);
+  Serial.println(" mV");
+  for (uint8_t i = 0; i < RJ45_PIN_COUNT; i++) {
+    Serial.print("Pin ");
+    Serial.print(i + 1);
+    if (res.unmeasured_mask & (1U << i)) {
+      Serial.println(": OPEN");
+      continue;
+    }
+    Serial.print(": ");
+    Serial.print(res.resistance_mohm[i]);
+    Serial.print(" mOhm");
+    if (res.high_mask & (1U << i)) {
+      Serial.print(", HIGH");
+    }
+    Serial.println();
+  }
+}
+
+/**
+ * Sleep in standby until a cable is inserted or a key is pressed, then
+ * report how long waking up took
+ */
+void enterStandby() {
+  uint16_t clockUs = 0;
+
+  // Clocks stop in standby, let queued output finish first
+  printStatus(LOG_STANDBY);
+  UartLog_Task();
+  while (ResultStream_IsBusy()) {
+  }
+
+  // The drive lines are the LED lines, low outputs so a cable pulls a sense line down
+  LedPov_Suspend();
+  LedPort_Write(0x00U);
+  StandbyWake_t wake = Standby_Enter(&clockUs);
+  uint32_t wokeUs = micros();
+  LedPov_Resume();
+
+  if (wake == STANDBY_ABORTED) {
+    printStatus(LOG_STANDBY_ABORTED);
+  } else if (wake == STANDBY_WAKE_SERIAL) {
+    if (binaryOutput) {
+      UartLog_Write(LOG_WAKE_SERIAL, clockUs, 0);
+    } else {
+      Serial.print("Key woke the tester, PLL ");
+      Serial.print(clockUs);
+      Serial.println(" us");
+    }
+  } else {
+    // Scan right away instead of waiting for the scan task
+    scanTask();
+    uint32_t verdictUs = micros() - wokeUs;
+    if (binaryOutput) {
+      UartLog_Write(LOG_WAKE_CABLE, clockUs, verdictUs);
+    } else {
+      Serial.print("Cable woke the tester, PLL ");
+      Serial.print(clockUs);
+      Serial.print(" us, verdict ");
+      Serial.print(verdictUs);
+      Serial.println(" us later");
+    }
+  }
+}
+#endif
+
+/**
+ * Enter standby once no cable was seen for standbyIdleMs in wiremap mode
+ */
+void standbyTask() {
+#ifndef RJ45_PANEL
+  static uint32_t idleSinceMs = 0;
+  uint32_t now = millis();
+
+  // Hunt and batch mode time their results, millis() stops in standby
+  // A dual-unit cable never reaches the own far jack, so it could not wake the tester
+  if (mode != MODE_WIREMAP || currentClass != WIRECLASS_NO_CABLE || standbyIdleMs == 0 ||
+      historyDumpNext < historyDumpCount || dualRole != DUAL_OFF) {
+    idleSinceMs = now;
+    return;
+  }
+  if (now - idleSinceMs < standbyIdleMs) {
+    return;
+  }
+
+  enterStandby();
+  idleSinceMs = millis();
+#endif
+}
+
+/**
+ * Periodic task with its own rate
+ */
+struct Task {
+  void (*run)();
+  uint32_t periodMs;
+  uint32_t nextRunMs;
+};
+
+void commandTask();
+void applySettings();
+
+// Task indices, order of the tasks table
+enum { TASK_SCAN, TASK_DUAL, TASK_DISPLAY, TASK_REPORT, TASK_COMMAND, TASK_STREAM, TASK_STANDBY };
+
+Task tasks[] = {
+  { scanTask,    SCAN_PERIOD_MS,    0 },
+  { dualTask,    0,                 0 },
+  { displayTask, SCAN_PERIOD_MS,    0 },
+  { reportTask,  REPORT_PERIOD_MS,  0 },
+  { commandTask, COMMAND_PERIOD_MS, 0 },
+  { streamTask,  0,                 0 },
+  { standbyTask, STANDBY_CHECK_MS,  0 }
+};
+
+const uint8_t TASK_COUNT = sizeof(tasks) / sizeof(tasks[0]);
+
+/**
+ * Switch operating mode
+ * @param newMode Mode to enter; entering MODE_HUNT takes the current scan as
+ *                reference, entering MODE_BATCH starts a new session
+ */
+void setMode(TesterMode newMode) {
+  if (mode == MODE_HUNT) {
+    recordHunt();
+  }
+  mode = newMode;
+
+  if (mode == MODE_HUNT) {
+    FaultHunt_Reset(&hunt, &currentMap);
+    restartHuntWindow();
+    printStatus(LOG_MODE_HUNT);
+  } else if (mode == MODE_BATCH) {
+    BatchTest_Reset(&batch, BATCH_EXPECTED_VERDICT);
+    batchVerdictPending = false;
+    printStatus(LOG_MODE_BATCH);
+  } else {
+    printStatus(LOG_MODE_WIREMAP);
+  }
+  applySettings();
+}
+
+/**
+ * Apply the console settings to the task periods of the current mode
+ */
+void applySettings() {
+  if (mode == MODE_HUNT) {
+    // Scan on every loop pass, a full scan takes a few tens of microseconds
+    tasks[TASK_SCAN].periodMs = 0;
+  } else if (mode == MODE_BATCH) {
+    tasks[TASK_SCAN].periodMs = batchScanPeriodMs;
+  } else {
+    tasks[TASK_SCAN].periodMs = scanPeriodMs;
+  }
+  tasks[TASK_REPORT].periodMs = reportPeriodMs;
+}
+
+/**
+ * Check whether the remote role holds the near jack, and say so
+ * @return true if a measurement must leave the jack alone
+ */
+bool nearJackBusy() {
+#ifndef RJ45_PANEL
+  if (dualRole == DUAL_REMOTE) {
+    printStatus(LOG_DUAL_BUSY);
+    return true;
+  }
+  // A remote scan in progress gives the jack back, the next scan starts over
+  if (dualScanActive) {
+    stopRemoteScan();
+  }
+#endif
+  return false;
+}
+
+/**
+ * Run a single-letter command:
+ * 'h' fault hunting mode, 'p' batch test mode, 'n' normal wiremap mode,
+ * 'c' clear latched faults or batch counters,
+ * 'b' binary frame output, 't' text output,
+ * 'r' measure cable length, 'z' store the length zero with nothing plugged in,
+ * 'k' calibrate the length with a CABLE_RC_CAL_CM reference cable,
+ * 'd' dump the flash history
+ * @param key Command letter
+ * @return false if the letter is no command
+ */
+bool runKey(char key) {
+  switch (key) {
+    case 'h':
+      setMode(MODE_HUNT);
+      break;
+    case 'p':
+      setMode(MODE_BATCH);
+      break;
+    case 'n':
+      setMode(MODE_WIREMAP);
+      break;
+    case 'c':
+      if (mode == MODE_BATCH) {
+        BatchTest_Reset(&batch, BATCH_EXPECTED_VERDICT);
+        printStatus(LOG_BATCH_CLEARED);
+      } else {
+        // Only a hunt has a window to record; in wiremap mode 'c' just clears the latch
+        if (mode == MODE_HUNT) {
+          recordHunt();
+        }
+        FaultHunt_Reset(&hunt, &currentMap);
+        restartHuntWindow();
+        printStatus(LOG_HUNT_CLEARED);
+      }
+      break;
+    case 'b':
+      binaryOutput = true;
+      printStatus(LOG_BINARY_OUTPUT);
+      break;
+    case 't':
+      // Let queued frames finish so text does not land inside a frame
+      printStatus(LOG_TEXT_OUTPUT);
+      UartLog_Task();
+      while (ResultStream_IsBusy()) {
+      }
+      binaryOutput = false;
+      break;
+    case 'd':
+      // The stream task sends the records, one text line or as many frames as fit per pass
+      historyDumpNext = 0;
+      historyDumpCount = FlashLog_GetCount();
+      if (!binaryOutput) {
+        Serial.print("History: ");
+        Serial.print(historyDumpCount);
+        Serial.print(" records, boot ");
+        Serial.println(FlashLog_GetBoot());
+      }
+      break;
+    case 'r':
+      if (!nearJackBusy()) {
+        reportCableRc();
+      }
+      break;
+    case 'z': {
+      uint32_t timeNs[RJ45_PIN_COUNT];
+      if (nearJackBusy()) {
+        break;
+      }
+      measureCableRc(timeNs);
+      CableRc_SetZero(timeNs);
+      printStatus(LOG_RC_ZEROED);
+      break;
+    }
+    case 'k': {
+      uint32_t timeNs[RJ45_PIN_COUNT];
+      if (nearJackBusy()) {
+        break;
+      }
+      measureCableRc(timeNs);
+      if (!CableRc_Calibrate(CABLE_RC_CATEGORY, CABLE_RC_CAL_CM, timeNs)) {
+        printStatus(LOG_RC_CAL_FAILED);
+      } else if (binaryOutput) {
+        UartLog_Write(LOG_RC_CALIBRATED, CableRc_GetPfPerMetre(CABLE_RC_CATEGORY), 0);
+      } else {
+        Serial.print("Length calibrated to ");
+        Serial.print(CableRc_GetPfPerMetre(CABLE_RC_CATEGORY));
+        Serial.println(" pF/m");
+      }
+      break;
+    }
+    default:
+      return false;
+  }
+  return true;
+}
+
+/**
+ * Console setting with its range
+ */
+struct Setting {
+  const char* name;
+  const char* label;      // Text output, same wording as the log format
+  uint32_t* value;
+  uint32_t minMs;
+  uint32_t maxMs;
+  UartLogFormat_t log;
+};
+
+const Setting SETTINGS[] = {
+  { "scan",    "Scan period ",       &scanPeriodMs,      1,  1000,    LOG_SET_SCAN },
+  { "batch",   "Batch scan period ", &batchScanPeriodMs, 1,  1000,    LOG_SET_BATCH },
+  { "report",  "Report period ",     &reportPeriodMs,    10, 10000,   LOG_SET_REPORT },
+  { "standby", "Standby after ",     &standbyIdleMs,     0,  3600000, LOG_SET_STANDBY }
+};
+
+const uint8_t SETTING_COUNT = sizeof(SETTINGS) / sizeof(SETTINGS[0]);
+
+/**
+ * Find a word in a name table
+ * @param word Word to look up
+ * @param names Names, index matches the enum they belong to
+ * @param count Number of names
+ * @return Index of the name, count if not found
+ */
+uint8_t findName(const char* word, const char* const* names, uint8_t count) {
+  for (uint8_t i = 0; i < count; i++) {
+    if (strcmp(word, names[i]) == 0) {
+      return i;
+    }
+  }
+  return count;
+}
+
+/**
+ * Count and report a console line that could not be run
+ * @param id Format table entry without arguments
+ */
+void consoleError(UartLogFormat_t id) {
+  consoleErrors++;
+  printStatus(id);
+}
+
+/**
+ * Print the scan, output and console counters
+ */
+void printStats() {
+  static uint32_t lastMs = 0;
+  static uint32_t lastScans = 0;
+  uint32_t now = millis();
+  uint32_t rate = (now != lastMs) ? ((scanCount - lastScans) * 1000UL) / (now - lastMs) : 0;
+
+  lastMs = now;
+  lastScans = scanCount;
+
+  if (binaryOutput) {
+    UartLog_Write(LOG_STATS_UPTIME, now, scanCount);
+    UartLog_Write(LOG_STATS_RATE, rate, 0);
+    UartLog_Write(LOG_FRAMES_DROPPED, ResultStream_GetDroppedCount(), 0);
+    UartLog_Write(LOG_RECORDS_DROPPED, UartLog_GetDroppedCount(), 0);
+    UartLog_Write(LOG_STATS_HISTORY, FlashLog_GetCount(), FlashLog_GetBoot());
+    UartLog_Write(LOG_STATS_CONSOLE, consoleLines, consoleErrors);
+    UartLog_Write(LOG_CONSOLE_LOST, ConsoleHal_GetLostCount(), 0);
+    return;
+  }
+
+  Serial.print("Up ");
+  Serial.print(now);
+  Serial.print(" ms, ");
+  Serial.print(scanCount);
+  Serial.print(" scans, ");
+  Serial.print(rate);
+  Serial.println(" scans/s");
+  Serial.print("Dropped ");
+  Serial.print(ResultStream_GetDroppedCount());
+  Serial.print(" frames, ");
+  Serial.print(UartLog_GetDroppedCount());
+  Serial.println(" records");
+  Serial.print("History ");
+  Serial.print(FlashLog_GetCount());
+  Serial.print(" records, boot ");
+  Serial.println(FlashLog_GetBoot());
+  Serial.print("Console ");
+  Serial.print(consoleLines);
+  Serial.print(" lines, ");
+  Serial.print(consoleErrors);
+  Serial.print(" errors, ");
+  Serial.print(ConsoleHal_GetLostCount());
+  Serial.println(" bytes lost");
+}
+
+/**
+ * Show or change a period setting
+ * @param setting Setting named by the first word
+ * @param line Command line, an optional second word is the new value in ms
+ */
+void runSetting(const Setting* setting, const ConsoleLine_t* line) {
+  if (line->word_count > 1) {
+    uint32_t value;
+    if (!Console_ParseNumber(line->words[1], &value) ||
+        value < setting->minMs || value > setting->maxMs) {
+      consoleError(LOG_CONSOLE_BAD_ARG);
+      return;
+    }
+    *setting->value = value;
+    applySettings();
+  }
+
+  if (binaryOutput) {
+    UartLog_Write(setting->log, *setting->value, 0);
+  } else {
+    Serial.print(setting->label);
+    Serial.print(*setting->value);
+    Serial.println(" ms");
+  }
+}
+
+/**
+ * Run one console line: a command letter, 'mode', 'display', a period
+ * setting, 'stats', 'res', 'dual' or 'help'. Settings, modes and roles are shown
+ * when the value is left out.
+ * @param line Parsed command line
+ */
+void runCommand(const ConsoleLine_t* line) {
+  static const char* const MODE_NAMES[3] = { "wiremap", "hunt", "batch" };
+  static const char* const DISPLAY_NAMES[3] = { "on", "off", "test" };
+#ifndef RJ45_PANEL
+  static const char* const DUAL_NAMES[3] = { "off", "main", "remote" };
+#endif
+  const char* command = line->words[0];
+  bool hasValue = line->word_count > 1;
+
+  if (command[1] == '\0') {
+    if (hasValue || !runKey(command[0])) {
+      consoleError(LOG_CONSOLE_UNKNOWN);
+    }
+    return;
+  }
+
+  for (uint8_t i = 0; i < SETTING_COUNT; i++) {
+    if (strcmp(command, SETTINGS[i].name) == 0) {
+      runSetting(&SETTINGS[i], line);
+      return;
+    }
+  }
+
+  if (strcmp(command, "mode") == 0) {
+    if (!hasValue) {
+      printStatus((UartLogFormat_t)(LOG_MODE_WIREMAP + mode));
+      return;
+    }
+    uint8_t newMode = findName(line->words[1], MODE_NAMES, 3);
+    if (newMode == 3) {
+      consoleError(LOG_CONSOLE_BAD_ARG);
+      return;
+    }
+    setMode((TesterMode)newMode);
+  } else if (strcmp(command, "display") == 0) {
+    if (hasValue) {
+      uint8_t newDisplay = findName(line->words[1], DISPLAY_NAMES, 3);
+      if (newDisplay == 3) {
+        consoleError(LOG_CONSOLE_BAD_ARG);
+        return;
+      }
+      display = (DisplayMode)newDisplay;
+    }
+    printStatus((UartLogFormat_t)(LOG_DISPLAY_RESULT + display));
+  } else if (strcmp(command, "stats") == 0) {
+    printStats();
+#ifndef RJ45_PANEL
+  } else if (strcmp(command, "res") == 0) {
+    if (hasValue && strcmp(line->words[1], "zero") != 0) {
+      consoleError(LOG_CONSOLE_BAD_ARG);
+      return;
+    }
+    if (!nearJackBusy()) {
+      reportWireRes(hasValue);
+    }
+  } else if (strcmp(command, "dual") == 0) {
+    if (hasValue) {
+      uint8_t newRole = findName(line->words[1], DUAL_NAMES, 3);
+      if (newRole == 3) {
+        consoleError(LOG_CONSOLE_BAD_ARG);
+        return;
+      }
+      setDualRole((DualRole)newRole);
+    }
+    printStatus((UartLogFormat_t)(LOG_DUAL_OFF + dualRole));
+    if (dualRole == DUAL_MAIN && !hasValue) {
+      if (binaryOutput) {
+        UartLog_Write(LOG_DUAL_SCAN, dualScanUs, dualLink.retries);
+      } else {
+        Serial.print("Remote scan ");
+        Serial.print(dualScanUs);
+        Serial.print(" us, ");
+        Serial.print(dualLink.retries);
+        Serial.println(" retries");
+      }
+    }
+#endif
+  } else if (strcmp(command, "help") == 0) {
+    printStatus(LOG_CONSOLE_HELP);
+  } else {
+    consoleError(LOG_CONSOLE_UNKNOWN);
+  }
+}
+
+/**
+ * Parse received characters as they come, run each complete line
+ */
+void commandTask() {
+  int16_t received;
+
+  // Idle cost is one DMA counter read per COMMAND_PERIOD_MS
+  while ((received = ConsoleHal_Read()) != -1) {
+    ConsoleLine_t line;
+
+    if (received == CONSOLEHAL_OVERRUN) {
+      // Part of the line is gone, start over with the next character
+      Console_Init(&console);
+      consoleError(LOG_CONSOLE_OVERRUN);
+      continue;
+    }
+    ConsoleStatus_t status = Console_Feed(&console, (char)received, &line);
+
+    if (status == CONSOLE_LINE) {
+      consoleLines++;
+      runCommand(&line);
+    } else if (status == CONSOLE_OVERFLOW) {
+      consoleError(LOG_CONSOLE_TOO_LONG);
+    }
   }
-  // If pinIndex == RJ45_PIN_COUNT, all LEDs stay off (cycle complete)
 }
 
 /**
  * Initialize all test hardware
  */
 void setup() {
+  // Framework init before setup() shows up as time already on the ms timer
+  uint32_t setupStartUs = micros();
+
   // Initialize serial communication for debugging (optional)
+  Serial.setTx(SERIAL_TX_PIN);
+  Serial.setRx(SERIAL_RX_PIN);
   Serial.begin(115200);
+  ResultStream_Init();
+  ConsoleHal_Init();
+  Console_Init(&console);
+  FlashLog_Init();
   Serial.println("RJ45 Cable Tester Starting...");
   
   // Configure all LED pins as outputs and set initial state
   for (uint8_t i = 0; i < RJ45_PIN_COUNT; i++) {
-    pinMode(LED_PINS[i], OUTPUT);
-    digitalWrite(LED_PINS[i], LOW);
+    pinMode(ledPin(i), OUTPUT);
+  }
+  LedPort_Init();
+
+#if LED_OUTPUT_BENCHMARK
+  benchmarkLEDOutput();
+#endif
+
+  LedPov_Init();
+
+#ifdef RJ45_PANEL
+  // Patch panel front end on SPI1 instead of the far jack sense lines
+  PanelScan_Init();
+#else
+  // Configure far-end sense lines
+  WireMap_Init();
+  WireResHal_Init();
+#endif
+
+  // First runs right away, spread over the first milliseconds
+  uint32_t now = millis();
+  for (uint8_t i = 0; i < TASK_COUNT; i++) {
+    tasks[i].nextRunMs = now + i;
   }
   
-  Serial.println("Initialization complete. Ready for testing.");
+#if BOOT_TIME_MARKER
+  // First rising edge of PC4 since power-on, everything before it is boot time
+  LedPort_Write(0x01U);
+#endif
+
+  // Timer time only: reset, startup code and framework init before the timer are not included
+  uint32_t setupEndUs = micros();
+  Serial.print("Initialization complete. setup() ran from ");
+  Serial.print(setupStartUs);
+  Serial.print(" to ");
+  Serial.print(setupEndUs);
+#ifdef RJ45_BARE_METAL
+  Serial.println(" us of the ms timer (bare-metal build)");
+#else
+  Serial.println(" us of the ms timer (Arduino build)");
+#endif
 }
 
 /**
- * Main testing cycle - continuously test RJ45 cable
+ * Main testing cycle - run every task that is due, never blocks
  */
 void loop() {
-  // Test each pin sequentially
-  for (uint8_t pin = 0; pin < RJ45_PIN_COUNT; pin++) {
-    controlTestLED(pin);
-    delay(LED_DISPLAY_TIME);
+  uint32_t now = millis();
+
+  for (uint8_t i = 0; i < TASK_COUNT; i++) {
+    if ((int32_t)(now - tasks[i].nextRunMs) >= 0) {
+      tasks[i].nextRunMs += tasks[i].periodMs;
+
+      // Fell more than a period behind, resynchronize instead of bursting
+      if ((int32_t)(now - tasks[i].nextRunMs) >= 0) {
+        tasks[i].nextRunMs = now + tasks[i].periodMs;
+      }
+      tasks[i].run();
+    }
   }
-  
-  // Complete cycle - turn off all LEDs briefly
-  controlTestLED(TEST_CYCLE_COMPLETE);
-  delay(CYCLE_PAUSE_TIME);
 }
@@ -0,0 +1,252 @@
+/**
+ * @file cable-rc-hal-test.cpp
+ * @brief Host test of the charge timing in CableRcHal.cpp against a wrapping SysTick
+ * @details Builds the unchanged CableRcHal.cpp against tools/host/ch32v00x.h.
+ *          SysTick runs with the 1 ms reload of both builds, at HCLK and at
+ *          HCLK/8, from a random phase, and every register read advances
+ *          the simulated clock. Each pin reads high once it has been pulled
+ *          up for its charge time.
+ *
+ *          1. Random charge times up to CABLERCHAL_MAX_TIME_US are measured
+ *             within HOST_TOLERANCE_NS, also across the counter wrap
+ *          2. A pin that never charges, or charges too late, is reported as
+ *             CABLERCHAL_TIMEOUT within the timeout, alone and with the far
+ *             end plugged on all 8 conductors
+ *
+ *          A measurement still polling after HOST_HANG_US is a hang: the
+ *          test stops there and fails.
+ *
+ *          Build and run from the rj45-tester directory:
+ *          g++ -O2 -Wall -Itools/host -Ilib/Board -Ilib/CableRc tools/cable-rc-hal-test.cpp \
+ *              lib/CableRc/CableRcHal.cpp lib/Board/BoardHal.cpp -o cable-rc-hal-test
+ *          ./cable-rc-hal-test
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Board.h"
+#include "CableRcHal.h"
+
+// Configuration constants
+#define HOST_CORE_HZ                48000000UL
+#define HOST_CNT_READ_CYCLES        5U     /**< Cycles per SysTick read, about one polling loop pass... */
+#define HOST_INDR_READ_CYCLES       3U     /**< ...together with the input read */
+#define HOST_TOLERANCE_NS           500U   /**< Allowed charge time error, tick and loop quantization */
+#define HOST_OVERHEAD_US            50U    /**< Discharge and reconfiguration per conductor, generous */
+#define HOST_HANG_US                100000U /**< Polling this long inside one measurement is a hang */
+#define HOST_TRIALS                 2000U  /**< Random measurements per SysTick clock */
+#define HOST_NEVER                  0xFFFFFFFFFFFFFFFFULL /**< Charge time of a pin that never reads high */
+
+// Simulated registers
+GPIO_TypeDef host_gpioa;
+GPIO_TypeDef host_gpioc;
+GPIO_TypeDef host_gpiod;
+SysTick_Type host_systick;
+uint32_t SystemCoreClock = HOST_CORE_HZ;
+
+// Private variables
+static const BoardPin_t drive_pins[BOARD_CONDUCTOR_COUNT] = BOARD_DRIVE_PINS;
+static GPIO_TypeDef* const gpio_ports[BOARD_PORT_COUNT] = BOARD_GPIO_PORTS;
+static uint64_t cycles;                                  /**< Simulated HCLK cycles */
+static uint64_t measure_start;                           /**< Cycles when the measurement started */
+static uint64_t tick_phase;                              /**< SysTick count at cycle 0, in cycles */
+static uint64_t set_at[BOARD_PORT_COUNT][8];             /**< Cycle a pin was set high, HOST_NEVER if low */
+static uint64_t charge_cycles[BOARD_PORT_COUNT][8];      /**< Cycles a pin takes to read high */
+static uint32_t random_state = 1U;
+
+// Private function prototypes
+static uint8_t RunCharges(uint32_t divider, const uint64_t charge_ns[8], const char* name);
+static uint8_t PortIndex(const GPIO_TypeDef* port);
+static uint32_t Random(void);
+
+int main(void)
+{
+    static const uint32_t dividers[] = { 1U, 8U };
+    uint64_t charge_ns[8];
+    unsigned failures = 0U;
+
+    for (uint8_t d = 0U; d < 2U; d++)
+    {
+        uint32_t divider = dividers[d];
+        unsigned failed = 0U;
+
+        printf("SysTick at HCLK/%lu, 1 ms reload\n", (unsigned long)divider);
+
+        for (uint32_t t = 0U; t < HOST_TRIALS; t++)
+        {
+            for (uint8_t i = 0U; i < 8U; i++)
+            {
+                charge_ns[i] = 200U + (Random() % ((CABLERCHAL_MAX_TIME_US * 1000U) - 2000U));
+            }
+            failed += !RunCharges(divider, charge_ns, "random charge times");
+        }
+
+        for (uint8_t i = 0U; i < 8U; i++)
+        {
+            charge_ns[i] = 5000U * (i + 1U);
+        }
+        charge_ns[3] = HOST_NEVER;
+        failed += !RunCharges(divider, charge_ns, "conductor 3 shorted low");
+
+        charge_ns[3] = (CABLERCHAL_MAX_TIME_US * 1000U) + 100000U;
+        failed += !RunCharges(divider, charge_ns, "conductor 3 charges too late");
+
+        for (uint8_t i = 0U; i < 8U; i++)
+        {
+            charge_ns[i] = HOST_NEVER;
+        }
+        failed += !RunCharges(divider, charge_ns, "far end plugged in");
+
+        printf("  %lu measurements, %u failed\n", (unsigned long)(HOST_TRIALS + 3U), failed);
+        failures += failed;
+    }
+
+    printf("%s\n", (failures == 0U) ? "PASS" : "FAIL");
+    return (failures == 0U) ? 0 : 1;
+}
+
+// Simulated register access
+
+HostInputRegister::operator uint32_t() const
+{
+    const GPIO_TypeDef* port = (this == &host_gpioa.INDR) ? &host_gpioa :
+                               (this == &host_gpioc.INDR) ? &host_gpioc : &host_gpiod;
+    uint8_t p = PortIndex(port);
+    uint32_t levels = 0U;
+
+    cycles += HOST_INDR_READ_CYCLES;
+    for (uint8_t pin = 0U; pin < 8U; pin++)
+    {
+        if ((set_at[p][pin] != HOST_NEVER) && (charge_cycles[p][pin] != HOST_NEVER) &&
+            ((cycles - set_at[p][pin]) >= charge_cycles[p][pin]))
+        {
+            levels |= 1UL << pin;
+        }
+    }
+    return levels;
+}
+
+HostSetResetRegister& HostSetResetRegister::operator=(uint32_t value)
+{
+    const GPIO_TypeDef* port = (this == &host_gpioa.BSHR) ? &host_gpioa :
+                               (this == &host_gpioc.BSHR) ? &host_gpioc : &host_gpiod;
+    uint8_t p = PortIndex(port);
+
+    for (uint8_t pin = 0U; pin < 8U; pin++)
+    {
+        if (value & (1UL << (pin + 16U)))
+        {
+            set_at[p][pin] = HOST_NEVER;
+        }
+        if (value & (1UL << pin))
+        {
+            set_at[p][pin] = cycles;
+        }
+    }
+    return *this;
+}
+
+HostSysTickCount::operator uint32_t() const
+{
+    uint32_t divider = (host_systick.CTLR & (1UL << 2)) ? 1U : 8U;
+
+    cycles += HOST_CNT_READ_CYCLES;
+    if ((cycles - measure_start) > ((uint64_t)HOST_HANG_US * (HOST_CORE_HZ / 1000000UL)))
+    {
+        printf("  FAIL: still polling after %lu us, the timeout never fired\n", (unsigned long)HOST_HANG_US);
+        printf("FAIL\n");
+        exit(1);
+    }
+    return (uint32_t)(((cycles + tick_phase) / divider) % ((uint64_t)host_systick.CMP + 1U));
+}
+
+// Private function implementations
+
+/**
+ * @brief Measure one set of charge times and check the result
+ * @param divider SysTick clock divider, 1 or 8
+ * @param charge_ns Charge time per conductor, HOST_NEVER if it never reads high
+ * @return uint8_t 1 if every conductor was measured or timed out correctly
+ */
+static uint8_t RunCharges(uint32_t divider, const uint64_t charge_ns[8], const char* name)
+{
+    uint32_t time_ns[8];
+    uint8_t passed = 1U;
+    uint64_t limit_us = 0U;
+
+    host_systick.CTLR = (divider == 1U) ? (1UL << 2) : 0U;
+    host_systick.CMP = (HOST_CORE_HZ / divider / 1000U) - 1U;
+    tick_phase = Random() % ((uint64_t)(host_systick.CMP + 1U) * divider);
+
+    for (uint8_t p = 0U; p < BOARD_PORT_COUNT; p++)
+    {
+        for (uint8_t pin = 0U; pin < 8U; pin++)
+        {
+            set_at[p][pin] = HOST_NEVER;
+            charge_cycles[p][pin] = HOST_NEVER;
+        }
+    }
+    for (uint8_t i = 0U; i < BOARD_CONDUCTOR_COUNT; i++)
+    {
+        const BoardPin_t* pin = &drive_pins[i];
+
+        charge_cycles[pin->port][pin->pin] = (charge_ns[i] == HOST_NEVER) ? HOST_NEVER :
+                                             (charge_ns[i] * (HOST_CORE_HZ / 1000000UL)) / 1000U;
+    }
+
+    measure_start = cycles;
+    CableRcHal_Measure(time_ns);
+    uint64_t took_us = (cycles - measure_start) / (HOST_CORE_HZ / 1000000UL);
+
+    for (uint8_t i = 0U; i < BOARD_CONDUCTOR_COUNT; i++)
+    {
+        uint8_t late = (charge_ns[i] == HOST_NEVER) || (charge_ns[i] > CABLERCHAL_MAX_TIME_US * 1000U);
+
+        // A timeout costs CABLERCHAL_MAX_TIME_US, not more
+        limit_us += (late ? CABLERCHAL_MAX_TIME_US : (charge_ns[i] / 1000U)) + HOST_OVERHEAD_US;
+        if (late)
+        {
+            if (time_ns[i] != CABLERCHAL_TIMEOUT)
+            {
+                printf("  %s: conductor %u measured %lu ns, expected a timeout\n", name, i, (unsigned long)time_ns[i]);
+                passed = 0U;
+            }
+        }
+        else if ((time_ns[i] == CABLERCHAL_TIMEOUT) || (time_ns[i] + HOST_TOLERANCE_NS < charge_ns[i]) ||
+                 (time_ns[i] > charge_ns[i] + HOST_TOLERANCE_NS))
+        {
+            printf("  %s: conductor %u measured %lu ns for %llu ns\n", name, i, (unsigned long)time_ns[i],
+                   (unsigned long long)charge_ns[i]);
+            passed = 0U;
+        }
+    }
+
+    if (took_us > limit_us)
+    {
+        printf("  %s: took %llu us, limit %llu us\n", name, (unsigned long long)took_us, (unsigned long long)limit_us);
+        passed = 0U;
+    }
+    return passed;
+}
+
+static uint8_t PortIndex(const GPIO_TypeDef* port)
+{
+    for (uint8_t p = 0U; p < BOARD_PORT_COUNT; p++)
+    {
+        if (gpio_ports[p] == port)
+        {
+            return p;
+        }
+    }
+    return 0U;
+}
+
+static uint32_t Random(void)
+{
+    // xorshift32, reproducible
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
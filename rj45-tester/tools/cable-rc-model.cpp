@@ -0,0 +1,233 @@
+/**
+ * @file cable-rc-model.cpp
+ * @brief Host RC model of the cable length measurement
+ * @details Replaces CableRcHal with a simulated tester: a pull-up and input
+ *          threshold drawn from the CH32V003 tolerances, board and jack
+ *          capacitance, per-conductor cable capacitance and the SysTick
+ *          quantization of the polling loop. Each simulated unit is zeroed
+ *          and calibrated like on the bench, then CableRc_Analyze() is run
+ *          over lengths and open positions. Exits with 1 if an estimate is
+ *          out of tolerance, an open is missed or a measurement is too slow.
+ *
+ *          Build and run from the rj45-tester directory:
+ *          g++ -O2 -Wall -Ilib/CableRc tools/cable-rc-model.cpp lib/CableRc/CableRc.cpp -o cable-rc-model
+ *          ./cable-rc-model
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "CableRc.h"
+#include "CableRcHal.h"
+
+// Configuration constants
+#define MODEL_UNITS                 200U   /**< Simulated testers, each with its own tolerances */
+#define MODEL_CAL_CM                1000U  /**< Reference cable used for calibration */
+#define MODEL_CORE_HZ               48000000.0
+#define MODEL_TICK_HZ               6000000.0 /**< SysTick at HCLK/8 */
+#define MODEL_LOOP_CYCLES           12.0   /**< Cycles per pass of the polling loop */
+#define MODEL_OVERHEAD_NS           12000.0 /**< Discharge and reconfiguration per conductor */
+#define MODEL_PF_PER_M              104.0  /**< True Cat5e conductor-to-others capacitance */
+#define MODEL_PF_SPREAD             0.03   /**< Conductor to conductor capacitance spread */
+#define MODEL_TOLERANCE_PERCENT     5.0    /**< Allowed length error... */
+#define MODEL_TOLERANCE_CM          25.0   /**< ...or this much, whichever is larger */
+#define MODEL_TIME_LIMIT_NS         10000000.0 /**< Whole measurement must stay below 10 ms */
+
+// Type definitions
+/**
+ * @brief One simulated tester with a cable plugged into the near jack
+ */
+typedef struct
+{
+    double pullup_ohms;          /**< Internal pull-up of this unit */
+    double threshold;            /**< Input high threshold as share of VDD */
+    double board_pf[8];          /**< Pin, trace and jack capacitance */
+    double cable_pf_per_m[8];    /**< Capacitance per metre of each conductor */
+    double length_m[8];          /**< Conductor length up to the far end or the break */
+    double last_total_ns;        /**< Duration of the last CableRcHal_Measure() */
+} ModelUnit_t;
+
+// Private variables
+static ModelUnit_t unit;
+
+// Private function prototypes
+static double Uniform(double low, double high);
+static void NewUnit(void);
+static void PlugCable(double length_m);
+static void PlugOpenCable(double length_m, int open_conductor, double open_m);
+
+// Simulated hardware, same contract as CableRcHal.cpp
+
+void CableRcHal_Measure(uint32_t time_ns[8])
+{
+    const double loop_ns = MODEL_LOOP_CYCLES * 1e9 / MODEL_CORE_HZ;
+    const double tick_ns = 1e9 / MODEL_TICK_HZ;
+    const double ticks_per_us = MODEL_TICK_HZ / 1e6;
+    double ln_factor = -log(1.0 - unit.threshold);
+
+    unit.last_total_ns = 0.0;
+
+    for (int i = 0; i < 8; i++)
+    {
+        double c_farad = (unit.board_pf[i] + unit.cable_pf_per_m[i] * unit.length_m[i]) * 1e-12;
+        double charge_ns = unit.pullup_ohms * c_farad * ln_factor * 1e9;
+
+        // The loop sees the input at discrete passes, SysTick runs from a random phase
+        double seen_ns = ceil(charge_ns / loop_ns) * loop_ns;
+        double phase_ns = Uniform(0.0, tick_ns);
+        double ticks = floor((phase_ns + seen_ns) / tick_ns);
+
+        if (seen_ns > CABLERCHAL_MAX_TIME_US * 1000.0)
+        {
+            time_ns[i] = CABLERCHAL_TIMEOUT;
+            unit.last_total_ns += CABLERCHAL_MAX_TIME_US * 1000.0 + MODEL_OVERHEAD_NS;
+        }
+        else
+        {
+            time_ns[i] = (uint32_t)((ticks * 1000.0) / ticks_per_us);
+            unit.last_total_ns += seen_ns + MODEL_OVERHEAD_NS;
+        }
+    }
+}
+
+int main(void)
+{
+    static const double lengths_m[] = { 0.5, 1.0, 2.0, 5.0, 10.0, 20.0, 50.0, 100.0 };
+    const int length_count = (int)(sizeof(lengths_m) / sizeof(lengths_m[0]));
+    double worst_error[sizeof(lengths_m) / sizeof(lengths_m[0])] = { 0.0 };
+    double worst_open_error = 0.0;
+    double worst_time_ns = 0.0;
+    unsigned missed_opens = 0U;
+    unsigned false_opens = 0U;
+    unsigned failures = 0U;
+    uint32_t time_ns[8];
+
+    srand(1U);
+
+    for (unsigned u = 0U; u < MODEL_UNITS; u++)
+    {
+        NewUnit();
+
+        // Bench procedure: zero with an empty jack, then a known cable
+        PlugCable(0.0);
+        CableRcHal_Measure(time_ns);
+        CableRc_SetZero(time_ns);
+
+        PlugCable(MODEL_CAL_CM / 100.0);
+        CableRcHal_Measure(time_ns);
+        if (!CableRc_Calibrate(CABLERC_CAT5E, MODEL_CAL_CM, time_ns))
+        {
+            printf("unit %u: calibration failed\n", u);
+            failures++;
+            continue;
+        }
+
+        for (int l = 0; l < length_count; l++)
+        {
+            CableRcResult_t result;
+            double length_m = lengths_m[l];
+
+            // Intact cable
+            PlugCable(length_m);
+            CableRc_Measure(CABLERC_CAT5E, &result);
+
+            double error_cm = fabs(result.cable_length_cm - length_m * 100.0);
+            double allowed_cm = fmax(length_m * MODEL_TOLERANCE_PERCENT, MODEL_TOLERANCE_CM);
+            if (error_cm > worst_error[l])
+            {
+                worst_error[l] = error_cm;
+            }
+            if (error_cm > allowed_cm)
+            {
+                failures++;
+            }
+            if (result.open_mask != 0U)
+            {
+                false_opens++;
+            }
+            if (unit.last_total_ns > worst_time_ns)
+            {
+                worst_time_ns = unit.last_total_ns;
+            }
+
+            // One conductor broken at a random position, far enough from the end to be told apart
+            int conductor = rand() % 8;
+            double open_m = Uniform(0.0, length_m * 0.8);
+            if ((length_m - open_m) < 1.0)
+            {
+                continue;
+            }
+            PlugOpenCable(length_m, conductor, open_m);
+            CableRc_Measure(CABLERC_CAT5E, &result);
+            if (!(result.open_mask & (1U << conductor)))
+            {
+                missed_opens++;
+                continue;
+            }
+            double open_error_cm = fabs(result.length_cm[conductor] - open_m * 100.0);
+            if (open_error_cm > worst_open_error)
+            {
+                worst_open_error = open_error_cm;
+            }
+            if (open_error_cm > fmax(open_m * MODEL_TOLERANCE_PERCENT, MODEL_TOLERANCE_CM))
+            {
+                failures++;
+            }
+        }
+    }
+
+    printf("%u units, calibrated with %.1f m, Cat5e %.0f pF/m +-%.0f%%\n",
+           MODEL_UNITS, MODEL_CAL_CM / 100.0, MODEL_PF_PER_M, MODEL_PF_SPREAD * 100.0);
+    printf("length    worst error\n");
+    for (int l = 0; l < length_count; l++)
+    {
+        printf("%6.1f m  %6.1f cm (%.1f%%)\n", lengths_m[l], worst_error[l],
+               worst_error[l] / lengths_m[l]);
+    }
+    printf("open position worst error %.1f cm, missed %u, false %u\n",
+           worst_open_error, missed_opens, false_opens);
+    printf("slowest measurement %.2f ms\n", worst_time_ns / 1e6);
+
+    if (worst_time_ns > MODEL_TIME_LIMIT_NS)
+    {
+        failures++;
+    }
+    failures += missed_opens + false_opens;
+    printf("%s\n", (failures == 0U) ? "PASS" : "FAIL");
+    return (failures == 0U) ? 0 : 1;
+}
+
+// Private function implementations
+
+static double Uniform(double low, double high)
+{
+    return low + (high - low) * ((double)rand() / (double)RAND_MAX);
+}
+
+static void NewUnit(void)
+{
+    // CH32V003 pull-up is specified 35 kOhm typical, input high threshold 0.6-0.8 VDD
+    unit.pullup_ohms = Uniform(25000.0, 50000.0);
+    unit.threshold = Uniform(0.6, 0.8);
+
+    for (int i = 0; i < 8; i++)
+    {
+        unit.board_pf[i] = Uniform(15.0, 35.0);
+        unit.cable_pf_per_m[i] = MODEL_PF_PER_M * Uniform(1.0 - MODEL_PF_SPREAD, 1.0 + MODEL_PF_SPREAD);
+    }
+}
+
+static void PlugCable(double length_m)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        unit.length_m[i] = length_m;
+    }
+}
+
+static void PlugOpenCable(double length_m, int open_conductor, double open_m)
+{
+    PlugCable(length_m);
+    unit.length_m[open_conductor] = open_m;
+}
@@ -0,0 +1,371 @@
+/**
+ * @file cable-sim.cpp
+ * @brief Host cable fault simulator for the scan, classifier and fault hunting logic
+ * @details Replaces WireMapHal with a simulated cable: crossed and open
+ *          conductors, shorts at the near end and timed intermittent faults,
+ *          on a simulated clock advanced by every probe. The firmware's
+ *          WireMap, WireClass and FaultHunt sources run unchanged on top.
+ *
+ *          1. Classifies a set of static cables and checks the verdicts
+ *          2. Measures the probability that fault hunting catches a single
+ *             dropout or short, against its duration and the scan period
+ *          3. Measures host scan throughput
+ *
+ *          Exits with 1 if a static cable gets the wrong verdict.
+ *
+ *          Build and run from the rj45-tester directory:
+ *          g++ -O2 -Wall -Ilib/WireMap -Ilib/WireClass -Ilib/FaultHunt tools/cable-sim.cpp \
+ *              lib/WireMap/WireMap.cpp lib/WireClass/WireClass.cpp lib/FaultHunt/FaultHunt.cpp -o cable-sim
+ *          ./cable-sim [trials per cell]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "FaultHunt.h"
+#include "WireClass.h"
+#include "WireMap.h"
+#include "WireMapHal.h"
+
+// Configuration constants
+#define SIM_PROBE_NS                3000ULL  /**< One probe on the tester: drive, settle, read, discharge */
+#define SIM_SETTLE_NS               2000ULL  /**< Far end is read this long after the drive edge */
+#define SIM_DEFAULT_TRIALS          20000U
+#define SIM_THROUGHPUT_SCANS        5000000UL
+#define SIM_NO_BRIDGE               0xFFU
+
+// Type definitions
+/**
+ * @brief Simulated cable
+ * @details Driving near conductor I also drives every conductor in bridge[I]
+ *          (a short at the near end); each driven conductor reaches the far
+ *          pins in link[].
+ */
+typedef struct
+{
+    uint8_t link[WIREMAP_CONDUCTOR_COUNT];   /**< Far pins reached by each near conductor, 0 = open */
+    uint8_t bridge[WIREMAP_CONDUCTOR_COUNT]; /**< Near conductors shorted to each conductor */
+} SimCable_t;
+
+/**
+ * @brief Intermittent fault, active in [start_ns, end_ns)
+ */
+typedef struct
+{
+    uint8_t conductor;           /**< Affected near conductor */
+    uint8_t bridge_to;           /**< Conductor it shorts to, SIM_NO_BRIDGE for a dropout */
+    uint64_t start_ns;
+    uint64_t end_ns;
+} SimGlitch_t;
+
+// Private variables
+static SimCable_t cable;
+static SimGlitch_t glitch;
+static uint64_t now_ns;
+static uint32_t random_state = 1U;
+
+// Private function prototypes
+static uint32_t Random(void);
+static void MakeStraight(SimCable_t* sim);
+static void Swap(SimCable_t* sim, uint8_t a, uint8_t b);
+static unsigned CheckStaticCables(void);
+static double DetectionProbability(uint64_t period_ns, uint64_t duration_ns, uint8_t bridge_to, unsigned trials);
+static void MeasureThroughput(void);
+
+// Simulated GPIO layer, same contract as WireMapHal.cpp
+
+void WireMapHal_Init(void)
+{
+}
+
+void WireMapHal_BeginScan(void)
+{
+}
+
+uint8_t WireMapHal_Probe(uint8_t conductor)
+{
+    uint64_t sample_ns = now_ns + SIM_SETTLE_NS;
+    uint8_t active = (sample_ns >= glitch.start_ns) && (sample_ns < glitch.end_ns);
+    uint8_t driven = (uint8_t)((1U << conductor) | cable.bridge[conductor]);
+    uint8_t far = 0U;
+
+    now_ns += SIM_PROBE_NS;
+
+    if (active && (glitch.bridge_to != SIM_NO_BRIDGE))
+    {
+        if (conductor == glitch.conductor)
+        {
+            driven |= (uint8_t)(1U << glitch.bridge_to);
+        }
+        else if (conductor == glitch.bridge_to)
+        {
+            driven |= (uint8_t)(1U << glitch.conductor);
+        }
+    }
+
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        if (!(driven & (1U << i)))
+        {
+            continue;
+        }
+        if (active && (glitch.bridge_to == SIM_NO_BRIDGE) && (i == glitch.conductor))
+        {
+            continue;
+        }
+        far |= cable.link[i];
+    }
+
+    return far;
+}
+
+void WireMapHal_EndScan(void)
+{
+}
+
+int main(int argc, char** argv)
+{
+    // Back to back in fault hunting mode, batch test mode, wiremap mode
+    static const uint64_t periods_ns[] = { 30000ULL, 2000000ULL, 10000000ULL };
+    static const uint64_t durations_ns[] = {
+        1000ULL, 5000ULL, 20000ULL, 50000ULL, 200000ULL, 1000000ULL, 5000000ULL, 20000000ULL
+    };
+    const unsigned period_count = sizeof(periods_ns) / sizeof(periods_ns[0]);
+    const unsigned duration_count = sizeof(durations_ns) / sizeof(durations_ns[0]);
+    unsigned trials = (argc > 1) ? (unsigned)strtoul(argv[1], NULL, 10) : SIM_DEFAULT_TRIALS;
+
+    if (trials == 0U)
+    {
+        fprintf(stderr, "usage: %s [trials per cell]\n", argv[0]);
+        return 2;
+    }
+
+    unsigned failures = CheckStaticCables();
+
+    for (int kind = 0; kind < 2; kind++)
+    {
+        uint8_t bridge_to = (kind == 0) ? SIM_NO_BRIDGE : 4U;
+
+        printf("\nDetection probability of one %s on pin 4, %u trials per cell\n",
+               (kind == 0) ? "dropout" : "short to pin 5", trials);
+        printf("glitch    ");
+        for (unsigned p = 0U; p < period_count; p++)
+        {
+            printf("  every %6.3f ms", periods_ns[p] / 1e6);
+        }
+        printf("\n");
+
+        for (unsigned d = 0U; d < duration_count; d++)
+        {
+            printf("%7.3f ms", durations_ns[d] / 1e6);
+            for (unsigned p = 0U; p < period_count; p++)
+            {
+                printf("  %15.4f", DetectionProbability(periods_ns[p], durations_ns[d], bridge_to, trials));
+            }
+            printf("\n");
+        }
+    }
+
+    MeasureThroughput();
+
+    printf("\n%s\n", (failures == 0U) ? "PASS" : "FAIL");
+    return (failures == 0U) ? 0 : 1;
+}
+
+// Private function implementations
+
+static uint32_t Random(void)
+{
+    // xorshift32, fast and reproducible
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+static void MakeStraight(SimCable_t* sim)
+{
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        sim->link[i] = (uint8_t)(1U << i);
+        sim->bridge[i] = 0U;
+    }
+}
+
+static void Swap(SimCable_t* sim, uint8_t a, uint8_t b)
+{
+    uint8_t link = sim->link[a];
+
+    sim->link[a] = sim->link[b];
+    sim->link[b] = link;
+}
+
+static unsigned CheckStaticCables(void)
+{
+    typedef struct
+    {
+        const char* name;
+        WireClass_t expected;
+    } Case_t;
+    static const Case_t cases[] = {
+        { "straight", WIRECLASS_STRAIGHT },
+        { "crossover 1-3 2-6", WIRECLASS_CROSSOVER },
+        { "gigabit crossover", WIRECLASS_CROSSOVER_GIGABIT },
+        { "rollover", WIRECLASS_ROLLOVER },
+        { "pair 3-6 reversed", WIRECLASS_REVERSED_PAIR },
+        { "pins 1 and 4 swapped", WIRECLASS_MISWIRED },
+        { "pin 5 open", WIRECLASS_OPEN },
+        { "pins 4-5 shorted", WIRECLASS_SHORT },
+        { "not plugged", WIRECLASS_NO_CABLE }
+    };
+    unsigned failures = 0U;
+
+    glitch.end_ns = 0U;
+    printf("Static cables\n");
+
+    for (unsigned c = 0U; c < sizeof(cases) / sizeof(cases[0]); c++)
+    {
+        WireMap_t map;
+        WireMapReport_t report;
+        uint8_t reversed_pairs;
+
+        MakeStraight(&cable);
+        switch (c)
+        {
+            case 1:
+                Swap(&cable, 0U, 2U);
+                Swap(&cable, 1U, 5U);
+                break;
+            case 2:
+                Swap(&cable, 0U, 2U);
+                Swap(&cable, 1U, 5U);
+                Swap(&cable, 3U, 6U);
+                Swap(&cable, 4U, 7U);
+                break;
+            case 3:
+                for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+                {
+                    cable.link[i] = (uint8_t)(0x80U >> i);
+                }
+                break;
+            case 4:
+                Swap(&cable, 2U, 5U);
+                break;
+            case 5:
+                Swap(&cable, 0U, 3U);
+                break;
+            case 6:
+                cable.link[4] = 0U;
+                break;
+            case 7:
+                cable.bridge[3] = (uint8_t)(1U << 4);
+                cable.bridge[4] = (uint8_t)(1U << 3);
+                break;
+            case 8:
+                for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+                {
+                    cable.link[i] = 0U;
+                }
+                break;
+            default:
+                break;
+        }
+
+        WireMap_Scan(&map);
+        WireMap_Analyze(&map, &report);
+        WireClass_t verdict = WireClass_Classify(&report, &reversed_pairs);
+
+        printf("  %-22s %-18s %s\n", cases[c].name, WireClass_GetName(verdict),
+               (verdict == cases[c].expected) ? "ok" : "WRONG");
+        if (verdict != cases[c].expected)
+        {
+            failures++;
+        }
+    }
+
+    return failures;
+}
+
+static double DetectionProbability(uint64_t period_ns, uint64_t duration_ns, uint8_t bridge_to, unsigned trials)
+{
+    const uint8_t conductor = 3U;
+    unsigned detected = 0U;
+    WireMap_t good;
+    WireMap_t map;
+    FaultHunt_t hunt;
+
+    MakeStraight(&cable);
+    glitch.end_ns = 0U;
+    now_ns = 0U;
+    WireMap_Scan(&good);
+
+    glitch.conductor = conductor;
+    glitch.bridge_to = bridge_to;
+
+    for (unsigned t = 0U; t < trials; t++)
+    {
+        // Glitch starts at a random point of the scan schedule
+        uint64_t first_scan = 4U;
+        glitch.start_ns = (first_scan + 1U) * period_ns + (Random() % period_ns);
+        glitch.end_ns = glitch.start_ns + duration_ns;
+
+        FaultHunt_Reset(&hunt, &good);
+        for (uint64_t k = first_scan; (k * period_ns) < (glitch.end_ns + period_ns); k++)
+        {
+            now_ns = k * period_ns;
+            WireMap_Scan(&map);
+            FaultHunt_Update(&hunt, &map);
+        }
+
+        if (hunt.latched_mask & (1U << conductor))
+        {
+            detected++;
+        }
+    }
+
+    return (double)detected / trials;
+}
+
+static void MeasureThroughput(void)
+{
+    WireMap_t good;
+    WireMap_t map;
+    WireMapReport_t report;
+    FaultHunt_t hunt;
+    uint8_t reversed_pairs;
+    unsigned long verdicts = 0UL;
+    struct timespec start;
+    struct timespec end;
+
+    MakeStraight(&cable);
+    glitch.conductor = 6U;
+    glitch.bridge_to = SIM_NO_BRIDGE;
+    glitch.start_ns = 0U;
+    glitch.end_ns = 0U;
+    now_ns = 0U;
+    WireMap_Scan(&good);
+    FaultHunt_Reset(&hunt, &good);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned long s = 0UL; s < SIM_THROUGHPUT_SCANS; s++)
+    {
+        // A dropout over one whole scan every 1000 scans keeps the glitch path busy
+        if ((s % 1000UL) == 0UL)
+        {
+            glitch.start_ns = now_ns;
+            glitch.end_ns = now_ns + (WIREMAP_CONDUCTOR_COUNT * SIM_PROBE_NS);
+        }
+        WireMap_Scan(&map);
+        FaultHunt_Update(&hunt, &map);
+        WireMap_Analyze(&map, &report);
+        verdicts += (WireClass_Classify(&report, &reversed_pairs) == WIRECLASS_OPEN) ? 1UL : 0UL;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    printf("\nThroughput: %lu scans with analysis and classification in %.2f s, %.1f M scans/s\n",
+           SIM_THROUGHPUT_SCANS, seconds, SIM_THROUGHPUT_SCANS / seconds / 1e6);
+    printf("            %u glitches counted, %lu open verdicts\n",
+           hunt.glitch_count[6], verdicts);
+}
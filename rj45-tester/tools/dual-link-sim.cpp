@@ -0,0 +1,335 @@
+/**
+ * @file dual-link-sim.cpp
+ * @brief Host simulator of two testers linked over the brown pair
+ * @details Runs a main and a remote DualLink instance against each other on
+ *          a simulated clock. Each unit ticks on its own crystal, off by up
+ *          to +-DUALSIM_SKEW from nominal, and reads the data line at its
+ *          tick. The line is resolved like the hardware: released at both
+ *          ends reads low, a high output against a low output is counted as
+ *          contention. The remote pauses between its serve slices and the
+ *          main after driving each conductor, like the firmware runs its
+ *          other tasks, and an optional glitch rate flips single samples.
+ *
+ *          1. Collects remote wiremaps over cables with a working link and
+ *             checks them against the cable
+ *          2. Checks that cables that break the link pair fail cleanly
+ *          3. Repeats 1 with glitches, no corrupted frame may be accepted
+ *
+ *          Exits with 1 on a wrong map, contention, a broken link that is not
+ *          reported, or on a clean line a missing map or a scan slower than
+ *          DUALSIM_TIME_LIMIT_NS.
+ *
+ *          Build and run from the rj45-tester directory:
+ *          g++ -O2 -Wall -Ilib/DualLink -Ilib/WireMap tools/dual-link-sim.cpp lib/DualLink/DualLink.cpp -o dual-link-sim
+ *          ./dual-link-sim [scans per cable]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "DualLink.h"
+#include "WireMap.h"
+
+// Configuration constants
+#define DUALSIM_TICK_NS             (DUALLINK_TICK_US * 1000.0)
+#define DUALSIM_SKEW                0.015  /**< Largest tick rate error of either unit, trimmed HSI over temperature */
+#define DUALSIM_JITTER_NS           400.0  /**< Tick start jitter from interrupts, uniform 0..this */
+#define DUALSIM_SERVE_NS            5e6    /**< Remote answers this long, DUAL_SERVE_MS in main.cpp... */
+#define DUALSIM_PAUSE_NS            0.5e6  /**< ...then runs its other tasks this long */
+#define DUALSIM_MAIN_PAUSE_NS       1e6    /**< Main runs its other tasks up to this long per conductor */
+#define DUALSIM_GLITCH_RATE         0.0005 /**< Sample flip probability in the glitch run */
+#define DUALSIM_TIME_LIMIT_NS       20e6   /**< Remote wiremap must take less without glitches */
+#define DUALSIM_DEFAULT_SCANS       500U
+
+// Type definitions
+/**
+ * @brief Simulated cable between the main and the remote near jacks
+ */
+typedef struct
+{
+    const char* name;
+    uint8_t rows[8];             /**< Bit N: main conductor row reaches remote conductor N */
+    uint8_t link_ok;             /**< Brown pair straight, the link must work */
+} SimCable_t;
+
+/**
+ * @brief One tester on the simulated clock
+ */
+typedef struct
+{
+    DualLink_t link;
+    double tick_ns;              /**< Own tick period */
+    double next_ns;              /**< Time of the next tick */
+    uint8_t out;                 /**< Data line output, DUALLINK_LINE_* */
+    uint8_t driven;              /**< Main: conductor driven high */
+} SimUnit_t;
+
+/**
+ * @brief Totals of one run over a cable
+ */
+typedef struct
+{
+    unsigned done;
+    unsigned failed;
+    unsigned wrong;
+    unsigned retries;
+    unsigned contention;
+    double worst_ns;
+    double total_ns;
+} SimStats_t;
+
+// Private variables
+static const SimCable_t cables[] = {
+    { "straight",          { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 }, 1U },
+    { "crossover 100M",    { 0x04, 0x20, 0x01, 0x08, 0x10, 0x02, 0x40, 0x80 }, 1U },
+    { "open pin 4",        { 0x01, 0x02, 0x04, 0x00, 0x10, 0x20, 0x40, 0x80 }, 1U },
+    { "short 5-6",         { 0x01, 0x02, 0x04, 0x08, 0x30, 0x30, 0x40, 0x80 }, 1U },
+    { "reversed 1-2",      { 0x02, 0x01, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 }, 1U },
+    { "no cable",          { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, 0U },
+    { "open pin 7",        { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x00, 0x80 }, 0U },
+    { "crossover gigabit", { 0x04, 0x20, 0x01, 0x40, 0x80, 0x02, 0x08, 0x10 }, 0U },
+};
+
+static double glitch_rate;
+static double remote_pause_ns;   /**< Remote phase in its serve and pause cycle */
+
+// Private function prototypes
+static double Uniform(double low, double high);
+static SimStats_t RunCable(const SimCable_t* cable, unsigned scans);
+static uint8_t ScanOnce(const SimCable_t* cable, SimUnit_t* main_unit, SimUnit_t* remote, double* now_ns,
+                        unsigned* contention);
+static uint8_t LineLevel(uint8_t a, uint8_t b, unsigned* contention);
+static uint8_t RemoteLevels(const SimCable_t* cable, uint8_t driven, uint8_t main_data);
+static int RemoteServing(double now_ns, const DualLink_t* link);
+static void ExpectedMap(const SimCable_t* cable, WireMap_t* map);
+
+int main(int argc, char** argv)
+{
+    unsigned scans = (argc > 1) ? (unsigned)atoi(argv[1]) : DUALSIM_DEFAULT_SCANS;
+    const int cable_count = (int)(sizeof(cables) / sizeof(cables[0]));
+    unsigned failures = 0U;
+
+    srand(1U);
+    printf("%u scans per cable, skew +-%.1f%%, remote serves %.0f ms then pauses %.1f ms, "
+           "main pauses up to %.0f ms per conductor\n", scans, DUALSIM_SKEW * 100.0, DUALSIM_SERVE_NS / 1e6,
+           DUALSIM_PAUSE_NS / 1e6, DUALSIM_MAIN_PAUSE_NS / 1e6);
+
+    for (int run = 0; run < 2; run++)
+    {
+        glitch_rate = (run == 0) ? 0.0 : DUALSIM_GLITCH_RATE;
+        printf("\n%s\n", (run == 0) ? "clean line" : "glitches on the line");
+        printf("cable              done failed wrong retries contention  avg ms  worst ms\n");
+
+        for (int c = 0; c < cable_count; c++)
+        {
+            const SimCable_t* cable = &cables[c];
+
+            // The broken link cables only fail, nothing to learn from glitches
+            if (run == 1 && !cable->link_ok)
+            {
+                continue;
+            }
+
+            SimStats_t stats = RunCable(cable, scans);
+            unsigned runs = stats.done + stats.failed;
+            printf("%-18s %5u %6u %5u %7u %10u %7.2f %9.2f\n", cable->name, stats.done, stats.failed,
+                   stats.wrong, stats.retries, stats.contention,
+                   (runs > 0U) ? stats.total_ns / runs / 1e6 : 0.0, stats.worst_ns / 1e6);
+
+            failures += stats.wrong + stats.contention;
+            // With glitches a scan may give up, the next one starts over
+            if (cable->link_ok && run == 0)
+            {
+                failures += stats.failed;
+                if (stats.worst_ns > DUALSIM_TIME_LIMIT_NS)
+                {
+                    failures++;
+                }
+            }
+            else if (!cable->link_ok)
+            {
+                failures += stats.done;
+            }
+        }
+    }
+
+    printf("%s\n", (failures == 0U) ? "PASS" : "FAIL");
+    return (failures == 0U) ? 0 : 1;
+}
+
+// Private function implementations
+
+static double Uniform(double low, double high)
+{
+    return low + (high - low) * ((double)rand() / (double)RAND_MAX);
+}
+
+static SimStats_t RunCable(const SimCable_t* cable, unsigned scans)
+{
+    SimStats_t stats = { 0U, 0U, 0U, 0U, 0U, 0.0, 0.0 };
+    SimUnit_t main_unit;
+    SimUnit_t remote;
+    WireMap_t expected;
+    double now_ns = 0.0;
+
+    ExpectedMap(cable, &expected);
+
+    for (unsigned s = 0U; s < scans; s++)
+    {
+        // New pair of units now and then: other crystals, other phase
+        if ((s % 50U) == 0U)
+        {
+            DualLink_Init(&main_unit.link, DUALLINK_MAIN);
+            DualLink_Init(&remote.link, DUALLINK_REMOTE);
+            main_unit.tick_ns = DUALSIM_TICK_NS * (1.0 + Uniform(-DUALSIM_SKEW, DUALSIM_SKEW));
+            remote.tick_ns = DUALSIM_TICK_NS * (1.0 + Uniform(-DUALSIM_SKEW, DUALSIM_SKEW));
+            main_unit.next_ns = now_ns + Uniform(0.0, main_unit.tick_ns);
+            remote.next_ns = now_ns + Uniform(0.0, remote.tick_ns);
+            main_unit.out = DUALLINK_LINE_RELEASE;
+            remote.out = DUALLINK_LINE_RELEASE;
+            main_unit.driven = DUALLINK_NO_CONDUCTOR;
+            remote.driven = DUALLINK_NO_CONDUCTOR;
+            remote_pause_ns = Uniform(0.0, DUALSIM_SERVE_NS + DUALSIM_PAUSE_NS);
+        }
+
+        // Main scans every 10 ms or right after the previous scan, whichever is later
+        now_ns += Uniform(0.0, 10e6);
+        double start_ns = now_ns;
+        uint8_t done = ScanOnce(cable, &main_unit, &remote, &now_ns, &stats.contention);
+        double took_ns = now_ns - start_ns;
+
+        stats.total_ns += took_ns;
+        if (took_ns > stats.worst_ns)
+        {
+            stats.worst_ns = took_ns;
+        }
+        stats.retries += main_unit.link.retries;
+        if (!done)
+        {
+            stats.failed++;
+            continue;
+        }
+        stats.done++;
+        for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+        {
+            if (main_unit.link.map.rows[i] != expected.rows[i])
+            {
+                stats.wrong++;
+                break;
+            }
+        }
+    }
+    return stats;
+}
+
+static uint8_t ScanOnce(const SimCable_t* cable, SimUnit_t* main_unit, SimUnit_t* remote, double* now_ns,
+                        unsigned* contention)
+{
+    // Catch up both clocks to the scan start, the remote keeps listening in between
+    if (main_unit->next_ns < *now_ns)
+    {
+        main_unit->next_ns += main_unit->tick_ns * (double)(long)((*now_ns - main_unit->next_ns) / main_unit->tick_ns + 1.0);
+    }
+
+    DualLink_StartScan(&main_unit->link);
+
+    for (;;)
+    {
+        // Whichever unit ticks first
+        int main_first = main_unit->next_ns <= remote->next_ns;
+        SimUnit_t* unit = main_first ? main_unit : remote;
+        *now_ns = unit->next_ns;
+        unit->next_ns += unit->tick_ns + Uniform(0.0, DUALSIM_JITTER_NS) - DUALSIM_JITTER_NS / 2.0;
+
+        // Between serve slices the remote has released the line
+        if (!main_first && !RemoteServing(*now_ns, &remote->link))
+        {
+            remote->out = DUALLINK_LINE_RELEASE;
+            continue;
+        }
+
+        // The data line only connects the units when the brown pair is straight
+        uint8_t link_ok = (cable->rows[DUALLINK_DATA_CONDUCTOR] & (1U << DUALLINK_DATA_CONDUCTOR)) &&
+                          (cable->rows[DUALLINK_GROUND_CONDUCTOR] & (1U << DUALLINK_GROUND_CONDUCTOR));
+        uint8_t level;
+        if (link_ok)
+        {
+            level = LineLevel(main_unit->out, remote->out, contention);
+        }
+        else
+        {
+            level = (unit->out == DUALLINK_LINE_HIGH) ? 1U : 0U;
+        }
+        if (glitch_rate > 0.0 && Uniform(0.0, 1.0) < glitch_rate)
+        {
+            level ^= 1U;
+        }
+
+        DualLinkEvent_t event = DualLink_Tick(&unit->link, level, &unit->out);
+
+        if (event == DUALLINK_EVENT_DRIVE)
+        {
+            // A loop pass ends here, the request goes out when the main ticks again
+            main_unit->driven = main_unit->link.conductor;
+            main_unit->next_ns += Uniform(0.0, DUALSIM_MAIN_PAUSE_NS);
+        }
+        else if (event == DUALLINK_EVENT_SAMPLE)
+        {
+            uint8_t main_data = (main_unit->out == DUALLINK_LINE_HIGH) ? 1U : 0U;
+            DualLink_Reply(&remote->link, RemoteLevels(cable, main_unit->driven, main_data) &
+                                          (uint8_t)~DUALLINK_LINK_MASK);
+        }
+        else if (event == DUALLINK_EVENT_DONE || event == DUALLINK_EVENT_FAILED)
+        {
+            main_unit->driven = DUALLINK_NO_CONDUCTOR;
+            main_unit->out = DUALLINK_LINE_RELEASE;
+            return (event == DUALLINK_EVENT_DONE) ? 1U : 0U;
+        }
+    }
+}
+
+static uint8_t LineLevel(uint8_t a, uint8_t b, unsigned* contention)
+{
+    if ((a == DUALLINK_LINE_HIGH && b == DUALLINK_LINE_LOW) || (a == DUALLINK_LINE_LOW && b == DUALLINK_LINE_HIGH))
+    {
+        (*contention)++;
+        return 0U;
+    }
+    return (a == DUALLINK_LINE_HIGH || b == DUALLINK_LINE_HIGH) ? 1U : 0U;
+}
+
+static uint8_t RemoteLevels(const SimCable_t* cable, uint8_t driven, uint8_t main_data)
+{
+    uint8_t levels = 0U;
+
+    if (driven != DUALLINK_NO_CONDUCTOR)
+    {
+        levels |= cable->rows[driven];
+    }
+    if (main_data)
+    {
+        levels |= cable->rows[DUALLINK_DATA_CONDUCTOR];
+    }
+    return levels;
+}
+
+static int RemoteServing(double now_ns, const DualLink_t* link)
+{
+    double phase = now_ns + remote_pause_ns;
+    double cycle = DUALSIM_SERVE_NS + DUALSIM_PAUSE_NS;
+
+    phase -= cycle * (double)(long)(phase / cycle);
+
+    // serveRemote() never stops inside a frame
+    return (phase < DUALSIM_SERVE_NS) || !DualLink_IsIdle(link);
+}
+
+static void ExpectedMap(const SimCable_t* cable, WireMap_t* map)
+{
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        map->rows[i] = cable->rows[i] & (uint8_t)~DUALLINK_LINK_MASK;
+    }
+    map->rows[DUALLINK_DATA_CONDUCTOR] = 1U << DUALLINK_DATA_CONDUCTOR;
+    map->rows[DUALLINK_GROUND_CONDUCTOR] = 1U << DUALLINK_GROUND_CONDUCTOR;
+}
@@ -0,0 +1,84 @@
+#ifndef CH32V00X_H
+#define CH32V00X_H
+
+/**
+ * @file ch32v00x.h
+ * @brief Host stand-in of the WCH device header for the HAL tests in tools/
+ * @details Only the GPIO ports and SysTick are modelled. Reading SysTick CNT
+ *          advances a simulated HCLK cycle counter, so a polling loop sees
+ *          time pass and the counter wrap at CMP. The input register reports
+ *          a pin high once it has been set through BSHR for its charge time.
+ *          The test provides the register instances and the hooks below.
+ */
+
+#include <stdint.h>
+
+#define __IO volatile
+
+/**
+ * @brief GPIO input data register, reads the simulated pin levels
+ */
+class HostInputRegister
+{
+public:
+    operator uint32_t() const;
+};
+
+/**
+ * @brief GPIO set/reset register, records when each pin was set
+ */
+class HostSetResetRegister
+{
+public:
+    HostSetResetRegister& operator=(uint32_t value);
+};
+
+/**
+ * @brief SysTick counter, every read advances the simulated clock
+ */
+class HostSysTickCount
+{
+public:
+    operator uint32_t() const;
+};
+
+typedef struct
+{
+    uint32_t CFGLR;
+    uint32_t RESERVED0;
+    HostInputRegister INDR;
+    uint32_t OUTDR;
+    HostSetResetRegister BSHR;
+    uint32_t BCR;
+    uint32_t LCKR;
+} GPIO_TypeDef;
+
+typedef struct
+{
+    uint32_t CTLR;
+    uint32_t SR;
+    HostSysTickCount CNT;
+    uint32_t RESERVED0;
+    uint32_t CMP;
+} SysTick_Type;
+
+extern GPIO_TypeDef host_gpioa;
+extern GPIO_TypeDef host_gpioc;
+extern GPIO_TypeDef host_gpiod;
+extern SysTick_Type host_systick;
+extern uint32_t SystemCoreClock;
+
+#define GPIOA                       (&host_gpioa)
+#define GPIOC                       (&host_gpioc)
+#define GPIOD                       (&host_gpiod)
+#define SysTick                     (&host_systick)
+
+inline void __disable_irq(void)
+{
+}
+
+inline void __enable_irq(void)
+{
+}
+
+#endif /* CH32V00X_H */
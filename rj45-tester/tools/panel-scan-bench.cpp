@@ -0,0 +1,231 @@
+/**
+ * @file panel-scan-bench.cpp
+ * @brief Host benchmark and check of the patch panel scan
+ * @details Replaces PanelScanHal with a model of the 74HC595/74HC165 chains
+ *          and a wired patch panel. PanelScan.cpp is compiled once per port
+ *          count, each copy in its own namespace. For every port count the
+ *          scan is checked against a good panel and injected faults, and the
+ *          scan time is estimated from the bytes and exchanges it needs,
+ *          next to scanning one port at a time. Exits with 1 if a fault is
+ *          missed or a good port fails.
+ *
+ *          Build and run from the rj45-tester directory:
+ *          g++ -O2 -Wall -Ilib/PanelScan -Ilib/WireMap tools/panel-scan-bench.cpp -o panel-scan-bench
+ *          ./panel-scan-bench
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "PanelScanHal.h"
+#include "WireMap.h"
+
+// Configuration constants
+#define BENCH_MAX_PORTS             96U
+#define BENCH_NOT_CONNECTED         0xFFFFU
+#define BENCH_SPI_HZ                12000000.0 /**< HCLK / 4 */
+#define BENCH_CORE_HZ               48000000.0
+#define BENCH_EXCHANGE_US           3.0    /**< DMA setup, completion poll, latch, settle and load */
+#define BENCH_CYCLES_PER_PORT       12.0   /**< Filling and storing one port byte per exchange */
+
+// Private variables
+static unsigned model_ports;
+static uint16_t far_of[BENCH_MAX_PORTS * 8U];   /**< Far conductor (port * 8 + pin) of each near conductor */
+static uint8_t latched[BENCH_MAX_PORTS];        /**< 74HC595 outputs */
+static uint8_t captured[BENCH_MAX_PORTS];       /**< 74HC165 parallel register */
+static unsigned long exchange_count;
+static unsigned long byte_count;
+
+// Simulated register chains, same contract as PanelScanHal.cpp
+
+void PanelScanHal_Init(void)
+{
+    memset(latched, 0, sizeof(latched));
+    memset(captured, 0, sizeof(captured));
+}
+
+void PanelScanHal_Exchange(const uint8_t* drive, uint8_t* sense, uint16_t length)
+{
+    exchange_count++;
+    byte_count += length;
+
+    // The 165s shift out the previous capture while the 595s shift in the new pattern
+    memcpy(sense, captured, length);
+    memcpy(latched, drive, length);
+
+    // Latch, settle, load: the far side sees every driven near conductor wired to it
+    memset(captured, 0, length);
+    for (unsigned near = 0U; near < model_ports * 8U; near++)
+    {
+        if ((latched[near / 8U] & (1U << (near % 8U))) && (far_of[near] != BENCH_NOT_CONNECTED))
+        {
+            captured[far_of[near] / 8U] |= (uint8_t)(1U << (far_of[near] % 8U));
+        }
+    }
+}
+
+// Private function prototypes
+static void WirePanel(void);
+static double ScanMicroseconds(unsigned long exchanges, unsigned long bytes, unsigned ports);
+
+// One copy of the scan engine per port count
+#define PANELSCAN_PORT_COUNT 1U
+namespace ports1 {
+#include "PanelScan.cpp"
+const unsigned port_count = PANELSCAN_PORT_COUNT;
+}
+#undef PANELSCAN_H
+#undef PANELSCAN_PORT_COUNT
+#define PANELSCAN_PORT_COUNT 8U
+namespace ports8 {
+#include "PanelScan.cpp"
+const unsigned port_count = PANELSCAN_PORT_COUNT;
+}
+#undef PANELSCAN_H
+#undef PANELSCAN_PORT_COUNT
+#define PANELSCAN_PORT_COUNT 24U
+namespace ports24 {
+#include "PanelScan.cpp"
+const unsigned port_count = PANELSCAN_PORT_COUNT;
+}
+#undef PANELSCAN_H
+#undef PANELSCAN_PORT_COUNT
+#define PANELSCAN_PORT_COUNT 48U
+namespace ports48 {
+#include "PanelScan.cpp"
+const unsigned port_count = PANELSCAN_PORT_COUNT;
+}
+#undef PANELSCAN_H
+#undef PANELSCAN_PORT_COUNT
+#define PANELSCAN_PORT_COUNT 96U
+namespace ports96 {
+#include "PanelScan.cpp"
+const unsigned port_count = PANELSCAN_PORT_COUNT;
+}
+
+/**
+ * @brief Scan a panel with every fault scenario and print one table row
+ * @return unsigned Number of wrong port verdicts
+ */
+template <typename PanelMapT>
+static unsigned RunBench(unsigned ports, void (*init)(void), void (*scan)(PanelMapT*))
+{
+    static PanelMapT panel;
+    unsigned errors = 0U;
+
+    model_ports = ports;
+    init();
+
+    // Scenario: expected failing ports, then the miswiring that causes it
+    for (int scenario = 0; scenario < 5; scenario++)
+    {
+        uint8_t expect_fail[BENCH_MAX_PORTS] = { 0U };
+        unsigned last = ports - 1U;
+
+        WirePanel();
+        if (scenario == 1)
+        {
+            // Open conductor
+            far_of[last * 8U + 2U] = BENCH_NOT_CONNECTED;
+            expect_fail[last] = 1U;
+        }
+        else if (scenario == 2)
+        {
+            // Crossed pair inside one port
+            far_of[last * 8U + 1U] = (uint16_t)(last * 8U + 2U);
+            far_of[last * 8U + 2U] = (uint16_t)(last * 8U + 1U);
+            expect_fail[last] = 1U;
+        }
+        else if ((scenario == 3) && (ports > 1U))
+        {
+            // Two ports punched down on each other's rear positions
+            for (unsigned i = 0U; i < 8U; i++)
+            {
+                far_of[i] = (uint16_t)(8U + i);
+                far_of[8U + i] = (uint16_t)i;
+            }
+            expect_fail[0] = 1U;
+            expect_fail[1] = 1U;
+        }
+        else if ((scenario == 4) && (ports > 1U))
+        {
+            // One wire on the same pin of the neighbouring port
+            far_of[last * 8U + 5U] = (uint16_t)((last - 1U) * 8U + 5U);
+            expect_fail[last] = 1U;
+            expect_fail[last - 1U] = 1U;
+        }
+
+        scan(&panel);
+
+        for (unsigned p = 0U; p < ports; p++)
+        {
+            uint8_t failed = (panel.foreign_mask[p] != 0U) ? 1U : 0U;
+
+            for (unsigned i = 0U; i < 8U; i++)
+            {
+                if (panel.maps[p].rows[i] != (1U << i))
+                {
+                    failed = 1U;
+                }
+            }
+            if (failed != expect_fail[p])
+            {
+                printf("%u ports, scenario %d: port %u %s\n", ports, scenario, p + 1U,
+                       failed ? "fails" : "passes");
+                errors++;
+            }
+        }
+    }
+
+    // Cost of one scan
+    exchange_count = 0UL;
+    byte_count = 0UL;
+    WirePanel();
+    scan(&panel);
+
+    double scan_us = ScanMicroseconds(exchange_count, byte_count, ports);
+    double naive_us = ScanMicroseconds(8UL * ports + 1UL, (8UL * ports + 1UL) * ports, ports);
+
+    printf("%5u %9lu %7lu %10.1f %8.2f %12.1f %8.2f\n", ports, exchange_count, byte_count,
+           scan_us, scan_us / ports, naive_us, naive_us / ports);
+    return errors;
+}
+
+int main(void)
+{
+    unsigned errors = 0U;
+
+    printf("SPI %.0f MHz, %.1f us per exchange, %.0f cycles per port byte\n",
+           BENCH_SPI_HZ / 1e6, BENCH_EXCHANGE_US, BENCH_CYCLES_PER_PORT);
+    printf("                              panel scan      one port at a time\n");
+    printf("ports exchanges   bytes    scan us  us/port      scan us  us/port\n");
+
+    errors += RunBench(ports1::port_count, ports1::PanelScan_Init, ports1::PanelScan_Scan);
+    errors += RunBench(ports8::port_count, ports8::PanelScan_Init, ports8::PanelScan_Scan);
+    errors += RunBench(ports24::port_count, ports24::PanelScan_Init, ports24::PanelScan_Scan);
+    errors += RunBench(ports48::port_count, ports48::PanelScan_Init, ports48::PanelScan_Scan);
+    errors += RunBench(ports96::port_count, ports96::PanelScan_Init, ports96::PanelScan_Scan);
+
+    printf("%s\n", (errors == 0U) ? "PASS" : "FAIL");
+    return (errors == 0U) ? 0 : 1;
+}
+
+// Private function implementations
+
+static void WirePanel(void)
+{
+    // Good panel: every near conductor reaches the same pin of the same port
+    for (unsigned i = 0U; i < BENCH_MAX_PORTS * 8U; i++)
+    {
+        far_of[i] = (i < model_ports * 8U) ? (uint16_t)i : BENCH_NOT_CONNECTED;
+    }
+}
+
+static double ScanMicroseconds(unsigned long exchanges, unsigned long bytes, unsigned ports)
+{
+    double spi_us = (bytes * 8.0 * 1e6) / BENCH_SPI_HZ;
+    double cpu_us = (exchanges * ports * BENCH_CYCLES_PER_PORT * 1e6) / BENCH_CORE_HZ;
+
+    return spi_us + cpu_us + exchanges * BENCH_EXCHANGE_US;
+}
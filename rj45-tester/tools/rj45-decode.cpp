@@ -0,0 +1,624 @@
+/**
+ * @file rj45-decode.cpp
+ * @brief Linux decoder for the binary result stream of the RJ45 tester
+ * @details Reads COBS frames from a serial device, a pty or a capture file,
+ *          checks CRC and sequence numbers and prints the cable verdicts.
+ *
+ *          Build from the rj45-tester directory:
+ *          g++ -O2 -Wall -Ilib/ResultStream -Ilib/BatchTest -Ilib/FlashLog -Ilib/UartLog -Ilib/WireClass -Ilib/WireMap \
+ *              tools/rj45-decode.cpp lib/ResultStream/ResultProtocol.cpp \
+ *              lib/WireClass/WireClass.cpp -o rj45-decode
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "BatchTest.h"
+#include "FlashLog.h"
+#include "ResultProtocol.h"
+#include "UartLogFormats.h"
+#include "WireClass.h"
+
+// Configuration constants
+#define DECODE_READ_SIZE            65536U /**< Bytes per read() call */
+#define DECODE_DEFAULT_BAUD         115200U
+
+// Type definitions
+/**
+ * @brief Decoder options from the command line
+ */
+typedef struct
+{
+    const char* path;            /**< Device, pty or file, "-" for stdin */
+    const char* log_path;        /**< CSV log of every frame, NULL for none */
+    const char* command;         /**< Console commands written to the device at start */
+    unsigned baud;               /**< Baud rate for tty devices */
+    int print_all;               /**< Print every frame instead of changes only */
+    int quiet;                   /**< Print statistics only */
+} DecodeOptions_t;
+
+/**
+ * @brief Stream statistics
+ */
+typedef struct
+{
+    unsigned long bytes;         /**< Bytes read */
+    unsigned long frames;        /**< Valid frames */
+    unsigned long crc_errors;    /**< Frames with bad CRC */
+    unsigned long format_errors; /**< Frames with bad COBS encoding, length or type */
+    unsigned long lost_frames;   /**< Frames missing according to the sequence numbers */
+} DecodeStats_t;
+
+#define LOG_ARG_COUNT(id, arg_count, format) (arg_count),
+#define LOG_FORMAT_STRING(id, arg_count, format) format,
+
+// Private variables
+static const uint8_t log_arg_counts[UARTLOG_FORMAT_COUNT] = { UARTLOG_FORMATS(LOG_ARG_COUNT) };
+static const char* const log_formats[UARTLOG_FORMAT_COUNT] = { UARTLOG_FORMATS(LOG_FORMAT_STRING) };
+static volatile sig_atomic_t stop_requested = 0;
+static DecodeStats_t stats;
+static FILE* log_file = NULL;
+static int have_sequence = 0;
+static uint16_t last_sequence = 0U;
+static uint8_t last_rows[8];
+static int last_verdict = -1;
+
+// Private function prototypes
+static void OnSignal(int signal_number);
+static int ParseOptions(int argc, char** argv, DecodeOptions_t* options);
+static int OpenInput(const DecodeOptions_t* options);
+static speed_t BaudToSpeed(unsigned baud);
+static void HandleFrame(const uint8_t* encoded, size_t length, const DecodeOptions_t* options);
+static void HandleScan(uint16_t sequence, uint32_t timestamp, const uint8_t* body, const DecodeOptions_t* options);
+static void HandleHunt(uint16_t sequence, uint32_t timestamp, const uint8_t* body, const DecodeOptions_t* options);
+static void HandleBatch(uint16_t sequence, uint32_t timestamp, const uint8_t* body, const DecodeOptions_t* options);
+static void HandleLog(uint16_t sequence, uint32_t timestamp, const uint8_t* body, const DecodeOptions_t* options);
+static void FormatLog(char* text, size_t size, const char* format, const unsigned long* args);
+static void HandleHistory(uint16_t sequence, uint32_t timestamp, const uint8_t* body, const DecodeOptions_t* options);
+static void PrintStats(double seconds);
+
+int main(int argc, char** argv)
+{
+    DecodeOptions_t options;
+    if (ParseOptions(argc, argv, &options) != 0)
+    {
+        fprintf(stderr,
+                "usage: %s [-b baud] [-c commands] [-l log.csv] [-a] [-q] <device|file|->\n"
+                "  -b  baud rate for serial devices (default %u)\n"
+                "  -c  console commands sent to the tester first, separated by ';', e.g. -c b (tty or pty only)\n"
+                "  -l  append every frame to a CSV log\n"
+                "  -a  print every frame, not only changed verdicts\n"
+                "  -q  print only the statistics at exit\n",
+                argv[0], DECODE_DEFAULT_BAUD);
+        return 2;
+    }
+
+    int fd = OpenInput(&options);
+    if (fd < 0)
+    {
+        return 1;
+    }
+
+    if (options.log_path != NULL)
+    {
+        log_file = fopen(options.log_path, "a");
+        if (log_file == NULL)
+        {
+            fprintf(stderr, "%s: %s\n", options.log_path, strerror(errno));
+            return 1;
+        }
+        // Header only for a new log, appended runs share it
+        fseek(log_file, 0L, SEEK_END);
+        if (ftell(log_file) == 0L)
+        {
+            fprintf(log_file, "type,seq,timestamp_ms,verdict,rows_or_glitches\n");
+        }
+    }
+
+    signal(SIGINT, OnSignal);
+    signal(SIGTERM, OnSignal);
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    static uint8_t input[DECODE_READ_SIZE];
+    uint8_t frame[RESULTPROTOCOL_MAX_ENCODED];
+    size_t frame_length = 0U;
+    int frame_overflow = 0;
+
+    while (!stop_requested)
+    {
+        ssize_t count = read(fd, input, sizeof(input));
+        if (count == 0)
+        {
+            break;
+        }
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            fprintf(stderr, "read: %s\n", strerror(errno));
+            break;
+        }
+
+        stats.bytes += (unsigned long)count;
+
+        for (ssize_t i = 0; i < count; i++)
+        {
+            if (input[i] == RESULTPROTOCOL_DELIMITER)
+            {
+                if (frame_overflow)
+                {
+                    stats.format_errors++;
+                }
+                else if (frame_length > 0U)
+                {
+                    HandleFrame(frame, frame_length, &options);
+                }
+                frame_length = 0U;
+                frame_overflow = 0;
+            }
+            else if (frame_length < sizeof(frame))
+            {
+                frame[frame_length++] = input[i];
+            }
+            else
+            {
+                // Text output or line noise, resynchronize on the next delimiter
+                frame_overflow = 1;
+            }
+        }
+    }
+
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    PrintStats((double)(end.tv_sec - start.tv_sec) + ((double)(end.tv_nsec - start.tv_nsec) / 1e9));
+
+    if (log_file != NULL)
+    {
+        fclose(log_file);
+    }
+    close(fd);
+
+    return 0;
+}
+
+// Private function implementations
+
+static void OnSignal(int signal_number)
+{
+    (void)signal_number;
+    stop_requested = 1;
+}
+
+static int ParseOptions(int argc, char** argv, DecodeOptions_t* options)
+{
+    options->path = NULL;
+    options->log_path = NULL;
+    options->command = NULL;
+    options->baud = DECODE_DEFAULT_BAUD;
+    options->print_all = 0;
+    options->quiet = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "b:c:l:aq")) != -1)
+    {
+        switch (opt)
+        {
+            case 'b':
+                options->baud = (unsigned)strtoul(optarg, NULL, 10);
+                break;
+            case 'c':
+                options->command = optarg;
+                break;
+            case 'l':
+                options->log_path = optarg;
+                break;
+            case 'a':
+                options->print_all = 1;
+                break;
+            case 'q':
+                options->quiet = 1;
+                break;
+            default:
+                return -1;
+        }
+    }
+
+    if (optind != (argc - 1))
+    {
+        return -1;
+    }
+    options->path = argv[optind];
+
+    return 0;
+}
+
+static int OpenInput(const DecodeOptions_t* options)
+{
+    if (strcmp(options->path, "-") == 0)
+    {
+        if (options->command != NULL)
+        {
+            fprintf(stderr, "stdin: -c ignored\n");
+        }
+        return STDIN_FILENO;
+    }
+
+    // Read only, a capture file must never be written to
+    int fd = open(options->path, O_RDONLY | O_NOCTTY);
+    if (fd < 0)
+    {
+        fprintf(stderr, "%s: %s\n", options->path, strerror(errno));
+        return -1;
+    }
+
+    if (isatty(fd))
+    {
+        if (options->command != NULL)
+        {
+            // Serial device or pty, reopen it for the console commands
+            close(fd);
+            fd = open(options->path, O_RDWR | O_NOCTTY);
+            if (fd < 0)
+            {
+                fprintf(stderr, "%s: %s\n", options->path, strerror(errno));
+                return -1;
+            }
+        }
+
+        speed_t speed = BaudToSpeed(options->baud);
+        struct termios tio;
+
+        if ((speed == 0) || (tcgetattr(fd, &tio) != 0))
+        {
+            fprintf(stderr, "%s: cannot configure %u baud\n", options->path, options->baud);
+            close(fd);
+            return -1;
+        }
+
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, speed);
+        cfsetospeed(&tio, speed);
+        tio.c_cflag |= (CLOCAL | CREAD);
+        tio.c_cc[VMIN] = 1;
+        tio.c_cc[VTIME] = 0;
+        tcsetattr(fd, TCSANOW, &tio);
+        tcflush(fd, TCIFLUSH);
+    }
+
+    if ((options->command != NULL) && !isatty(fd))
+    {
+        fprintf(stderr, "%s: not a terminal, -c ignored\n", options->path);
+    }
+    else if (options->command != NULL)
+    {
+        // The console runs a command when its line ends
+        if ((write(fd, options->command, strlen(options->command)) < 0) || (write(fd, "\n", 1U) < 0))
+        {
+            fprintf(stderr, "%s: %s\n", options->path, strerror(errno));
+        }
+    }
+
+    return fd;
+}
+
+static speed_t BaudToSpeed(unsigned baud)
+{
+    switch (baud)
+    {
+        case 9600U:    return B9600;
+        case 19200U:   return B19200;
+        case 38400U:   return B38400;
+        case 57600U:   return B57600;
+        case 115200U:  return B115200;
+        case 230400U:  return B230400;
+        case 460800U:  return B460800;
+        case 921600U:  return B921600;
+        default:       return 0;
+    }
+}
+
+static void HandleFrame(const uint8_t* encoded, size_t length, const DecodeOptions_t* options)
+{
+    uint8_t payload[RESULTPROTOCOL_MAX_ENCODED];
+    size_t payload_length = ResultProtocol_CobsDecode(encoded, length, payload);
+
+    if (payload_length < (RESULTPROTOCOL_HEADER_SIZE + RESULTPROTOCOL_CRC_SIZE))
+    {
+        stats.format_errors++;
+        return;
+    }
+
+    size_t data_length = payload_length - RESULTPROTOCOL_CRC_SIZE;
+    if (ResultProtocol_Crc16(payload, data_length) != ResultProtocol_GetU16(&payload[data_length]))
+    {
+        stats.crc_errors++;
+        return;
+    }
+
+    uint8_t type = payload[0];
+    size_t body_length = data_length - RESULTPROTOCOL_HEADER_SIZE;
+    if (!(((type == RESULTPROTOCOL_TYPE_SCAN) && (body_length == RESULTPROTOCOL_SCAN_BODY)) ||
+          ((type == RESULTPROTOCOL_TYPE_HUNT) && (body_length == RESULTPROTOCOL_HUNT_BODY)) ||
+          ((type == RESULTPROTOCOL_TYPE_BATCH) && (body_length == RESULTPROTOCOL_BATCH_BODY)) ||
+          ((type == RESULTPROTOCOL_TYPE_HISTORY) && (body_length == RESULTPROTOCOL_HISTORY_BODY)) ||
+          ((type == RESULTPROTOCOL_TYPE_LOG) && (body_length >= 1U) && (payload[RESULTPROTOCOL_HEADER_SIZE] < UARTLOG_FORMAT_COUNT) &&
+           (body_length == (1U + (4U * log_arg_counts[payload[RESULTPROTOCOL_HEADER_SIZE]]))))))
+    {
+        stats.format_errors++;
+        return;
+    }
+
+    uint16_t sequence = ResultProtocol_GetU16(&payload[1]);
+    uint32_t timestamp = ResultProtocol_GetU32(&payload[3]);
+
+    // Every frame produced by the firmware is numbered, a gap is a lost frame
+    if (have_sequence)
+    {
+        stats.lost_frames += (uint16_t)(sequence - last_sequence - 1U);
+    }
+    have_sequence = 1;
+    last_sequence = sequence;
+    stats.frames++;
+
+    if (type == RESULTPROTOCOL_TYPE_SCAN)
+    {
+        HandleScan(sequence, timestamp, &payload[RESULTPROTOCOL_HEADER_SIZE], options);
+    }
+    else if (type == RESULTPROTOCOL_TYPE_HUNT)
+    {
+        HandleHunt(sequence, timestamp, &payload[RESULTPROTOCOL_HEADER_SIZE], options);
+    }
+    else if (type == RESULTPROTOCOL_TYPE_BATCH)
+    {
+        HandleBatch(sequence, timestamp, &payload[RESULTPROTOCOL_HEADER_SIZE], options);
+    }
+    else if (type == RESULTPROTOCOL_TYPE_HISTORY)
+    {
+        HandleHistory(sequence, timestamp, &payload[RESULTPROTOCOL_HEADER_SIZE], options);
+    }
+    else
+    {
+        HandleLog(sequence, timestamp, &payload[RESULTPROTOCOL_HEADER_SIZE], options);
+    }
+}
+
+static void HandleScan(uint16_t sequence, uint32_t timestamp, const uint8_t* body, const DecodeOptions_t* options)
+{
+    WireClass_t verdict = (WireClass_t)body[8];
+    uint8_t reversed_pairs = body[9];
+
+    if (log_file != NULL)
+    {
+        fprintf(log_file, "scan,%u,%lu,%s,", sequence, (unsigned long)timestamp, WireClass_GetName(verdict));
+        for (uint8_t i = 0U; i < 8U; i++)
+        {
+            fprintf(log_file, "%02X%s", body[i], (i < 7U) ? " " : "\n");
+        }
+    }
+
+    int changed = ((int)verdict != last_verdict) || (memcmp(body, last_rows, sizeof(last_rows)) != 0);
+    memcpy(last_rows, body, sizeof(last_rows));
+    last_verdict = (int)verdict;
+
+    if (options->quiet || (!changed && !options->print_all))
+    {
+        return;
+    }
+
+    printf("%10lu ms  #%-5u  %-17s", (unsigned long)timestamp, sequence, WireClass_GetName(verdict));
+    if (verdict == WIRECLASS_REVERSED_PAIR)
+    {
+        static const char* const pair_names[4] = { "1-2", "3-6", "4-5", "7-8" };
+        for (uint8_t p = 0U; p < 4U; p++)
+        {
+            if (reversed_pairs & (1U << p))
+            {
+                printf(" %s", pair_names[p]);
+            }
+        }
+    }
+    printf("  rows");
+    for (uint8_t i = 0U; i < 8U; i++)
+    {
+        printf(" %02X", body[i]);
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+static void HandleHunt(uint16_t sequence, uint32_t timestamp, const uint8_t* body, const DecodeOptions_t* options)
+{
+    uint32_t scan_count = ResultProtocol_GetU32(&body[0]);
+    uint8_t latched_mask = body[4];
+
+    if (log_file != NULL)
+    {
+        fprintf(log_file, "hunt,%u,%lu,%lu,", sequence, (unsigned long)timestamp, (unsigned long)scan_count);
+        for (uint8_t i = 0U; i < 8U; i++)
+        {
+            fprintf(log_file, "%u%s", ResultProtocol_GetU16(&body[5U + (2U * i)]), (i < 7U) ? " " : "\n");
+        }
+    }
+
+    if (options->quiet)
+    {
+        return;
+    }
+
+    printf("%10lu ms  #%-5u  HUNT %lu scans, latched %02X, glitches",
+           (unsigned long)timestamp, sequence, (unsigned long)scan_count, latched_mask);
+    for (uint8_t i = 0U; i < 8U; i++)
+    {
+        printf(" %u", ResultProtocol_GetU16(&body[5U + (2U * i)]));
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+static void HandleBatch(uint16_t sequence, uint32_t timestamp, const uint8_t* body, const DecodeOptions_t* options)
+{
+    const char* result = (body[6] == (uint8_t)BATCHTEST_PASSED) ? "PASS" : "FAIL";
+    WireClass_t verdict = (WireClass_t)body[7];
+    unsigned tested = ResultProtocol_GetU16(&body[0]);
+    unsigned passed = ResultProtocol_GetU16(&body[2]);
+    unsigned failed = ResultProtocol_GetU16(&body[4]);
+    unsigned ttv_ms = ResultProtocol_GetU16(&body[8]);
+    unsigned median_ms = ResultProtocol_GetU16(&body[10]);
+    unsigned long cables_per_hour = (unsigned long)ResultProtocol_GetU32(&body[12]);
+
+    if (log_file != NULL)
+    {
+        fprintf(log_file, "batch,%u,%lu,%s %s,%u %u %u %u %u %lu\n", sequence, (unsigned long)timestamp,
+                result, WireClass_GetName(verdict), tested, passed, failed, ttv_ms, median_ms, cables_per_hour);
+    }
+
+    if (options->quiet)
+    {
+        return;
+    }
+
+    printf("%10lu ms  #%-5u  CABLE %u %s %s in %u ms, %u passed, %u failed, %lu cables/h, median %u ms\n",
+           (unsigned long)timestamp, sequence, tested, result, WireClass_GetName(verdict), ttv_ms,
+           passed, failed, cables_per_hour, median_ms);
+    fflush(stdout);
+}
+
+static void HandleLog(uint16_t sequence, uint32_t timestamp, const uint8_t* body, const DecodeOptions_t* options)
+{
+    uint8_t format = body[0];
+    unsigned long args[RESULTPROTOCOL_LOG_MAX_ARGS] = { 0UL, 0UL };
+    char text[128];
+
+    for (uint8_t i = 0U; i < log_arg_counts[format]; i++)
+    {
+        args[i] = (unsigned long)ResultProtocol_GetU32(&body[1U + (4U * i)]);
+    }
+    FormatLog(text, sizeof(text), log_formats[format], args);
+
+    if (log_file != NULL)
+    {
+        fprintf(log_file, "log,%u,%lu,\"%s\"\n", sequence, (unsigned long)timestamp, text);
+    }
+
+    if (options->quiet)
+    {
+        return;
+    }
+
+    printf("%10lu ms  #%-5u  LOG %s\n", (unsigned long)timestamp, sequence, text);
+    fflush(stdout);
+}
+
+/**
+ * @brief printf() a log format one conversion at a time, %s prints a WireClass_t by name
+ */
+static void FormatLog(char* text, size_t size, const char* format, const unsigned long* args)
+{
+    size_t length = 0U;
+    uint8_t arg = 0U;
+
+    text[0] = '\0';
+    while ((*format != '\0') && (length + 1U < size))
+    {
+        if ((format[0] != '%') || (format[1] == '%'))
+        {
+            text[length++] = *format;
+            format += (format[0] == '%') ? 2 : 1;
+            text[length] = '\0';
+            continue;
+        }
+
+        // Flags, width and the l modifier up to the conversion letter
+        char spec[16];
+        size_t spec_length = strcspn(format + 1, "diouxXs") + 2U;
+        if ((format[spec_length - 1U] == '\0') || (spec_length >= sizeof(spec)) ||
+            (arg == RESULTPROTOCOL_LOG_MAX_ARGS))
+        {
+            break;
+        }
+        memcpy(spec, format, spec_length);
+        spec[spec_length] = '\0';
+        format += spec_length;
+
+        int written;
+        if (spec[spec_length - 1U] == 's')
+        {
+            written = snprintf(&text[length], size - length, spec, WireClass_GetName((WireClass_t)args[arg]));
+        }
+        else
+        {
+            written = snprintf(&text[length], size - length, spec, args[arg]);
+        }
+        arg++;
+        if (written < 0)
+        {
+            break;
+        }
+        length += ((size_t)written < size - length) ? (size_t)written : (size - length - 1U);
+    }
+}
+
+static void HandleHistory(uint16_t sequence, uint32_t timestamp, const uint8_t* body, const DecodeOptions_t* options)
+{
+    static const char* const kind_names[3] = { "SCAN", "HUNT", "BATCH" };
+    unsigned long record = (unsigned long)ResultProtocol_GetU32(&body[0]);
+    unsigned long time_ms = (unsigned long)ResultProtocol_GetU32(&body[4]);
+    unsigned boot = ResultProtocol_GetU16(&body[8]);
+    const char* kind = (body[10] < 3U) ? kind_names[body[10]] : "?";
+    WireClass_t verdict = (WireClass_t)body[11];
+
+    if (log_file != NULL)
+    {
+        fprintf(log_file, "history,%u,%lu,%lu %u %lu %s %s,", sequence, (unsigned long)timestamp,
+                record, boot, time_ms, kind, WireClass_GetName(verdict));
+        for (uint8_t i = 0U; i < 8U; i++)
+        {
+            fprintf(log_file, "%02X ", body[12U + i]);
+        }
+        for (uint8_t i = 0U; i < 8U; i++)
+        {
+            fprintf(log_file, "%u%s", body[20U + i], (i < 7U) ? " " : "\n");
+        }
+    }
+
+    if (options->quiet)
+    {
+        return;
+    }
+
+    printf("%10lu ms  #%-5u  RECORD %lu boot %u at %lu ms %s %s  rows",
+           (unsigned long)timestamp, sequence, record, boot, time_ms, kind, WireClass_GetName(verdict));
+    for (uint8_t i = 0U; i < 8U; i++)
+    {
+        printf(" %02X", body[12U + i]);
+    }
+    if (body[10] == (uint8_t)FLASHLOG_KIND_HUNT)
+    {
+        printf("  latched %02X, glitches", body[28]);
+        for (uint8_t i = 0U; i < 8U; i++)
+        {
+            printf(" %u", body[20U + i]);
+        }
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+static void PrintStats(double seconds)
+{
+    fprintf(stderr,
+            "%lu bytes, %lu frames (%.0f frames/s), %lu lost, %lu CRC errors, %lu format errors\n",
+            stats.bytes, stats.frames, (seconds > 0.0) ? ((double)stats.frames / seconds) : 0.0,
+            stats.lost_frames, stats.crc_errors, stats.format_errors);
+}
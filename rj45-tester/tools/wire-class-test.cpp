@@ -0,0 +1,471 @@
+/**
+ * @file wire-class-test.cpp
+ * @brief Exhaustive host test of the wiremap analysis and the wiring classifier
+ * @details Runs the unchanged WireMap_Analyze() and WireClass_Classify() on
+ *          every cable the tester can tell apart by pin-to-pin connectivity
+ *          and checks masks, far conductors and verdicts against a reference
+ *          written from the definitions in WireMap.h and WireClass.h:
+ *
+ *          1. All 40320 far-end permutations: one of the four named maps,
+ *             one of the 15 reversed-pair combinations, or MISWIRED
+ *          2. Every combination of reversed pairs, with the reported pairs
+ *          3. Every permutation with every set of open conductors, up to
+ *             all eight (no cable)
+ *          4. Every permutation with every two conductors shorted together,
+ *             and with one conductor reaching a second far pin
+ *          5. Shorts on a straight cable combined with every set of open
+ *             conductors among the others
+ *          6. A million random matrices against the reference analysis
+ *
+ *          Exits with 1 on the first section with a mismatch.
+ *
+ *          Build and run from the rj45-tester directory:
+ *          g++ -O2 -Wall -Ilib/WireMap -Ilib/WireClass tools/wire-class-test.cpp \
+ *              lib/WireMap/WireMap.cpp lib/WireClass/WireClass.cpp -o wire-class-test
+ *          ./wire-class-test
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "WireClass.h"
+#include "WireMap.h"
+#include "WireMapHal.h"
+
+// Configuration constants
+#define TEST_RANDOM_MATRICES        1000000UL
+#define TEST_PERMUTATIONS           40320UL   /**< 8! */
+#define TEST_MAX_REPORTED           5U        /**< Mismatches printed per section */
+
+// Type definitions
+/**
+ * @brief Named one-to-one map, far conductor of each near conductor
+ */
+typedef struct
+{
+    uint8_t far[WIREMAP_CONDUCTOR_COUNT];
+    WireClass_t verdict;
+} TestNamedMap_t;
+
+// Private constants
+static const TestNamedMap_t named_maps[] =
+{
+    { { 0, 1, 2, 3, 4, 5, 6, 7 }, WIRECLASS_STRAIGHT },
+    { { 2, 5, 0, 3, 4, 1, 6, 7 }, WIRECLASS_CROSSOVER },
+    { { 2, 5, 0, 6, 7, 1, 3, 4 }, WIRECLASS_CROSSOVER_GIGABIT },
+    { { 7, 6, 5, 4, 3, 2, 1, 0 }, WIRECLASS_ROLLOVER },
+};
+
+// Wires of each pair: 1-2, 3-6, 4-5, 7-8
+static const uint8_t pair_wires[4][2] = { { 0, 1 }, { 2, 5 }, { 3, 4 }, { 6, 7 } };
+
+// Private variables
+static unsigned section_errors;
+static uint32_t random_state = 1U;
+
+// Private function prototypes
+static void ReferenceAnalyze(const WireMap_t* map, WireMapReport_t* report);
+static WireClass_t ReferenceClassify(const WireMap_t* map, uint8_t* pairs);
+static void Check(const WireMap_t* map, const char* what);
+static void MapFromFar(const uint8_t* far, WireMap_t* map);
+static uint8_t NextPermutation(uint8_t* far);
+static void ReversedPairs(uint8_t pairs, uint8_t* far);
+static uint32_t Random(void);
+static unsigned EndSection(const char* name, unsigned long cases);
+
+// Scan HAL, never called: the tests build matrices directly (same contract as WireMapHal.cpp)
+
+void WireMapHal_Init(void)
+{
+}
+
+void WireMapHal_BeginScan(void)
+{
+}
+
+uint8_t WireMapHal_Probe(uint8_t conductor)
+{
+    (void)conductor;
+    return 0U;
+}
+
+void WireMapHal_EndScan(void)
+{
+}
+
+int main(void)
+{
+    unsigned failed = 0U;
+    unsigned long cases;
+    unsigned long histogram[WIRECLASS_COUNT] = { 0 };
+    uint8_t far[WIREMAP_CONDUCTOR_COUNT];
+    WireMap_t map;
+
+    // 1. Far-end permutations
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        far[i] = i;
+    }
+    cases = 0UL;
+    do
+    {
+        WireMapReport_t report;
+
+        MapFromFar(far, &map);
+        Check(&map, "permutation");
+        WireMap_Analyze(&map, &report);
+        histogram[WireClass_Classify(&report, NULL)]++;
+        cases++;
+    } while (NextPermutation(far));
+    failed += EndSection("permutations", cases);
+    if (cases != TEST_PERMUTATIONS)
+    {
+        printf("  expected %lu permutations\n", TEST_PERMUTATIONS);
+        failed++;
+    }
+    for (uint8_t v = 0U; v < WIRECLASS_COUNT; v++)
+    {
+        if (histogram[v] != 0UL)
+        {
+            printf("  %-18s %5lu\n", WireClass_GetName((WireClass_t)v), histogram[v]);
+        }
+    }
+    if ((histogram[WIRECLASS_STRAIGHT] != 1UL) || (histogram[WIRECLASS_REVERSED_PAIR] != 15UL) ||
+        (histogram[WIRECLASS_MISWIRED] != TEST_PERMUTATIONS - 19UL))
+    {
+        printf("  unexpected verdict counts\n");
+        failed++;
+    }
+
+    // 2. Reversed pairs, the reported pairs must match
+    for (uint8_t pairs = 0U; pairs < 16U; pairs++)
+    {
+        WireMapReport_t report;
+        uint8_t reported = 0xFFU;
+
+        ReversedPairs(pairs, far);
+        MapFromFar(far, &map);
+        Check(&map, "reversed pairs");
+        WireMap_Analyze(&map, &report);
+        WireClass_t verdict = WireClass_Classify(&report, &reported);
+        if (reported != pairs)
+        {
+            printf("  pairs 0x%X reported as 0x%X (%s)\n", pairs, reported, WireClass_GetName(verdict));
+            section_errors++;
+        }
+    }
+    failed += EndSection("reversed pair combinations", 16UL);
+
+    // 3. Open conductors on every permutation, 0xFF is no cable
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        far[i] = i;
+    }
+    cases = 0UL;
+    do
+    {
+        for (uint16_t open = 1U; open <= 0xFFU; open++)
+        {
+            MapFromFar(far, &map);
+            for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+            {
+                if (open & (1U << i))
+                {
+                    map.rows[i] = 0U;
+                }
+            }
+            Check(&map, "open");
+            cases++;
+        }
+    } while (NextPermutation(far));
+    failed += EndSection("permutations x open sets", cases);
+
+    // 4. Shorts on every permutation
+    cases = 0UL;
+    do
+    {
+        // Two conductors shorted together: both reach both far pins
+        for (uint8_t a = 0U; a < WIREMAP_CONDUCTOR_COUNT; a++)
+        {
+            for (uint8_t b = (uint8_t)(a + 1U); b < WIREMAP_CONDUCTOR_COUNT; b++)
+            {
+                MapFromFar(far, &map);
+                map.rows[a] = map.rows[b] = (uint8_t)(map.rows[a] | map.rows[b]);
+                Check(&map, "short");
+                cases++;
+            }
+        }
+        // One conductor also touching another far pin
+        for (uint8_t a = 0U; a < WIREMAP_CONDUCTOR_COUNT; a++)
+        {
+            for (uint8_t extra = 0U; extra < WIREMAP_CONDUCTOR_COUNT; extra++)
+            {
+                if (extra == far[a])
+                {
+                    continue;
+                }
+                MapFromFar(far, &map);
+                map.rows[a] |= (uint8_t)(1U << extra);
+                Check(&map, "split");
+                cases++;
+            }
+        }
+    } while (NextPermutation(far));
+    failed += EndSection("permutations x shorts", cases);
+
+    // 5. A short wins over any open conductors
+    cases = 0UL;
+    for (uint8_t a = 0U; a < WIREMAP_CONDUCTOR_COUNT; a++)
+    {
+        for (uint8_t b = (uint8_t)(a + 1U); b < WIREMAP_CONDUCTOR_COUNT; b++)
+        {
+            for (uint16_t open = 0U; open <= 0xFFU; open++)
+            {
+                if (open & ((1U << a) | (1U << b)))
+                {
+                    continue;
+                }
+                MapFromFar(far, &map);
+                map.rows[a] = map.rows[b] = (uint8_t)(map.rows[a] | map.rows[b]);
+                for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+                {
+                    if (open & (1U << i))
+                    {
+                        map.rows[i] = 0U;
+                    }
+                }
+                Check(&map, "short with opens");
+                cases++;
+            }
+        }
+    }
+    failed += EndSection("shorts x open sets", cases);
+
+    // 6. Anything else the scan can return
+    for (unsigned long n = 0UL; n < TEST_RANDOM_MATRICES; n++)
+    {
+        uint32_t low = Random();
+        uint32_t high = Random();
+
+        memcpy(&map.rows[0], &low, 4U);
+        memcpy(&map.rows[4], &high, 4U);
+        Check(&map, "random");
+    }
+    failed += EndSection("random matrices", TEST_RANDOM_MATRICES);
+
+    printf("\n%s\n", (failed == 0U) ? "PASS" : "FAIL");
+    return (failed == 0U) ? 0 : 1;
+}
+
+// Private function implementations
+
+/**
+ * @brief Analysis straight from the WireMapReport_t definition
+ */
+static void ReferenceAnalyze(const WireMap_t* map, WireMapReport_t* report)
+{
+    uint8_t reached[WIREMAP_CONDUCTOR_COUNT] = { 0 };
+
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        for (uint8_t j = 0U; j < WIREMAP_CONDUCTOR_COUNT; j++)
+        {
+            reached[j] = (uint8_t)(reached[j] + ((map->rows[i] >> j) & 1U));
+        }
+    }
+
+    memset(report, 0, sizeof(*report));
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        uint8_t pins = 0U;
+        uint8_t shared = 0U;
+        uint8_t far = WIREMAP_NO_CONDUCTOR;
+
+        for (uint8_t j = 0U; j < WIREMAP_CONDUCTOR_COUNT; j++)
+        {
+            if (map->rows[i] & (1U << j))
+            {
+                pins++;
+                far = j;
+                shared |= (reached[j] > 1U) ? 1U : 0U;
+            }
+        }
+
+        report->far_conductor[i] = WIREMAP_NO_CONDUCTOR;
+        if (pins == 0U)
+        {
+            report->open_mask |= (uint8_t)(1U << i);
+        }
+        else if ((pins > 1U) || shared)
+        {
+            report->short_mask |= (uint8_t)(1U << i);
+        }
+        else
+        {
+            report->far_conductor[i] = far;
+            if (far == i)
+            {
+                report->ok_mask |= (uint8_t)(1U << i);
+            }
+            else
+            {
+                report->crossed_mask |= (uint8_t)(1U << i);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Verdict straight from the WireClass_t definition
+ */
+static WireClass_t ReferenceClassify(const WireMap_t* map, uint8_t* pairs)
+{
+    WireMapReport_t report;
+
+    ReferenceAnalyze(map, &report);
+    *pairs = 0U;
+
+    if (report.open_mask == 0xFFU)
+    {
+        return WIRECLASS_NO_CABLE;
+    }
+    if (report.short_mask != 0U)
+    {
+        return WIRECLASS_SHORT;
+    }
+    if (report.open_mask != 0U)
+    {
+        return WIRECLASS_OPEN;
+    }
+    for (uint8_t n = 0U; n < sizeof(named_maps) / sizeof(named_maps[0]); n++)
+    {
+        if (memcmp(report.far_conductor, named_maps[n].far, WIREMAP_CONDUCTOR_COUNT) == 0)
+        {
+            return named_maps[n].verdict;
+        }
+    }
+    for (uint8_t p = 1U; p < 16U; p++)
+    {
+        uint8_t far[WIREMAP_CONDUCTOR_COUNT];
+
+        ReversedPairs(p, far);
+        if (memcmp(report.far_conductor, far, WIREMAP_CONDUCTOR_COUNT) == 0)
+        {
+            *pairs = p;
+            return WIRECLASS_REVERSED_PAIR;
+        }
+    }
+    return WIRECLASS_MISWIRED;
+}
+
+/**
+ * @brief Compare the firmware with the reference on one matrix
+ */
+static void Check(const WireMap_t* map, const char* what)
+{
+    WireMapReport_t report;
+    WireMapReport_t expected;
+    uint8_t pairs;
+    uint8_t expected_pairs;
+
+    WireMap_Analyze(map, &report);
+    ReferenceAnalyze(map, &expected);
+    WireClass_t verdict = WireClass_Classify(&report, &pairs);
+    WireClass_t expected_verdict = ReferenceClassify(map, &expected_pairs);
+
+    if ((report.ok_mask == expected.ok_mask) && (report.open_mask == expected.open_mask) &&
+        (report.short_mask == expected.short_mask) && (report.crossed_mask == expected.crossed_mask) &&
+        (memcmp(report.far_conductor, expected.far_conductor, WIREMAP_CONDUCTOR_COUNT) == 0) &&
+        (verdict == expected_verdict) && (pairs == expected_pairs))
+    {
+        return;
+    }
+
+    if (section_errors++ < TEST_MAX_REPORTED)
+    {
+        printf("  %s:", what);
+        for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+        {
+            printf(" %02X", map->rows[i]);
+        }
+        printf(" -> %s/0x%X, expected %s/0x%X\n", WireClass_GetName(verdict), pairs,
+               WireClass_GetName(expected_verdict), expected_pairs);
+    }
+}
+
+static void MapFromFar(const uint8_t* far, WireMap_t* map)
+{
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        map->rows[i] = (uint8_t)(1U << far[i]);
+    }
+}
+
+/**
+ * @brief Next permutation in lexicographic order
+ * @return uint8_t 0 after the last one, far is then back to the first
+ */
+static uint8_t NextPermutation(uint8_t* far)
+{
+    int i = WIREMAP_CONDUCTOR_COUNT - 2;
+
+    while ((i >= 0) && (far[i] >= far[i + 1]))
+    {
+        i--;
+    }
+    if (i >= 0)
+    {
+        int j = WIREMAP_CONDUCTOR_COUNT - 1;
+        while (far[j] <= far[i])
+        {
+            j--;
+        }
+        uint8_t swap = far[i];
+        far[i] = far[j];
+        far[j] = swap;
+    }
+    for (int a = i + 1, b = WIREMAP_CONDUCTOR_COUNT - 1; a < b; a++, b--)
+    {
+        uint8_t swap = far[a];
+        far[a] = far[b];
+        far[b] = swap;
+    }
+    return (i >= 0) ? 1U : 0U;
+}
+
+/**
+ * @brief Straight map with the wires of the selected pairs exchanged
+ */
+static void ReversedPairs(uint8_t pairs, uint8_t* far)
+{
+    for (uint8_t i = 0U; i < WIREMAP_CONDUCTOR_COUNT; i++)
+    {
+        far[i] = i;
+    }
+    for (uint8_t p = 0U; p < 4U; p++)
+    {
+        if (pairs & (1U << p))
+        {
+            far[pair_wires[p][0]] = pair_wires[p][1];
+            far[pair_wires[p][1]] = pair_wires[p][0];
+        }
+    }
+}
+
+static uint32_t Random(void)
+{
+    // xorshift32, reproducible
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+static unsigned EndSection(const char* name, unsigned long cases)
+{
+    unsigned errors = section_errors;
+
+    printf("%-30s %9lu cases, %u mismatches\n", name, cases, errors);
+    section_errors = 0U;
+    return (errors != 0U) ? 1U : 0U;
+}
@@ -0,0 +1,301 @@
+/**
+ * @file wire-res-model.cpp
+ * @brief Host model of the conductor resistance measurement
+ * @details Replaces WireResHal with a simulated tester: GPIO driver
+ *          resistance, LED forward voltage, internal pull-down and reference
+ *          voltage drawn from the CH32V003 tolerances, Gaussian ADC noise and
+ *          10-bit quantization. Each simulated unit is zeroed with a short
+ *          cable, then WireRes_Measure() runs over cable lengths with and
+ *          without a bad joint on one conductor. Exits with 1 if the
+ *          oversampled level is less precise than the extra bits promise, a
+ *          bad joint is missed, a good cable is flagged, an open conductor is
+ *          not reported or a measurement is too slow.
+ *
+ *          Build and run from the rj45-tester directory:
+ *          g++ -O2 -Wall -Ilib/WireRes tools/wire-res-model.cpp lib/WireRes/WireRes.cpp -o wire-res-model
+ *          ./wire-res-model
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "WireRes.h"
+#include "WireResHal.h"
+
+// Configuration constants
+#define MODEL_UNITS                 200U   /**< Simulated testers, each with its own tolerances */
+#define MODEL_ZERO_M                0.3    /**< Cable used for WireRes_SetZero() */
+#define MODEL_OHMS_PER_M            0.094  /**< 24 AWG Cat5e conductor */
+#define MODEL_OHMS_SPREAD           0.02   /**< Conductor to conductor resistance spread */
+#define MODEL_NOISE_LSB             0.8    /**< ADC noise, RMS */
+#define MODEL_VDD_DRIFT             0.001  /**< Supply change between zero and measurement */
+#define MODEL_JOINT_NEAR_OHMS       10.0   /**< Bad joint that must be flagged on a near read conductor */
+#define MODEL_JOINT_FAR_OHMS        40.0   /**< Bad joint that must be flagged on a far read conductor */
+#define MODEL_CONVERSION_NS         583.0  /**< 3 + 11 cycles at 24 MHz */
+#define MODEL_VREF_CONVERSION_NS    2250.0 /**< 43 + 11 cycles at 24 MHz */
+#define MODEL_SETTLE_NS             20000.0 /**< WireResHal_Select() settle loop */
+#define MODEL_LEVEL_SIGMAS          4.0    /**< Oversampled level error allowed, in standard deviations of the mean */
+#define MODEL_TIME_LIMIT_NS         4000000.0 /**< Whole measurement must stay below 4 ms */
+
+// Type definitions
+/**
+ * @brief One simulated tester with a cable plugged into both jacks
+ */
+typedef struct
+{
+    double vdd;                  /**< Supply during the current measurement */
+    double vref;                 /**< Internal reference of this unit */
+    double driver_ohms[8];       /**< High side output resistance of the driving pin */
+    double led_vf[8];            /**< LED forward voltage on each near line */
+    double led_ohms[8];          /**< LED series resistor */
+    double pulldown_ohms[8];     /**< Far jack internal pull-down */
+    double pullup_ohms[8];       /**< Far jack internal pull-up */
+    double conductor_ohms[8];    /**< Conductor resistance including any joint */
+    int open_mask;               /**< Conductors without continuity */
+    int selected;                /**< Input selected by WireResHal_Select() */
+    int loaded;                  /**< Far pin pulled down rather than up */
+    double last_total_ns;        /**< Duration of the last measurement */
+} ModelUnit_t;
+
+// Private variables
+static ModelUnit_t unit;
+
+// Private function prototypes
+static double Uniform(double low, double high);
+static double Gauss(void);
+static double InputVolts(int input, int loaded);
+static void NewUnit(void);
+static void PlugCable(double length_m);
+
+// Simulated hardware, same contract as WireResHal.cpp
+
+void WireResHal_Init(void)
+{
+}
+
+void WireResHal_Select(uint8_t conductor, uint8_t loaded)
+{
+    unit.selected = conductor;
+    unit.loaded = loaded;
+    unit.last_total_ns += MODEL_SETTLE_NS;
+}
+
+void WireResHal_Burst(uint16_t* samples, uint8_t count)
+{
+    double volts = InputVolts(unit.selected, unit.loaded);
+
+    for (uint8_t i = 0U; i < count; i++)
+    {
+        double code = floor(volts / unit.vdd * WIRERESHAL_ADC_FULL_SCALE + Gauss() * MODEL_NOISE_LSB);
+
+        if (code < 0.0)
+        {
+            code = 0.0;
+        }
+        if (code > WIRERESHAL_ADC_FULL_SCALE - 1.0)
+        {
+            code = WIRERESHAL_ADC_FULL_SCALE - 1.0;
+        }
+        samples[i] = (uint16_t)code;
+    }
+
+    unit.last_total_ns += count * ((unit.selected == WIRERESHAL_VREF) ? MODEL_VREF_CONVERSION_NS : MODEL_CONVERSION_NS);
+}
+
+void WireResHal_Release(void)
+{
+}
+
+int main(void)
+{
+    static const double lengths_m[] = { 0.5, 1.0, 2.0, 5.0, 10.0, 20.0, 50.0, 100.0 };
+    const int length_count = (int)(sizeof(lengths_m) / sizeof(lengths_m[0]));
+    const double level_sigma = MODEL_NOISE_LSB * (1U << WIRERES_EXTRA_BITS) / sqrt((double)WIRERES_SAMPLE_COUNT);
+    double worst_level_error = 0.0;
+    double worst_near_ohms[sizeof(lengths_m) / sizeof(lengths_m[0])] = { 0.0 };
+    double worst_far_ohms[sizeof(lengths_m) / sizeof(lengths_m[0])] = { 0.0 };
+    double worst_time_ns = 0.0;
+    unsigned missed_joints = 0U;
+    unsigned false_joints = 0U;
+    unsigned missed_opens = 0U;
+    unsigned failures = 0U;
+    WireResLevels_t levels;
+
+    srand(1U);
+    WireResHal_Init();
+
+    for (unsigned u = 0U; u < MODEL_UNITS; u++)
+    {
+        WireResResult_t result;
+
+        NewUnit();
+
+        // Oversampling: the ADC truncates, so the true input sits half an LSB above the mean code
+        WireResHal_Select(WIRERESHAL_VREF, 1U);
+        double expected = (unit.vref / unit.vdd * WIRERESHAL_ADC_FULL_SCALE - 0.5) * (1U << WIRERES_EXTRA_BITS);
+        double level_error = fabs((double)WireRes_Oversample(WIRERES_SAMPLE_COUNT) - expected);
+        if (level_error > worst_level_error)
+        {
+            worst_level_error = level_error;
+        }
+
+        // Bench procedure: zero with a short patch cable, the supply may move a little afterwards
+        PlugCable(MODEL_ZERO_M);
+        WireRes_Sample(&levels);
+        WireRes_SetZero(&levels);
+        unit.vdd *= 1.0 + Uniform(-MODEL_VDD_DRIFT, MODEL_VDD_DRIFT);
+
+        for (int l = 0; l < length_count; l++)
+        {
+            double length_m = lengths_m[l];
+
+            // Good cable: nothing flagged
+            PlugCable(length_m);
+            unit.last_total_ns = 0.0;
+            WireRes_Measure(&result);
+            if (unit.last_total_ns > worst_time_ns)
+            {
+                worst_time_ns = unit.last_total_ns;
+            }
+            if (result.high_mask != 0U)
+            {
+                false_joints++;
+            }
+            for (int i = 0; i < 8; i++)
+            {
+                double true_ohms = unit.conductor_ohms[i] - MODEL_ZERO_M * MODEL_OHMS_PER_M;
+                double error = fabs(result.resistance_mohm[i] / 1000.0 - true_ohms);
+                double* worst = (WIRERES_NEAR_MASK & (1U << i)) ? &worst_near_ohms[l] : &worst_far_ohms[l];
+                if (error > *worst)
+                {
+                    *worst = error;
+                }
+            }
+
+            // One bad joint on a random conductor
+            int conductor = rand() % 8;
+            unit.conductor_ohms[conductor] += (WIRERES_NEAR_MASK & (1U << conductor)) ?
+                                              MODEL_JOINT_NEAR_OHMS : MODEL_JOINT_FAR_OHMS;
+            WireRes_Measure(&result);
+            if (result.high_mask != (1U << conductor))
+            {
+                missed_joints++;
+            }
+
+            // The same conductor broken
+            unit.open_mask = 1 << conductor;
+            WireRes_Measure(&result);
+            if (result.unmeasured_mask != (1U << conductor))
+            {
+                missed_opens++;
+            }
+        }
+    }
+
+    printf("%u units, zeroed with %.1f m, %.3f Ohm/m, ADC noise %.1f LSB, VDD drift +-%.1f%%\n",
+           MODEL_UNITS, MODEL_ZERO_M, MODEL_OHMS_PER_M, MODEL_NOISE_LSB, MODEL_VDD_DRIFT * 100.0);
+    printf("oversampled level worst error %.2f of 1/%u LSB (sigma %.2f)\n",
+           worst_level_error, 1U << WIRERES_EXTRA_BITS, level_sigma);
+    printf("length    worst error near read  far read\n");
+    for (int l = 0; l < length_count; l++)
+    {
+        printf("%6.1f m  %17.2f Ohm %6.2f Ohm\n", lengths_m[l], worst_near_ohms[l], worst_far_ohms[l]);
+    }
+    printf("joint of %.0f Ohm near read, %.0f Ohm far read missed %u, good cable flagged %u, open missed %u\n",
+           MODEL_JOINT_NEAR_OHMS, MODEL_JOINT_FAR_OHMS, missed_joints, false_joints, missed_opens);
+    printf("slowest measurement %.2f ms\n", worst_time_ns / 1e6);
+
+    if (worst_level_error > MODEL_LEVEL_SIGMAS * level_sigma + 0.5)
+    {
+        failures++;
+    }
+    if (worst_time_ns > MODEL_TIME_LIMIT_NS)
+    {
+        failures++;
+    }
+    failures += missed_joints + false_joints + missed_opens;
+    printf("%s\n", (failures == 0U) ? "PASS" : "FAIL");
+    return (failures == 0U) ? 0 : 1;
+}
+
+// Private function implementations
+
+static double Uniform(double low, double high)
+{
+    return low + (high - low) * ((double)rand() / (double)RAND_MAX);
+}
+
+static double Gauss(void)
+{
+    // Box-Muller, one value per call is enough here
+    double u1 = Uniform(1e-12, 1.0);
+    double u2 = Uniform(0.0, 1.0);
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+static double InputVolts(int input, int loaded)
+{
+    if (input == WIRERESHAL_VREF)
+    {
+        return unit.vref;
+    }
+
+    int open = unit.open_mask & (1 << input);
+
+    if (WIRERES_NEAR_MASK & (1U << input))
+    {
+        // Far pin drives through the conductor into the LED and its resistor
+        if (open)
+        {
+            return 0.0;
+        }
+        double current = (unit.vdd - unit.led_vf[input]) /
+                         (unit.driver_ohms[input] + unit.conductor_ohms[input] + unit.led_ohms[input]);
+        return unit.vdd - current * (unit.driver_ohms[input] + unit.conductor_ohms[input]);
+    }
+
+    // Near pin drives its own LED and, through the conductor, the far pull-down or pull-up
+    double load_volts = loaded ? 0.0 : unit.vdd;
+    if (open)
+    {
+        return load_volts;
+    }
+    double g_drive = 1.0 / unit.driver_ohms[input];
+    double g_led = 1.0 / unit.led_ohms[input];
+    double g_conductor = 1.0 / unit.conductor_ohms[input];
+    double g_load = 1.0 / (loaded ? unit.pulldown_ohms[input] : unit.pullup_ohms[input]);
+    double g_series = g_conductor * g_load / (g_conductor + g_load);
+    double drive = (unit.vdd * g_drive + unit.led_vf[input] * g_led + load_volts * g_series) /
+                   (g_drive + g_led + g_series);
+    return (drive * g_conductor + load_volts * g_load) / (g_conductor + g_load);
+}
+
+static void NewUnit(void)
+{
+    // Reference 1.2 V +-3%, output high at 4 mA 25-50 Ohm, pull resistors 35 kOhm typical
+    double pull_ohms = Uniform(25000.0, 50000.0);
+
+    unit.vdd = Uniform(3.2, 3.4);
+    unit.vref = Uniform(1.164, 1.236);
+    unit.open_mask = 0;
+
+    for (int i = 0; i < 8; i++)
+    {
+        unit.driver_ohms[i] = Uniform(25.0, 50.0);
+        unit.led_vf[i] = Uniform(1.8, 2.0);
+        unit.led_ohms[i] = 330.0 * Uniform(0.99, 1.01);
+        unit.pulldown_ohms[i] = pull_ohms * Uniform(0.95, 1.05);
+        unit.pullup_ohms[i] = pull_ohms * Uniform(0.95, 1.05);
+    }
+}
+
+static void PlugCable(double length_m)
+{
+    unit.open_mask = 0;
+
+    for (int i = 0; i < 8; i++)
+    {
+        unit.conductor_ohms[i] = length_m * MODEL_OHMS_PER_M * Uniform(1.0 - MODEL_OHMS_SPREAD, 1.0 + MODEL_OHMS_SPREAD);
+    }
+}